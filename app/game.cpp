@@ -9,20 +9,59 @@
  *
  * Key Features:
  * - **Node System**: The world is divided into interconnected nodes (locations). Each node has descriptions, assets, and monsters.
- * - **Player Actions**: The player can move between nodes, attack monsters, collect assets, and view inventory.
+ * - **Player Actions**: The player can move between nodes by id or by name, travel to any reachable node by its shortest route, attack monsters, collect assets, and view inventory.
  * - **Combat System**: The player battles monsters using various weapons and abilities. The outcome depends on the player and monster's attack values.
  * - **Asset Collection**: The player can collect and use assets found at nodes. Assets include offensive and healing items like weapons, potions, and fruits.
  * - **Monster Defeat**: The game tracks the status of monsters in each node. When all monsters are defeated, the player wins.
  *
  * **Classes Involved**:
+ * - `chants::AdventureGameMap`: Holds the locations, paths, assets and monsters loaded from the world file.
  * - `chants::Node`: Represents locations in the game world, each with a description, assets, and monsters.
  * - `chants::Player`: Represents the player, with attributes such as health and inventory, and the ability to fight and interact with assets.
  * - `chants::Asset`: Represents items in the game, such as weapons and healing items.
  * - `chants::Monster`: Represents the monsters the player will encounter and fight throughout the game.
  *
+ * **World**:
+ * - The world is loaded from a compiled world file (`data/world.txt` by default, see `WorldCompiler.hpp`); a different
+ *   world file can be passed on the command line. With `--stream` the world is paged in region by region around
+ *   the player instead of being built up front, for worlds too large to keep in memory.
+ * - `--respawn <turns>` brings every defeated monster back where it was placed that many turns later; a loaded game
+ *   keeps the delay it was saved with unless one is given.
+ * - `--monster-ai` moves the monsters every turn: some roam, some hunt the player and some guard where they were
+ *   placed (see `MonsterAI.hpp`). Large worlds work the moves out on `--ai-threads <n>` threads (default one per
+ *   hardware thread), with the same result on any number. A loaded game keeps moving its monsters if they moved when
+ *   it was saved. Not available with `--stream`.
+ *
  * **Game Loop**:
  * - The player starts in the "Fuschia Village" and can travel to different locations connected by paths.
  * - The game continues until all monsters are defeated, or the player chooses to exit.
+ * - The loop itself lives in `chants::GameEngine`; this file only picks where its commands come from and where its
+ *   text goes.
+ *
+ * **Output**:
+ * - Each turn's text is rendered into one buffer and written with a single system call (see `FrameRenderer.hpp`).
+ * - Text is colored only when standard output is a terminal; `--no-color` turns it off there too.
+ *
+ * **Scripted Runs**:
+ * - `--script <file>` plays the commands in the file (one per line, as typed at the prompt) instead of reading the
+ *   terminal, and can be given several times. `--repeat <n>` plays every script `n` times, each on a fresh map.
+ * - The text goes to standard output, to a file with `--capture <file>`, or nowhere with `--quiet`.
+ * - `--seed <n>` fixes the placement of random objects and every fight (default 0 for scripts, the time otherwise),
+ *   so a script always plays out the same way. A summary of the games and their speed is written to standard error.
+ *
+ * **Saved Games**:
+ * - `--save <file>` writes the game to a snapshot file when it ends (see `GameSnapshot.hpp`), and `--load <file>`
+ *   carries on from one, with its own seeds; a game left with `x` can be loaded and played on.
+ * - `--journal <file>` records every change to the game as it happens (see `EventJournal.hpp`); if the journal is
+ *   already there, the game recovers from it first, so a game that crashed or was killed carries on where it was.
+ *
+ * **Metrics** (builds configured with `-DCHANTS_METRICS=ON`, see `Metrics.hpp`):
+ * - `--metrics-file <file>` writes the latency histograms and counters in the Prometheus text format when the game
+ *   ends; `--metrics-port <n>` (0 for any free port) or `--metrics-unix <path>` serves them while it runs.
+ *
+ * **Tracing**:
+ * - `--trace <file>` records the map builds, turns, battles, item collection and flushes of the run as a timeline in
+ *   the Chrome trace-event format, to open in Perfetto (see `Tracer.hpp`).
  *
  * @author Evan Aarons-Wood
  * @version 1.0
@@ -30,446 +69,329 @@
  */
 
 #include "Player.hpp"
-#include "Node.hpp"
-#include "Asset.hpp"
-#include "Monster.hpp"
+#include "AdventureGameMap.hpp"
+#include "GameEngine.hpp"
+#include "FrameRenderer.hpp"
+#include "GameIO.hpp"
+#include "GameSnapshot.hpp"
+#include "EventJournal.hpp"
+#include "Metrics.hpp"
+#include "MetricsExporter.hpp"
+#include "RoutePlanner.hpp"
+#include "ThreadPool.hpp"
+#include "Tracer.hpp"
+#include "WorldFile.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
 #include <iostream>
-#include <vector>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
-#include <cstdlib>
-#include <ctime>
-#include <algorithm> // Include algorithm for std::all_of
+#include <unistd.h>
+#include <vector>
 
 using namespace std;
 
-// ANSI color codes for text formatting
-#define COLOR_RED 31
-#define COLOR_GREEN 32
-#define COLOR_YELLOW 33
-#define COLOR_BLUE 34
-#define COLOR_MAGENTA 35
-#define COLOR_CYAN 36
-
-// Function to set text color
-string ChangeColor(int color_code) {
-    return "\033[1;" + to_string(color_code) + "m";
-}
-
-// Function to reset text color
-string ResetColor() {
-    return "\033[0m";
-}
-
-int FindNode(string loc, vector<chants::Node> *gameMap);
-int Battle(chants::Player player, chants::Monster monster, const chants::Asset* weapon = nullptr); // Updated to use const
-std::string getCommandName(const std::string &str);
-std::string getCommandArgument(const std::string &str);
-bool isNumber(const std::string& s);
-
-void DisplayNodeInfo(const chants::Node& node) {
-    cout << ChangeColor(COLOR_MAGENTA) << "Location: " << node.GetName() << ResetColor() << endl;
-    cout << node.GetDescription() << endl;
+// world file compiled at build time, used when no world is given on the command line
+#ifndef CHANTS_DEFAULT_WORLD
+#define CHANTS_DEFAULT_WORLD "world.chw"
+#endif
 
-    cout << "There are paths here ..." << endl;
-    for (const auto& connection : node.GetConnections()) {
-        cout << connection->GetId() << " " << connection->GetName() << endl;
-    }
-
-    for (const auto& asset : node.GetAssets()) {
-        cout << "Asset at this node: " << asset->GetName() << " " << asset->GetMessage() << " " << asset->GetValue() << endl;
+struct GameOptions
+{
+    string worldPath = CHANTS_DEFAULT_WORLD;
+    bool streaming = false;
+    vector<string> scripts;
+    bool quiet = false;
+    bool color = true;
+    string capturePath;
+    uint64_t seed = 0;
+    bool seeded = false;
+    uint64_t repeat = 1;
+    string savePath;
+    string loadPath;
+    string journalPath;
+    uint32_t respawnDelay = 0;
+    bool respawning = false;
+    bool monsterAI = false;
+    unsigned aiThreads = 0;
+    string metricsPath;
+    chants::MetricsExporterOptions metricsExporter;
+    bool exportingMetrics = false;
+    string tracePath;
+};
+
+GameOptions ParseOptions(int argc, char *argv[]);
+unique_ptr<chants::AdventureGameMap> MakeMap(chants::WorldFile &worldFile, unsigned seed, bool streaming);
+unique_ptr<chants::AdventureGameMap> MakeMap(chants::WorldFile &worldFile, const chants::GameSnapshot &snapshot, bool streaming);
+int RunScripts(chants::WorldFile &worldFile, const chants::RoutePlanner &planner, const GameOptions &options);
+unique_ptr<chants::MetricsExporter> ExportMetrics(const GameOptions &options);
+
+int main(int argc, char *argv[])
+{
+    GameOptions options;
+    unique_ptr<chants::WorldFile> worldFile;
+    try
+    {
+        options = ParseOptions(argc, argv);
+        // load the world compiled from data/world.txt, or the one given on the command line
+        worldFile = make_unique<chants::WorldFile>(options.worldPath);
     }
-
-    for (const auto& monster : node.GetMonsters()) {
-        cout << "Monster at this node: " << monster->GetName() << endl;
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        return 1;
     }
-}
-
-bool AllMonstersDefeated(const vector<chants::Node>& gameMap) {
-    return std::all_of(gameMap.begin(), gameMap.end(), [](const chants::Node& node) {
-        return node.GetMonsters().empty();
-    });
-}
-
-int main()
-{
-    vector<chants::Node> gameMap;
-
-    // build all nodes
-    chants::Node fuschiaVillage(0, "Fuschia Village");
-    fuschiaVillage.SetDescription("A peaceful village where Luffy grew up, known for its windmill and friendly people.\n");
-
-    chants::Node shellTown(1, "Shell Town");
-    shellTown.SetDescription("A marine base town where Captain Morgan rules with an iron fist.\n");
-
-    chants::Node orangeTown(2, "Orange Town");
-    orangeTown.SetDescription("A town terrorized by the pirate Buggy the Clown.\n");
-
-    chants::Node syrupVillage(3, "Syrup Village");
-    syrupVillage.SetDescription("A quiet village with a long nose boy dreaming of adventure.\n");
-
-    chants::Node baratie(4, "Baratie");
-    baratie.SetDescription("A floating restaurant on the sea, known for its delicious food and fierce chefs.\n");
-
-    chants::Node arlongPark(5, "Arlong Park");
-    arlongPark.SetDescription("A stronghold of the fish-man Arlong, who oppresses the nearby village.\n");
-
-    chants::Node loguetown(6, "Loguetown");
-    loguetown.SetDescription("The town of beginnings and endings, where the Pirate King was born and executed.\n");
-
-    // connect nodes paths
-    fuschiaVillage.AddConnection(&shellTown);
-    fuschiaVillage.AddConnection(&orangeTown);
-
-    shellTown.AddConnection(&fuschiaVillage);
-    shellTown.AddConnection(&syrupVillage);
-
-    orangeTown.AddConnection(&fuschiaVillage);
-    orangeTown.AddConnection(&baratie);
-
-    syrupVillage.AddConnection(&shellTown);
-    syrupVillage.AddConnection(&baratie);
-
-    baratie.AddConnection(&orangeTown);
-    baratie.AddConnection(&syrupVillage);
-    baratie.AddConnection(&arlongPark);
-
-    arlongPark.AddConnection(&baratie);
-    arlongPark.AddConnection(&loguetown);
-
-    loguetown.AddConnection(&arlongPark);
-
-    // build map in same order as Node Ids above.
-    // The index of each node in the vector must match its id.
-    gameMap.push_back(fuschiaVillage);
-    gameMap.push_back(shellTown);
-    gameMap.push_back(orangeTown);
-    gameMap.push_back(syrupVillage);
-    gameMap.push_back(baratie);
-    gameMap.push_back(arlongPark);
-    gameMap.push_back(loguetown);
-
-    // build assets
-    chants::Asset legendarySword("Yoru", "A legendary black blade wielded by the greatest swordsman.", 500, true);
-    chants::Asset devilFruit("Gomu Gomu no Mi", "A mysterious fruit that grants rubber-like abilities.", 300, true);
-    chants::Asset map("Grand Line Map", "A map showing the way to the Grand Line.", 100, false);
-    chants::Asset logPose("Log Pose", "A navigational tool essential for Grand Line travel.", 150, false);
-    chants::Asset meat("Meat", "A delicious piece of meat to restore energy.", 50, false);
-    chants::Asset healingPotion("Healing Potion", "A potion that restores health.", 200, false);
-    chants::Asset slingshot("Slingshot", "A simple weapon for ranged attacks.", 100, true);
-    chants::Asset pistol("Pistol", "A firearm for ranged combat.", 250, true);
-    chants::Asset giantHammer("Giant Hammer", "A massive hammer for powerful attacks.", 300, true);
-    chants::Asset devilFruit2("Mera Mera no Mi", "A fruit that grants fire-based abilities.", 350, true);
-
-    // randomly add assets to nodes
-    int numOfNodes = gameMap.size();
-
-    srand(time(nullptr)); // seed the random number generator
-    int randNode = rand() % numOfNodes;
-    gameMap[randNode].AddAsset(&legendarySword);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddAsset(&devilFruit);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddAsset(&map);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddAsset(&logPose);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddAsset(&meat);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddAsset(&healingPotion);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddAsset(&slingshot);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddAsset(&pistol);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddAsset(&giantHammer);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddAsset(&devilFruit2);
-
-    // build monsters
-    chants::Monster buggy("Buggy the Clown", 3000, 100);
-    chants::Monster arlong("Arlong", 4000, 150);
-    chants::Monster kuro("Captain Kuro", 3500, 120);
-    chants::Monster donKrieg("Don Krieg", 4500, 130);
-    chants::Monster alvida("Alvida", 2500, 90);
-    chants::Monster smoker("Smoker", 5000, 160);
-    chants::Monster marine("Marine", 2000, 80);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddMonster(&buggy);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddMonster(&arlong);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddMonster(&kuro);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddMonster(&donKrieg);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddMonster(&alvida);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddMonster(&smoker);
-
-    randNode = rand() % numOfNodes;
-    gameMap[randNode].AddMonster(&marine);
 
-    // get ready to play game below
-    int nodePointer = 0; // start at Fuschia Village
-    string input;
-    chants::Player player("Luffy", 10000, 200); // Example player
-
-    // +++++++++ game loop ++++++++++
-    while (true)
+    try
     {
-        // show current node info
-        DisplayNodeInfo(gameMap[nodePointer]);
-
-        cout << "\nGo to node? e(x)it, (v)iew inventory, (a)ttack monster, (t)ake item: ";
-        getline(cin, input);
-
-        // exit app?
-        if (input == "x")
-            break;
-
-        if (input == "v")
+        // routes for the travel command, shared by every game on the world
+        chants::RoutePlanner planner(worldFile->Graph(), worldFile->Regions());
+        unique_ptr<chants::MetricsExporter> exporter = ExportMetrics(options);
+        if (!options.tracePath.empty())
+            chants::Tracer::Start(options.tracePath);
+        if (!options.scripts.empty())
         {
-            player.ViewInventory();
-            continue;
+            int status = RunScripts(*worldFile, planner, options);
+            chants::Tracer::Stop();
+            if (!options.metricsPath.empty())
+                chants::Metrics::WriteFile(options.metricsPath);
+            return status;
         }
 
-        int nodeAddr = -1;
-        if (isNumber(input))
+        unique_ptr<chants::AdventureGameMap> gameMap;
+        const chants::PlayerProfile profile{"Luffy", 10000, 200}; // Example player
+        chants::Player player(profile);
+        chants::GameSnapshot snapshot;
+        bool resuming = !options.loadPath.empty();
+        if (!options.journalPath.empty() && chants::EventJournal::Exists(options.journalPath))
         {
-            nodeAddr = stoi(input);
+            snapshot = chants::EventJournal::Recover(options.journalPath, *worldFile, profile);
+            resuming = true;
         }
-
-        bool validConnection = false;
-        for (chants::Node *node : gameMap[nodePointer].GetConnections())
+        else if (resuming)
+            snapshot = chants::GameSnapshot::ReadFile(options.loadPath);
+        if (resuming)
         {
-            if (node->GetId() == nodeAddr)
-            {
-                validConnection = true;
-            }
+            gameMap = MakeMap(*worldFile, snapshot, options.streaming);
+            player.Restore(snapshot, *worldFile);
         }
-
-        int dir = -1;
-        if (validConnection)
+        else
         {
-            dir = FindNode(input, &gameMap);
-            nodePointer = dir;
+            // assets and monsters listed with "random" in the world file land on a different node every game
+            uint64_t seed = options.seeded ? options.seed : static_cast<uint64_t>(time(nullptr));
+            gameMap = MakeMap(*worldFile, static_cast<unsigned>(seed), options.streaming);
+            if (options.seeded)
+                player.Seed(chants::MixSeed(seed, 0));
         }
-
-        // if player wants to take an asset (t hammer)
-        if (input.length() > 1 && input[0] == 't')
+        if (options.respawning)
+            gameMap->SetRespawnDelay(options.respawnDelay);
+        unique_ptr<chants::ThreadPool> aiPool;
+        if (gameMap->GetMonsterAI() || options.monsterAI)
         {
-            string assetName = getCommandArgument(input);
-            const chants::Asset* targetAsset = nullptr; // Use const pointer
-            for (const auto& asset : gameMap[nodePointer].GetAssets()) // Use const auto&
-            {
-                if (asset->GetName() == assetName)
-                {
-                    targetAsset = asset;
-                    break;
-                }
-            }
-
-            if (targetAsset)
-            {
-                player.AddAsset(*targetAsset);
-                gameMap[nodePointer].RemoveAsset(targetAsset->GetName());
-                cout << ChangeColor(COLOR_GREEN) << "Collected: " << targetAsset->GetName() << ResetColor() << endl;
-            }
-            else
-            {
-                cout << "Asset not found!" << endl;
-            }
+            aiPool = make_unique<chants::ThreadPool>(options.aiThreads);
+            gameMap->SetMonsterAI(true, aiPool.get());
         }
 
-        // if player wants to attack a monster (a kraken)
-        if (input.length() > 1 && input[0] == 'a')
+        chants::StreamInput input(cin);
+        chants::FrameRenderer output(STDOUT_FILENO, options.color && chants::FrameRenderer::IsTerminal(STDOUT_FILENO));
+        uint32_t start = resuming ? snapshot.position : 0; // a new game starts at Fuschia Village
+        chants::GameEngine engine(*gameMap, player, output, start, &planner);
+        if (resuming)
+            engine.Restore(snapshot);
+        unique_ptr<chants::EventJournal> journal;
+        if (!options.journalPath.empty())
         {
-            string monsterName = getCommandArgument(input);
-            chants::Monster* targetMonster = nullptr;
-            for (auto& monster : gameMap[nodePointer].GetMonsters())
-            {
-                if (monster->GetName() == monsterName)
-                {
-                    targetMonster = monster;
-                    break;
-                }
-            }
-
-            if (targetMonster)
-            {
-                cout << "Available weapons: ";
-                for (auto& asset : player.GetAssets())
-                {
-                    if (asset.isOffensive())
-                    {
-                        cout << asset.GetName() << " ";
-                    }
-                }
-                cout << endl;
-
-                cout << "Specify weapon or ability to use (or press enter to skip): ";
-                string weaponName;
-                getline(cin, weaponName);
-
-                const chants::Asset* weapon = nullptr; // Use const pointer
-                if (!weaponName.empty())
-                {
-                    for (auto& asset : player.GetAssets())
-                    {
-                        if (asset.GetName() == weaponName && asset.isOffensive())
-                        {
-                            weapon = &asset;
-                            break;
-                        }
-                    }
-                }
-
-                int battleResult = Battle(player, *targetMonster, weapon);
-                if (battleResult == 1) // Player wins
-                {
-                    gameMap[nodePointer].RemoveMonster(targetMonster->GetName());
-                }
-            }
-            else
-            {
-                cout << "Monster not found!" << endl;
-            }
+            chants::GameSnapshot begun;
+            engine.Save(begun);
+            journal = make_unique<chants::EventJournal>(options.journalPath, *worldFile, profile, begun);
+            engine.SetJournal(journal.get());
         }
+        engine.Run(input);
 
-        // if player wants to drop an asset (d hammer)
-        if (input.length() > 1 && input[0] == 'd')
+        if (!options.savePath.empty())
         {
-            string lastWord = getCommandArgument(input);
-            // Implement logic to drop asset
+            engine.Save(snapshot);
+            snapshot.WriteFile(options.savePath);
         }
+        chants::Tracer::Stop();
+        if (!options.metricsPath.empty())
+            chants::Metrics::WriteFile(options.metricsPath);
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl; // the output went away
+        return 1;
+    }
+    return 0;
+}
 
-        // if player wants to inspect an asset (i hammer)
-        if (input.length() > 1 && input[0] == 'i')
+GameOptions ParseOptions(int argc, char *argv[])
+{
+    GameOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        bool takesValue = arg == "--script" || arg == "--capture" || arg == "--seed" || arg == "--repeat" || arg == "--save" ||
+                          arg == "--load" || arg == "--journal" || arg == "--respawn" || arg == "--metrics-file" ||
+                          arg == "--metrics-port" || arg == "--metrics-unix" || arg == "--trace" ||
+                          arg == "--ai-threads";
+        if (takesValue && i + 1 >= argc)
+            throw invalid_argument("missing value for " + arg);
+
+        if (arg == "--stream")
+            options.streaming = true;
+        else if (arg == "--quiet")
+            options.quiet = true;
+        else if (arg == "--no-color")
+            options.color = false;
+        else if (arg == "--script")
+            options.scripts.push_back(argv[++i]);
+        else if (arg == "--capture")
+            options.capturePath = argv[++i];
+        else if (arg == "--seed")
         {
-            string lastWord = getCommandArgument(input);
-            // Implement logic to inspect asset
+            options.seed = stoull(argv[++i]);
+            options.seeded = true;
         }
-
-        if (!validConnection && input[0] != 't' && input[0] != 'a')
+        else if (arg == "--repeat")
+            options.repeat = stoull(argv[++i]);
+        else if (arg == "--save")
+            options.savePath = argv[++i];
+        else if (arg == "--load")
+            options.loadPath = argv[++i];
+        else if (arg == "--journal")
+            options.journalPath = argv[++i];
+        else if (arg == "--respawn")
         {
-            cout << "Not a valid node address\n";
+            options.respawnDelay = static_cast<uint32_t>(stoul(argv[++i]));
+            options.respawning = true;
         }
-
-        // Check if all monsters are defeated
-        if (AllMonstersDefeated(gameMap)) {
-            cout << ChangeColor(COLOR_BLUE) << "Congratulations! You have defeated all the monsters and won the game!" << ResetColor() << endl;
-            break;
+        else if (arg == "--monster-ai")
+            options.monsterAI = true;
+        else if (arg == "--ai-threads")
+            options.aiThreads = static_cast<unsigned>(stoul(argv[++i]));
+        else if (arg == "--metrics-file")
+            options.metricsPath = argv[++i];
+        else if (arg == "--trace")
+            options.tracePath = argv[++i];
+        else if (arg == "--metrics-port")
+        {
+            options.metricsExporter.port = static_cast<uint16_t>(stoul(argv[++i]));
+            options.exportingMetrics = true;
         }
-
-        cout << endl;
+        else if (arg == "--metrics-unix")
+        {
+            options.metricsExporter.unixPath = argv[++i];
+            options.exportingMetrics = true;
+        }
+        else
+            options.worldPath = arg;
     }
-    return 0;
+    if (options.monsterAI && options.streaming)
+        throw invalid_argument("--monster-ai cannot be used with --stream");
+    if ((options.exportingMetrics || !options.metricsPath.empty()) && !chants::Metrics::Enabled())
+        throw invalid_argument("this build records no metrics; configure it with -DCHANTS_METRICS=ON");
+    return options;
 }
 
-int FindNode(string loc, vector<chants::Node> *gameMap)
+// serves the metrics on a local socket for as long as the game runs, if asked to
+unique_ptr<chants::MetricsExporter> ExportMetrics(const GameOptions &options)
 {
-    int intLoc = -1;
-    if (isNumber(loc))
-    {
-        intLoc = stoi(loc);
-    }
-    for (chants::Node node : *gameMap)
-    {
-        if (node.GetName() == loc || node.GetId() == intLoc)
-            return node.GetId();
-    }
-    return -1;
+    if (!options.exportingMetrics)
+        return nullptr;
+    auto exporter = make_unique<chants::MetricsExporter>(options.metricsExporter);
+    if (options.metricsExporter.unixPath.empty())
+        cerr << "metrics on " << options.metricsExporter.host << ":" << exporter->Port() << endl;
+    else
+        cerr << "metrics on " << options.metricsExporter.unixPath << endl;
+    return exporter;
 }
 
-int Battle(chants::Player player, chants::Monster monster, const chants::Asset* weapon) // Updated to use const
+unique_ptr<chants::AdventureGameMap> MakeMap(chants::WorldFile &worldFile, unsigned seed, bool streaming)
 {
-    srand(time(nullptr));
-
-    int playerAttackValue = player.Fight();
-    if (weapon && weapon->isOffensive())
-    {
-        playerAttackValue += weapon->GetValue();
-        cout << ChangeColor(COLOR_RED) << "Using " << weapon->GetName() << " to attack!" << ResetColor() << endl;
-    }
-
-    int monsterAttackValue = monster.Fight();
-
-    cout << "Player attacks " << monster.GetName() << " with value: " << playerAttackValue << endl;
-    cout << monster.GetName() << " attacks back with value: " << monsterAttackValue << endl;
-
-    if (playerAttackValue > monsterAttackValue)
-    {
-        cout << "Player wins the fight!" << endl;
-        return 1; // Player wins
-    }
-    else if (playerAttackValue < monsterAttackValue)
-    {
-        cout << "Player loses the fight!" << endl;
-        return -1; // Player loses
-    }
-    else
-    {
-        cout << "It's a draw!" << endl;
-        return 0; // Draw
-    }
+    return streaming
+        ? make_unique<chants::AdventureGameMap>(worldFile, seed, chants::StreamingOptions())
+        : make_unique<chants::AdventureGameMap>(worldFile, seed);
 }
 
-std::string getCommandName(const std::string &str)
+unique_ptr<chants::AdventureGameMap> MakeMap(chants::WorldFile &worldFile, const chants::GameSnapshot &snapshot, bool streaming)
 {
-    // Trim leading spaces
-    std::string trimmed = str;
-    trimmed.erase(0, trimmed.find_first_not_of(' '));
-
-    // Find the position of the first space
-    size_t pos = trimmed.find_first_of(' ');
-
-    // Extract the command name
-    if (pos == std::string::npos)
-    {
-        return trimmed; // No spaces found, return the whole string
-    }
-    else
-    {
-        return trimmed.substr(0, pos);
-    }
+    return streaming
+        ? make_unique<chants::AdventureGameMap>(worldFile, snapshot, chants::StreamingOptions())
+        : make_unique<chants::AdventureGameMap>(worldFile, snapshot);
 }
 
-std::string getCommandArgument(const std::string &str)
+// plays every script `repeat` times, each game on a fresh map with its own seeds
+int RunScripts(chants::WorldFile &worldFile, const chants::RoutePlanner &planner, const GameOptions &options)
 {
-    // Trim leading spaces
-    std::string trimmed = str;
-    trimmed.erase(0, trimmed.find_first_not_of(' '));
-
-    // Find the position of the first space
-    size_t pos = trimmed.find_first_of(' ');
+    vector<string> scripts;
+    for (const string &path : options.scripts)
+    {
+        ifstream file(path);
+        if (!file)
+        {
+            cerr << "cannot open script " << path << endl;
+            return 1;
+        }
+        ostringstream text;
+        text << file.rdbuf();
+        scripts.push_back(text.str());
+    }
 
-    // Extract the command argument
-    if (pos == std::string::npos)
+    int fd = STDOUT_FILENO;
+    if (!options.capturePath.empty())
     {
-        return ""; // No argument found
+        fd = ::open(options.capturePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            cerr << "cannot write " << options.capturePath << ": " << strerror(errno) << endl;
+            return 1;
+        }
     }
+    unique_ptr<chants::OutputSink> output;
+    if (options.quiet)
+        output = make_unique<chants::NullOutput>();
     else
+        output = make_unique<chants::FrameRenderer>(fd, options.color && chants::FrameRenderer::IsTerminal(fd));
+
+    uint64_t games = 0;
+    uint64_t wins = 0;
+    uint64_t lines = 0;
+    unique_ptr<chants::ThreadPool> aiPool;
+    if (options.monsterAI)
+        aiPool = make_unique<chants::ThreadPool>(options.aiThreads);
+    auto started = chrono::steady_clock::now();
+    for (uint64_t round = 0; round < options.repeat; round++)
     {
-        return trimmed.substr(pos + 1);
+        for (const string &script : scripts)
+        {
+            uint64_t gameSeed = chants::MixSeed(options.seed, games);
+            unique_ptr<chants::AdventureGameMap> gameMap = MakeMap(worldFile, static_cast<unsigned>(gameSeed), options.streaming);
+            gameMap->SetRespawnDelay(options.respawnDelay);
+            gameMap->SetMonsterAI(options.monsterAI, aiPool.get());
+            chants::Player player("Luffy", 10000, 200);
+            player.Seed(chants::MixSeed(gameSeed, 0));
+
+            istringstream commands(script);
+            chants::StreamInput input(commands);
+            chants::GameEngine engine(*gameMap, player, *output, 0, &planner);
+            lines += engine.Run(input);
+            wins += engine.HasWon();
+            games++;
+        }
     }
-}
+    output.reset();
+    if (fd != STDOUT_FILENO)
+        ::close(fd);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
 
-bool isNumber(const std::string& s)
-{
-    return !s.empty() && std::all_of(s.begin(), s.end(), ::isdigit);
+    cerr << games << " games, " << wins << " won, " << lines << " commands in " << seconds << " s ("
+         << (seconds > 0 ? lines / seconds : 0.0) << " commands/s)" << endl;
+    return 0;
 }
@@ -0,0 +1,189 @@
+/**
+ * @file server.cpp
+ * @brief Command line game server, hosting one adventure per connection in a single process.
+ *
+ * Usage: `ChantsServer [options]`
+ *
+ * - `--world <world.chw>`: World file every session plays (default: the compiled default world).
+ * - `--unix <path>`: Listen on a Unix domain socket instead of TCP.
+ * - `--host <address>`: Local IPv4 address to listen on (default 127.0.0.1).
+ * - `--port <n>`: TCP port to listen on (default 7777, 0 for any free port).
+ * - `--threads <n>`: Threads to run commands on (default: one per hardware thread).
+ * - `--max-sessions <n>`: Sessions open at once (default 4096).
+ * - `--session-memory <MiB>`: Memory one session's world and player may hold before it is closed (default 64).
+ * - `--memory <MiB>`: Memory all sessions may hold before new connections are refused (default: no limit).
+ * - `--stream`: Keep only the regions around each player in memory.
+ * - `--monster-ai`: Move every session's monsters each turn (see `MonsterAI.hpp`); a session ticks on its own thread. Not with `--stream`.
+ * - `--color`: Send ANSI colors.
+ * - `--seed <n>`: Seed for the sessions (default 0); session n plays like game n of `ChantsAdventure --script --seed`.
+ * - `--park-after <seconds>`: Save and free the game of a session idle this long, until its next command (default: never).
+ * - `--respawn <turns>`: Bring every defeated monster back where it was placed this many turns later (default: never).
+ * - `--metrics-port <n>`, `--metrics-unix <path>`: Serve the latency histograms and counters in the Prometheus text format on a local port (0 for any free one) or Unix socket; builds configured with `-DCHANTS_METRICS=ON` only.
+ * - `--metrics-file <file>`: Write them to a file when the server stops; likewise.
+ * - `--trace <file>`: Record every session's map builds, turns, battles and flushes, on every thread, as a Chrome trace-event timeline.
+ *
+ * Connect with `nc 127.0.0.1 7777` (or `socat - UNIX-CONNECT:<path>`) and type commands as in the game. The server
+ * runs until it receives SIGINT or SIGTERM, then prints what it served.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include "GameServer.hpp"
+#include "Metrics.hpp"
+#include "MetricsExporter.hpp"
+#include "RoutePlanner.hpp"
+#include "Tracer.hpp"
+#include "WorldFile.hpp"
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+#ifndef CHANTS_DEFAULT_WORLD
+#define CHANTS_DEFAULT_WORLD "world.chw"
+#endif
+
+namespace
+{
+    chants::GameServer *runningServer = nullptr;
+
+    void stopServer(int)
+    {
+        if (runningServer)
+            runningServer->Stop();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    string worldPath = CHANTS_DEFAULT_WORLD;
+    chants::GameServerOptions options;
+    options.port = 7777;
+    string metricsPath;
+    chants::MetricsExporterOptions metricsOptions;
+    bool exportingMetrics = false;
+    string tracePath;
+    unique_ptr<chants::WorldFile> worldFile;
+
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            string arg = argv[i];
+            if (arg == "--stream")
+            {
+                options.streaming = true;
+                continue;
+            }
+            if (arg == "--color")
+            {
+                options.color = true;
+                continue;
+            }
+            if (arg == "--monster-ai")
+            {
+                options.monsterAI = true;
+                continue;
+            }
+            if (i + 1 >= argc)
+                throw invalid_argument("missing value for " + arg);
+            string value = argv[++i];
+            if (arg == "--world")
+                worldPath = value;
+            else if (arg == "--unix")
+                options.unixPath = value;
+            else if (arg == "--host")
+                options.host = value;
+            else if (arg == "--port")
+                options.port = static_cast<uint16_t>(stoul(value));
+            else if (arg == "--threads")
+                options.threads = static_cast<unsigned>(stoul(value));
+            else if (arg == "--max-sessions")
+                options.maxSessions = static_cast<uint32_t>(stoul(value));
+            else if (arg == "--session-memory")
+                options.sessionMemoryLimit = static_cast<size_t>(stoull(value)) << 20;
+            else if (arg == "--memory")
+                options.memoryLimit = static_cast<size_t>(stoull(value)) << 20;
+            else if (arg == "--seed")
+                options.seed = stoull(value);
+            else if (arg == "--respawn")
+                options.respawnDelay = static_cast<uint32_t>(stoul(value));
+            else if (arg == "--park-after")
+                options.parkAfter = static_cast<uint32_t>(stod(value) * 1000);
+            else if (arg == "--metrics-file")
+                metricsPath = value;
+            else if (arg == "--trace")
+                tracePath = value;
+            else if (arg == "--metrics-port")
+            {
+                metricsOptions.port = static_cast<uint16_t>(stoul(value));
+                exportingMetrics = true;
+            }
+            else if (arg == "--metrics-unix")
+            {
+                metricsOptions.unixPath = value;
+                exportingMetrics = true;
+            }
+            else
+                throw invalid_argument("unknown option " + arg);
+        }
+        if (options.monsterAI && options.streaming)
+            throw invalid_argument("--monster-ai cannot be used with --stream");
+        if ((exportingMetrics || !metricsPath.empty()) && !chants::Metrics::Enabled())
+            throw invalid_argument("this build records no metrics; configure it with -DCHANTS_METRICS=ON");
+        worldFile = make_unique<chants::WorldFile>(worldPath);
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    try
+    {
+        chants::RoutePlanner planner(worldFile->Graph(), worldFile->Regions());
+        chants::GameServer server(*worldFile, planner, options);
+        unique_ptr<chants::MetricsExporter> exporter;
+        if (exportingMetrics)
+        {
+            exporter = make_unique<chants::MetricsExporter>(metricsOptions);
+            if (metricsOptions.unixPath.empty())
+                cerr << "metrics on " << metricsOptions.host << ":" << exporter->Port() << endl;
+            else
+                cerr << "metrics on " << metricsOptions.unixPath << endl;
+        }
+        if (!tracePath.empty())
+            chants::Tracer::Start(tracePath);
+        runningServer = &server;
+        signal(SIGINT, stopServer);
+        signal(SIGTERM, stopServer);
+        signal(SIGPIPE, SIG_IGN);
+
+        if (options.unixPath.empty())
+            cerr << "listening on " << options.host << ":" << server.Port() << endl;
+        else
+            cerr << "listening on " << options.unixPath << endl;
+        server.Run();
+        runningServer = nullptr;
+        chants::Tracer::Stop();
+
+        chants::GameServerStats stats = server.Stats();
+        cerr << stats.accepted << " sessions (" << stats.refused << " refused, " << stats.sessions << " still open), "
+             << stats.commands << " commands, " << stats.bytesIn << " bytes in, " << stats.bytesOut << " bytes out, "
+             << stats.throttled << " throttled, " << stats.parked << " parked, " << stats.resumed << " resumed" << endl;
+        if (!metricsPath.empty())
+            chants::Metrics::WriteFile(metricsPath);
+    }
+    catch (const exception &e)
+    {
+        runningServer = nullptr;
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file simulate.cpp
+ * @brief Command line battle simulator, fighting one player against one monster millions of times to balance a world.
+ *
+ * Usage: `ChantsBattleSimulator [options]`
+ *
+ * - `--world <world.chw>`: World file to read `--monster` and `--weapon` from (default: the compiled default world).
+ * - `--monster <name>`: Monster from the world file to fight.
+ * - `--weapon <name>`: Asset from the world file the player fights with; only offensive assets add to the attack.
+ * - `--player-coefficient <n>`: The player's fight coefficient (default 200, the game's player).
+ * - `--monster-coefficient <n>`: Fight a monster with this coefficient instead of one from the world file.
+ * - `--weapon-value <n>`: Add this to every player attack instead of using a weapon from the world file.
+ * - `--fights <n>`: Number of battles to fight (default 1000000).
+ * - `--threads <n>`: Worker threads (default: one per hardware thread).
+ * - `--seed <n>`: Seed for the run (default 0); the same seed always gives the same result.
+ *
+ * Prints the win, draw and loss rates and the mean, deviation and percentiles of both sides' attacks.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+#include "Asset.hpp"
+#include "BattleSimulator.hpp"
+#include "Monster.hpp"
+#include "Player.hpp"
+#include "SymbolTable.hpp"
+#include "WorldFile.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+#ifndef CHANTS_DEFAULT_WORLD
+#define CHANTS_DEFAULT_WORLD "world.chw"
+#endif
+
+// prints one side's attacks, shifting the fight value histogram by its bonus
+void PrintAttacks(const string &side, const chants::FightHistogram &fightValues, int bonus)
+{
+    cout << left << setw(9) << side << right << fixed << setprecision(2)
+         << " mean " << setw(9) << fightValues.Mean() + bonus
+         << "  sd " << setw(8) << fightValues.Deviation()
+         << "  p5 " << setw(7) << fightValues.Percentile(0.05) + bonus
+         << "  p50 " << setw(7) << fightValues.Percentile(0.50) + bonus
+         << "  p95 " << setw(7) << fightValues.Percentile(0.95) + bonus << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    string worldPath = CHANTS_DEFAULT_WORLD;
+    string monsterName;
+    string weaponName;
+    int playerCoefficient = 200;
+    int monsterCoefficient = -1;
+    int weaponValue = -1;
+    chants::SimulationOptions options;
+
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            string arg = argv[i];
+            if (i + 1 >= argc)
+                throw invalid_argument("missing value for " + arg);
+            string value = argv[++i];
+            if (arg == "--world")
+                worldPath = value;
+            else if (arg == "--monster")
+                monsterName = value;
+            else if (arg == "--weapon")
+                weaponName = value;
+            else if (arg == "--player-coefficient")
+                playerCoefficient = stoi(value);
+            else if (arg == "--monster-coefficient")
+                monsterCoefficient = stoi(value);
+            else if (arg == "--weapon-value")
+                weaponValue = stoi(value);
+            else if (arg == "--fights")
+                options.fights = stoull(value);
+            else if (arg == "--threads")
+                options.threads = static_cast<unsigned>(stoul(value));
+            else if (arg == "--seed")
+                options.seed = stoull(value);
+            else
+                throw invalid_argument("unknown option " + arg);
+        }
+        if (monsterName.empty() && monsterCoefficient < 0)
+            throw invalid_argument("give a --monster from the world file or a --monster-coefficient");
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        cerr << "usage: " << argv[0] << " [--world <world.chw>] (--monster <name> | --monster-coefficient <n>)"
+             << " [--weapon <name> | --weapon-value <n>] [--player-coefficient <n>] [--fights <n>] [--threads <n>] [--seed <n>]"
+             << endl;
+        return 2;
+    }
+
+    chants::Player player("Luffy", 10000, playerCoefficient);
+    unique_ptr<chants::Monster> monster;
+    unique_ptr<chants::Asset> weapon;
+    try
+    {
+        unique_ptr<chants::WorldFile> world;
+        if (!monsterName.empty() || !weaponName.empty())
+            world = make_unique<chants::WorldFile>(worldPath);
+
+        chants::SymbolTable &symbols = chants::SymbolTable::Global();
+        if (monsterCoefficient >= 0)
+        {
+            monster = make_unique<chants::Monster>("Monster", 1, monsterCoefficient);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < world->MonsterCount() && !monster; i++)
+            {
+                chants::WorldFile::MonsterDef def = world->GetMonster(i);
+                if (symbols.Intern(def.name) == symbols.Find(monsterName)) // interned as spelled in the world
+                    monster = make_unique<chants::Monster>(string(def.name), def.health, def.fightCoefficient);
+            }
+            if (!monster)
+                throw runtime_error("no monster named " + monsterName + " in " + worldPath);
+        }
+
+        if (weaponValue >= 0)
+        {
+            weapon = make_unique<chants::Asset>("Weapon", "", weaponValue, true);
+        }
+        else if (!weaponName.empty())
+        {
+            for (uint32_t i = 0; i < world->AssetCount() && !weapon; i++)
+            {
+                chants::WorldFile::AssetDef def = world->GetAsset(i);
+                if (symbols.Intern(def.name) == symbols.Find(weaponName))
+                    weapon = make_unique<chants::Asset>(string(def.name), string(def.message), def.value, def.category);
+            }
+            if (!weapon)
+                throw runtime_error("no asset named " + weaponName + " in " + worldPath);
+        }
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    chants::BattleSimulator simulator(player, *monster, weapon.get());
+    auto start = chrono::steady_clock::now();
+    chants::SimulationResult result = simulator.Run(options);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << player.GetName() << " (" << playerCoefficient << ")";
+    if (weapon)
+        cout << " with " << weapon->GetName() << " (+" << result.weaponBonus << ")";
+    cout << " vs " << monster->GetName() << " (" << monster->GetFightTable().Coefficient() << ")" << endl;
+    cout << fixed << setprecision(4)
+         << "wins " << result.WinRate() * 100 << "%  draws " << result.DrawRate() * 100
+         << "%  losses " << result.LossRate() * 100 << "%" << endl;
+    PrintAttacks("player", result.playerFightValues, result.weaponBonus);
+    PrintAttacks("monster", result.monsterFightValues, 0);
+    cout << setprecision(3) << result.fights << " fights in " << seconds << " s ("
+         << setprecision(1) << result.fights / seconds / 1e6 << "M fights/s)" << endl;
+    return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file BenchWorlds.cpp
+ * @brief Implementation of the worlds the benchmarks run on, loaded or generated once per run.
+ *
+ * **Functions**:
+ * - `const WorldFile& DefaultWorld()`: Maps the world file named by `CHANTS_DEFAULT_WORLD` on first use.
+ * - `const WorldFile& GeneratedWorld(uint32_t nodes)`: Generates and writes the world on first use, then maps it.
+ * - `const RoutePlanner& PlannerFor(const WorldFile& world)`: Builds a region-routed planner on first use.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "BenchWorlds.hpp"
+#include "WorldGenerator.hpp"
+#include <filesystem>
+#include <map>
+#include <memory>
+
+#ifndef CHANTS_DEFAULT_WORLD
+#define CHANTS_DEFAULT_WORLD "world.chw"
+#endif
+
+namespace chants
+{
+    const WorldFile &DefaultWorld()
+    {
+        static WorldFile world(CHANTS_DEFAULT_WORLD);
+        return world;
+    }
+
+    const WorldFile &GeneratedWorld(uint32_t nodes)
+    {
+        static std::map<uint32_t, std::unique_ptr<WorldFile>> worlds;
+        std::unique_ptr<WorldFile> &world = worlds[nodes];
+        if (!world)
+        {
+            GeneratorOptions options;
+            options.nodes = nodes;
+            options.seed = kBenchWorldSeed;
+            std::filesystem::path path = std::filesystem::temp_directory_path() / ("chants-bench-" + std::to_string(nodes) + ".chw");
+            WriteWorldFile(GenerateWorld(options), path.string());
+            world = std::make_unique<WorldFile>(path.string());
+        }
+        return *world;
+    }
+
+    const RoutePlanner &PlannerFor(const WorldFile &world)
+    {
+        static std::map<const WorldFile *, std::unique_ptr<RoutePlanner>> planners;
+        std::unique_ptr<RoutePlanner> &planner = planners[&world];
+        if (!planner)
+            planner = std::make_unique<RoutePlanner>(world.Graph(), world.Regions());
+        return *planner;
+    }
+}
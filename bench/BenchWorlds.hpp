@@ -0,0 +1,33 @@
+/**
+ * @file BenchWorlds.hpp
+ * @brief Declaration of the worlds the benchmarks run on, loaded or generated once per run.
+ *
+ * The micro benchmarks play on the default world compiled by the build; the session benchmarks play on worlds made
+ * by `GenerateWorld` with a fixed seed, so every run, and every release, measures the same worlds. Generated worlds
+ * are written to the temporary directory the first time a benchmark asks for them and mapped from there.
+ *
+ * **Public Functions**:
+ * - `const WorldFile& DefaultWorld()`: Returns the default world.
+ * - `const WorldFile& GeneratedWorld(uint32_t nodes)`: Returns the generated world with `nodes` locations.
+ * - `const RoutePlanner& PlannerFor(const WorldFile& world)`: Returns a route planner shared by every game on a world.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include "RoutePlanner.hpp"
+#include "WorldFile.hpp"
+
+namespace chants
+{
+    constexpr uint64_t kBenchWorldSeed = 2026;
+
+    const WorldFile &DefaultWorld();
+    const WorldFile &GeneratedWorld(uint32_t nodes);
+    const RoutePlanner &PlannerFor(const WorldFile &world);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file main.cpp
+ * @brief Entry point of the benchmark suite, recording what was measured alongside the results.
+ *
+ * Usage: `ChantsBench [--benchmark_filter=<regex>] [--benchmark_out=<file> --benchmark_out_format=json] ...`
+ *
+ * Takes every Google Benchmark flag. The context of the results, and of the JSON file, names the release and the
+ * seed of the generated worlds, so results from two releases can be told apart and compared (for instance with
+ * Google Benchmark's `compare.py`). The `bench` target runs the whole suite and writes `bench.json` in the build.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "BenchWorlds.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+
+#ifndef CHANTS_VERSION
+#define CHANTS_VERSION "unknown"
+#endif
+
+int main(int argc, char *argv[])
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::AddCustomContext("chants_version", CHANTS_VERSION);
+    benchmark::AddCustomContext("chants_world_seed", std::to_string(chants::kBenchWorldSeed));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,272 @@
+/**
+ * @file micro.cpp
+ * @brief Micro benchmarks for the hot calls of the GameMap library.
+ *
+ * Every benchmark times one call, or one pair of calls that leave the state as they found it, so its time per
+ * iteration can be compared across releases. Benchmarks with an argument sweep the size that call scales with.
+ *
+ * **Benchmarks**:
+ * - `BM_CombatantFight`: One fight roll.
+ * - `BM_NodeGetAConnection`, `BM_NodeGetAConnectionStandalone/<paths>`: Looking a path up on a map's node and on a node of its own.
+ * - `BM_NodeAddRemoveAsset/<assets>`, `BM_NodeAddRemoveMonster/<monsters>`: Adding an object to a map's node and removing it by name, with other objects there.
+ * - `BM_PlayerAddAsset/<inventory>`: Adding an asset to an inventory and removing it again.
+ * - `BM_PlayerCollectItems/<assets>`: Collecting every asset at a location into an empty inventory.
+ * - `BM_PlayerFindWeapon/<inventory>`: Listing and choosing a weapon from an inventory of mostly passive assets.
+ * - `BM_MapBuildDefault`, `BM_MapBuild/<locations>`, `BM_MapBuildStreaming/<locations>`: Building a map from a world file.
+ * - `BM_FindLocation/<locations>`: Looking a location up by name.
+ * - `BM_MonsterAITick/<locations>/<threads>`: One turn of monster movement, on the calling thread (1) or a pool.
+ * - `BM_HandleLine`: Parsing and running a command that leaves the game as it was, cycling through every kind.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "AdventureGameMap.hpp"
+#include "BenchWorlds.hpp"
+#include "GameEngine.hpp"
+#include "GameIO.hpp"
+#include "Monster.hpp"
+#include "Player.hpp"
+#include "ThreadPool.hpp"
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace chants;
+
+static void BM_CombatantFight(benchmark::State &state)
+{
+    Monster monster("Arlong", 4000, 150);
+    monster.Seed(1);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(monster.Fight());
+    }
+}
+BENCHMARK(BM_CombatantFight);
+
+static void BM_NodeGetAConnection(benchmark::State &state)
+{
+    AdventureGameMap map(DefaultWorld(), 1);
+    Node *node = map.GetLocation(0);
+    vector<int> ids(node->GetConnectionIds().begin(), node->GetConnectionIds().end());
+    ids.push_back(static_cast<int>(map.LocationCount())); // and one that is not there
+    size_t next = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(node->GetAConnection(ids[next]));
+        next = next + 1 == ids.size() ? 0 : next + 1;
+    }
+}
+BENCHMARK(BM_NodeGetAConnection);
+
+static void BM_NodeGetAConnectionStandalone(benchmark::State &state)
+{
+    Node hub(0, "Bench Hub");
+    std::deque<Node> connections;
+    for (int id = 1; id <= state.range(0); id++)
+    {
+        connections.emplace_back(id, "Bench Stop " + std::to_string(id));
+        hub.AddConnection(&connections.back());
+    }
+    int last = static_cast<int>(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(hub.GetAConnection(last));
+    }
+}
+BENCHMARK(BM_NodeGetAConnectionStandalone)->Arg(4)->Arg(32);
+
+static void BM_NodeAddRemoveAsset(benchmark::State &state)
+{
+    vector<Asset> others;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        others.emplace_back("Bench Asset " + std::to_string(i), "", 10, false);
+    }
+    Asset probe("Bench Probe", "", 10, true);
+    AdventureGameMap map(DefaultWorld(), 1);
+    Node *node = map.GetLocation(0);
+    for (Asset &other : others)
+    {
+        node->AddAsset(&other);
+    }
+    for (auto _ : state)
+    {
+        node->AddAsset(&probe);
+        node->RemoveAsset(std::string_view("Bench Probe"));
+    }
+}
+BENCHMARK(BM_NodeAddRemoveAsset)->Arg(0)->Arg(8)->Arg(64);
+
+static void BM_NodeAddRemoveMonster(benchmark::State &state)
+{
+    vector<Monster> others;
+    others.reserve(state.range(0));
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        others.emplace_back("Bench Monster " + std::to_string(i), 1000, 100);
+    }
+    Monster probe("Bench Probe", 1000, 100);
+    AdventureGameMap map(DefaultWorld(), 1);
+    Node *node = map.GetLocation(0);
+    for (Monster &other : others)
+    {
+        node->AddMonster(&other);
+    }
+    for (auto _ : state)
+    {
+        node->AddMonster(&probe);
+        node->RemoveMonster(std::string_view("Bench Probe"));
+    }
+}
+BENCHMARK(BM_NodeAddRemoveMonster)->Arg(0)->Arg(8)->Arg(64);
+
+static void BM_PlayerAddAsset(benchmark::State &state)
+{
+    Player player("Luffy", 10000, 200);
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        player.AddAsset(Asset("Bench Asset " + std::to_string(i), "", 10, false));
+    }
+    Asset probe("Bench Probe", "", 10, true);
+    Symbol name = probe.GetSymbol();
+    for (auto _ : state)
+    {
+        player.AddAsset(probe);
+        player.RemoveAsset(name);
+    }
+}
+BENCHMARK(BM_PlayerAddAsset)->Arg(0)->Arg(8)->Arg(64)->Arg(512)->Arg(4096);
+
+static void BM_PlayerCollectItems(benchmark::State &state)
+{
+    vector<Asset> assets;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        assets.emplace_back("Bench Asset " + std::to_string(i), "", 10, i % 2 == 0);
+    }
+    Node node(0, "Bench Hoard");
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Player player("Luffy", 10000, 200);
+        for (Asset &asset : assets)
+        {
+            node.AddAsset(&asset);
+        }
+        state.ResumeTiming();
+        player.CollectItems(node);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PlayerCollectItems)->Arg(8)->Arg(64);
+
+static void BM_PlayerFindWeapon(benchmark::State &state)
+{
+    Player player("Luffy", 10000, 200);
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        player.AddAsset(Asset("Bench Asset " + std::to_string(i), "", 10, i % 64 == 0));
+    }
+    string weapon = "Bench Asset 0";
+    NullOutput out;
+    for (auto _ : state)
+    {
+        player.ListWeapons(out);
+        benchmark::DoNotOptimize(player.FindWeapon(weapon));
+    }
+}
+BENCHMARK(BM_PlayerFindWeapon)->Arg(64)->Arg(4096);
+
+static void BM_MapBuildDefault(benchmark::State &state)
+{
+    const WorldFile &world = DefaultWorld();
+    unsigned seed = 0;
+    for (auto _ : state)
+    {
+        AdventureGameMap map(world, seed++);
+        benchmark::DoNotOptimize(map.LocationCount());
+    }
+}
+BENCHMARK(BM_MapBuildDefault);
+
+static void BM_MapBuild(benchmark::State &state)
+{
+    const WorldFile &world = GeneratedWorld(static_cast<uint32_t>(state.range(0)));
+    unsigned seed = 0;
+    for (auto _ : state)
+    {
+        AdventureGameMap map(world, seed++);
+        benchmark::DoNotOptimize(map.LocationCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapBuild)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_MapBuildStreaming(benchmark::State &state)
+{
+    const WorldFile &world = GeneratedWorld(static_cast<uint32_t>(state.range(0)));
+    unsigned seed = 0;
+    for (auto _ : state)
+    {
+        AdventureGameMap map(world, seed++, StreamingOptions());
+        benchmark::DoNotOptimize(map.LocationCount());
+    }
+}
+BENCHMARK(BM_MapBuildStreaming)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_FindLocation(benchmark::State &state)
+{
+    AdventureGameMap map(GeneratedWorld(static_cast<uint32_t>(state.range(0))), 1);
+    vector<string> names;
+    for (uint32_t i = 0; i < 1024; i++)
+    {
+        names.push_back(map.GetLocation(static_cast<uint32_t>((uint64_t(i) * 2654435761u) % map.LocationCount()))->GetName());
+    }
+    size_t next = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(map.FindLocation(std::string_view(names[next])));
+        next = (next + 1) & 1023;
+    }
+}
+BENCHMARK(BM_FindLocation)->Arg(10000)->Arg(100000);
+
+static void BM_MonsterAITick(benchmark::State &state)
+{
+    AdventureGameMap map(GeneratedWorld(static_cast<uint32_t>(state.range(0))), 1);
+    ThreadPool pool(static_cast<unsigned>(state.range(1)));
+    map.SetMonsterAI(true, &pool);
+    uint64_t turn = 0;
+    for (auto _ : state)
+    {
+        map.Advance(++turn);
+    }
+    state.counters["moves/turn"] = static_cast<double>(map.GetMonsterAI()->GetMoves()) / static_cast<double>(turn);
+}
+BENCHMARK(BM_MonsterAITick)->Args({100000, 1})->Args({100000, 4})->Unit(benchmark::kMillisecond);
+
+static void BM_HandleLine(benchmark::State &state)
+{
+    const WorldFile &world = DefaultWorld();
+    AdventureGameMap map(world, 1);
+    Player player("Luffy", 10000, 200);
+    NullOutput out;
+    GameEngine engine(map, player, out, 0, &PlannerFor(world));
+    engine.Start();
+
+    // a move there and back, then commands that find nothing, so the game never changes
+    const vector<string> lines = {std::to_string(*map.GetGraph().Neighbors(0).begin()), "0", "v", "t Nothing Here",
+                                  "a Nobody", "99999", "travel Nowhere"};
+    size_t next = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(engine.HandleLine(lines[next]));
+        next = next + 1 == lines.size() ? 0 : next + 1;
+    }
+}
+BENCHMARK(BM_HandleLine);
@@ -0,0 +1,113 @@
+/**
+ * @file sessions.cpp
+ * @brief Macro benchmarks replaying whole game sessions on generated worlds.
+ *
+ * A session is a game played by a bot for `kSessionCommands` commands, or until it ends. The bot takes every asset
+ * it finds, attacks every monster it meets with its best weapon, wanders along a random path otherwise and travels
+ * to a random location every 64 turns, so a session exercises moves, routes, the object indexes, fights and, on a
+ * streaming map, region paging. The bot draws from a seeded engine and the maps are built with fixed seeds on fixed
+ * generated worlds, so a session plays the same commands in every run and in every release that plays the same.
+ *
+ * Building the map is not timed (see `BM_MapBuild`). The `commands` counter is the rate of commands handled.
+ *
+ * **Benchmarks**:
+ * - `BM_Session/nodes:<locations>/stream:<0 or 1>`: Sessions on a map built up front or streamed by region.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "AdventureGameMap.hpp"
+#include "BenchWorlds.hpp"
+#include "Combatant.hpp"
+#include "GameEngine.hpp"
+#include "GameIO.hpp"
+#include "Player.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+using namespace chants;
+
+static constexpr uint64_t kSessionCommands = 2000;
+
+// the offensive asset with the highest value, or no weapon at all
+static const string &bestWeapon(const Player &player)
+{
+    static const string none = "none";
+    const Asset *best = nullptr;
+    const Inventory &inventory = player.GetInventory();
+    for (uint32_t position : inventory.InCategory(AssetCategory::Offensive))
+    {
+        const Asset &asset = inventory.Stacks()[position].asset;
+        if (!best || asset.GetValue() > best->GetValue())
+            best = &asset;
+    }
+    return best ? best->GetName() : none;
+}
+
+// plays one session and returns the number of commands handled
+static uint64_t playSession(AdventureGameMap &map, const RoutePlanner &planner, uint64_t seed)
+{
+    Player player("Luffy", 10000, 200);
+    player.Seed(MixSeed(seed, 0));
+    NullOutput out;
+    GameEngine engine(map, player, out, 0, &planner);
+    engine.Start();
+
+    FightEngine bot(MixSeed(seed, 1));
+    string line;
+    uint64_t commands = 0;
+    while (commands < kSessionCommands && engine.GetState() != GameEngine::State::Finished)
+    {
+        Node &here = *map.GetLocation(engine.GetPosition());
+        if (engine.GetState() == GameEngine::State::ChoosingWeapon)
+            line = bestWeapon(player);
+        else if (!here.GetAssets().empty())
+            line.assign("t ").append(here.GetAssets().front()->GetName());
+        else if (!here.GetMonsters().empty())
+            line.assign("a ").append(here.GetMonsters().front()->GetName());
+        else if (commands % 64 == 63)
+            line.assign("travel ").append(std::to_string((bot() >> 32) % map.LocationCount()));
+        else
+        {
+            WorldGraph::NeighborRange paths = here.GetConnectionIds();
+            line = std::to_string(paths[static_cast<uint32_t>((bot() >> 32) % paths.size())]);
+        }
+        engine.HandleLine(line);
+        commands++;
+    }
+    return commands;
+}
+
+static void BM_Session(benchmark::State &state)
+{
+    const WorldFile &world = GeneratedWorld(static_cast<uint32_t>(state.range(0)));
+    const RoutePlanner &planner = PlannerFor(world);
+    bool streaming = state.range(1) != 0;
+    uint64_t session = 0;
+    uint64_t commands = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        unsigned seed = static_cast<unsigned>(session);
+        std::unique_ptr<AdventureGameMap> map = streaming ? std::make_unique<AdventureGameMap>(world, seed, StreamingOptions())
+                                                          : std::make_unique<AdventureGameMap>(world, seed);
+        state.ResumeTiming();
+        commands += playSession(*map, planner, session++);
+        state.PauseTiming();
+        map.reset(); // tearing the map down is not timed either
+        state.ResumeTiming();
+    }
+    state.counters["commands"] = benchmark::Counter(static_cast<double>(commands), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Session)
+    ->ArgNames({"nodes", "stream"})
+    ->Args({10000, 0})
+    ->Args({100000, 0})
+    ->Args({100000, 1})
+    ->Args({1000000, 1})
+    ->Iterations(8)
+    ->Unit(benchmark::kMillisecond);
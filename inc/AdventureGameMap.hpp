@@ -5,12 +5,87 @@
  * The `AdventureGameMap` class manages the locations (nodes) in the game world, which the player can explore.
  * It contains methods for building the map and retrieving the list of locations.
  *
+ * The paths between locations live in a single `WorldGraph` indexed by node id, and every node is bound back to
+ * the map so it can resolve its neighbors. Because of that binding a map cannot be copied; copies of its nodes
+ * (for example from `GetLocations()`) still resolve their paths to the nodes owned by the map.
+ *
+ * A map built from a `WorldFile` reads its paths straight out of the mapped file, so the file must outlive the map.
+ * The map owns one `Asset` or `Monster` per placement in the file and places them when it is built. They are created
+ * in the map's `ObjectArena`, all in one block, and freed together with the map; nodes point into the arena.
+ *
+ * A map built with `StreamingOptions` is in streaming mode: instead of building every location up front it hands
+ * them out from a `RegionPager`, which keeps only the regions around the player's position (`SetFocus`) in memory.
+ * In streaming mode `GetLocation` may build a region on demand, a `Node` pointer is only valid until the next
+ * `SetFocus`, and `GetLocations()` returns the resident locations only.
+ *
+ * The map indexes its locations by name and the assets and monsters at each location by name (see `ObjectIndex`),
+ * so commands naming a target resolve in constant time. Nodes update the object indexes as objects are added and
+ * removed; in streaming mode a region's entries are added when it is adopted and dropped when it is evicted, so
+ * only resident locations can be found by name. If several locations share a name, `FindLocation` returns the one
+ * indexed first.
+ *
+ * The nodes also keep the map's `WorldState` current, the live count of assets and monsters at every location and in
+ * the whole world. A streaming map counts every placement in the world file up front, so the counts cover the whole
+ * world and not just the resident regions.
+ *
+ * A map built from a world file can be saved into a `GameSnapshot`, which records the map's seed and the objects
+ * that differ from the world file's placements, and built again from one, streaming or not whichever way it was
+ * saved.
+ *
+ * A map built from a world file can also respawn its monsters (`SetRespawnDelay`). A defeated monster then comes back
+ * at the location it was placed at, with a fresh fight, that many turns later. Game turns are the clock: the engine
+ * calls `Advance` with the turn count at the start of every turn, so a replayed game respawns its monsters on the same
+ * turns. Waiting monsters are kept in a `TimingWheel` by placement, and defeated monsters go back to a `MonsterPool`
+ * to be built again on respawn, so a world that keeps respawning stops allocating. Respawning monsters are part of a
+ * saved game. The game is still won by defeating every monster, before any of them return.
+ *
+ * A map built from a world file and held whole can also move its monsters (`SetMonsterAI`): at the start of every
+ * turn, after the respawns due, a `MonsterAI` moves them between locations, hunting the player around the location
+ * last passed to `SetFocus`. With monster AI on, `Advance` goes one turn at a time, so a game replayed in jumps of
+ * many turns moves and respawns its monsters in the same order as it did turn by turn. Whether monsters move is part
+ * of a saved game; a streaming map cannot move them, since most of its locations are not in memory.
+ *
  * **Public Methods**:
  * - `AdventureGameMap()`: Constructor to initialize the map.
- * - `vector<Node> GetLocations()`: Returns the list of game locations (nodes).
+ * - `AdventureGameMap(const WorldFile& world, unsigned seed)`: Constructor to build the map, its assets and monsters from a world file; `seed` picks the nodes of randomly placed objects and seeds the monsters' fights.
+ * - `AdventureGameMap(const WorldFile& world, unsigned seed, const StreamingOptions& streaming)`: Constructor to open a world file in streaming mode.
+ * - `AdventureGameMap(const WorldFile& world, const GameSnapshot& snapshot)`: Constructor to rebuild a saved map; throws `std::runtime_error` if it was saved in a different world.
+ * - `AdventureGameMap(const WorldFile& world, const GameSnapshot& snapshot, const StreamingOptions& streaming)`: Constructor to reopen a saved map in streaming mode.
+ * - `uint32_t LocationCount() const`: Returns the number of locations.
+ * - `bool IsStreaming() const`: Checks whether the map streams its regions.
+ * - `void SetFocus(uint32_t id)`: Tells the map where the player is, so a streaming map can page regions in and out.
+ * - `vector<Node> GetLocations()`: Returns copies of the game locations (nodes).
+ * - `void ForEachLocation(Visit&& visit) const`: Calls `visit` with every location, or every resident one in streaming mode, without copying them.
+ * - `Node *GetLocation(uint32_t id)`: Returns the location with the given id, or `nullptr` if there is none.
+ * - `Node *FindLocation(string_view name)`: Returns the location with the given name in any case, or `nullptr` if there is none.
+ * - `Node *FindLocation(Symbol name)`: Returns the location by the symbol of its name, or `nullptr` if there is none.
+ * - `const WorldGraph &GetGraph() const`: Returns the paths between locations.
+ * - `void AddPath(uint32_t from, uint32_t to)`: Adds a one-way path between two existing locations; each call repacks the graph, so add many paths with `AddPaths`.
+ * - `void AddPaths(const vector<pair<uint32_t, uint32_t>>& paths)`: Adds one-way paths between existing locations and repacks the graph once for all of them.
+ * - `const WorldState &GetWorldState() const`: Returns the live counts of assets and monsters left in the world.
+ * - `size_t MemoryUsage() const`: Returns an estimate of the bytes the map holds; the world file it reads from is shared and not counted.
+ * - `void Save(GameSnapshot& snapshot) const`: Records the map's seed, every placed object that was taken, defeated, moved or has fought, and the monsters waiting to respawn.
+ * - `void SetRespawnDelay(uint32_t turns)`: Sets the turns a monster defeated from now on takes to respawn, 0 for never; ignored by a map not built from a world file.
+ * - `uint32_t GetRespawnDelay() const`: Returns the respawn delay.
+ * - `void Advance(uint64_t turn)`: Respawns the monsters due by `turn`, in the order they were defeated.
+ * - `size_t PendingRespawns() const`: Returns the number of monsters waiting to respawn.
+ * - `void SetMonsterAI(bool enabled, ThreadPool* pool = nullptr)`: Turns monster movement on or off, ticking large worlds on `pool` if given; ignored by a map not built from a world file, and throws `std::runtime_error` for a streaming map.
+ * - `const MonsterAI *GetMonsterAI() const`: Returns the monster AI, or `nullptr` if monsters do not move.
  *
  * **Private Methods**:
  * - `buildMapNodes()`: Constructs the map nodes and their connections.
+ * - `bindLocations()`: Points every node at this map so it can resolve its paths.
+ * - `buildLocations(const WorldFile& world, const vector<GameSnapshot::ObjectChange>& changes)`: Creates a node per location of a world file, then its objects.
+ * - `placeObjects(const WorldFile& world, const vector<GameSnapshot::ObjectChange>& changes)`: Creates the assets and monsters of a world file, as changed by a saved game, and adds them to their nodes.
+ * - `placeObject(const WorldFile& world, const GameSnapshot::ObjectChange& object)`: Creates one placed object at its node.
+ * - `ownsLocation(const Node* node)`: Checks whether a node is the map's own copy of its location, rather than a copy handed out.
+ * - `assetIndexOf(const Node* node)`, `monsterIndexOf(const Node* node)`: Return the object index a node updates, or `nullptr` if the node is not the map's own.
+ * - `worldStateOf(const Node* node)`: Returns the world state a node updates, or `nullptr` if the node is not the map's own.
+ * - `indexLocation(const Node& node)`, `unindexLocation(const Node& node)`: Add or drop a location's name and objects to or from the indexes.
+ * - `restoreRespawns(const WorldFile& world, const GameSnapshot& snapshot)`: Takes up a saved game's respawn delay and waiting monsters.
+ * - `respawnsMonsters(const Node* node)`: Checks whether monsters defeated at a node are to respawn.
+ * - `retireMonster(Monster* monster, uint32_t node)`: Schedules a defeated monster's respawn and takes the object back.
+ * - `respawn(uint32_t placement, uint64_t due)`: Brings a monster back at the location it was placed at.
  *
  * @author Evan Aarons-Wood
  * @version 1.0
@@ -20,8 +95,25 @@
 
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
 #include <string>
+#include <utility>
+#include <Asset.hpp>
+#include <GameSnapshot.hpp>
+#include <Monster.hpp>
+#include <MonsterAI.hpp>
+#include <MonsterPool.hpp>
 #include <Node.hpp>
+#include <ObjectArena.hpp>
+#include <ObjectIndex.hpp>
+#include <RegionPager.hpp>
+#include <SymbolTable.hpp>
+#include <TimingWheel.hpp>
+#include <WorldFile.hpp>
+#include <WorldGraph.hpp>
+#include <WorldState.hpp>
 
 using namespace std;
 
@@ -31,11 +123,84 @@ namespace chants
     {
     private:
         vector<Node> locations;
+        WorldGraph graph;
+        ObjectArena objects;               // the assets and monsters nodes point to, when not streaming
+        std::unique_ptr<RegionPager> pager; // set in streaming mode only
+        std::unordered_map<Symbol, uint32_t> locationIndex;
+        ObjectIndex assetIndex;
+        ObjectIndex monsterIndex;
+        WorldState worldState;
+        unsigned seed = 0;                // picked the placements and seeded the monsters
+        vector<GameSnapshot::ObjectChange> startingObjects; // where every placed object started, when not streaming
+        const WorldFile *worldFile = nullptr; // the world file the map was built from, if any
+        MonsterPool monsterPool{objects};  // defeated monsters, reused on respawn when not streaming
+        TimingWheel respawns;              // defeated monsters by placement, due on the turn they respawn
+        vector<TimingWheel::Timer> due;    // the respawns fired by the last Advance
+        uint32_t respawnDelay = 0;         // turns until a defeated monster respawns, 0 for never
+        std::unique_ptr<MonsterAI> monsterAI; // set while monsters move
+        uint32_t focus = 0;                // the player's location, as last passed to SetFocus
+
+        friend class Node;
+        friend class RegionPager;
+        friend class MonsterAI;
 
         void buildMapNodes();
+        void bindLocations();
+        void buildLocations(const WorldFile &world, const vector<GameSnapshot::ObjectChange> &changes);
+        void placeObjects(const WorldFile &world, const vector<GameSnapshot::ObjectChange> &changes);
+        void placeObject(const WorldFile &world, const GameSnapshot::ObjectChange &object);
+        bool ownsLocation(const Node *node) const;
+        ObjectIndex *assetIndexOf(const Node *node);
+        ObjectIndex *monsterIndexOf(const Node *node);
+        WorldState *worldStateOf(const Node *node);
+        void indexLocation(const Node &node);
+        void unindexLocation(const Node &node);
+        void restoreRespawns(const WorldFile &world, const GameSnapshot &snapshot);
+        bool respawnsMonsters(const Node *node) const;
+        void retireMonster(Monster *monster, uint32_t node);
+        void respawn(uint32_t placement, uint64_t due);
 
     public:
         AdventureGameMap();
+        AdventureGameMap(const WorldFile &world, unsigned seed);
+        AdventureGameMap(const WorldFile &world, unsigned seed, const StreamingOptions &streaming);
+        AdventureGameMap(const WorldFile &world, const GameSnapshot &snapshot);
+        AdventureGameMap(const WorldFile &world, const GameSnapshot &snapshot, const StreamingOptions &streaming);
+        AdventureGameMap(const AdventureGameMap &) = delete;
+        AdventureGameMap &operator=(const AdventureGameMap &) = delete;
+        uint32_t LocationCount() const;
+        bool IsStreaming() const;
+        void SetFocus(uint32_t id);
         vector<Node> GetLocations();
+        Node *GetLocation(uint32_t id);
+        Node *FindLocation(string_view name);
+        Node *FindLocation(Symbol name);
+        const WorldGraph &GetGraph() const;
+        void AddPath(uint32_t from, uint32_t to);
+        void AddPaths(const vector<pair<uint32_t, uint32_t>> &paths);
+        const WorldState &GetWorldState() const;
+        size_t MemoryUsage() const;
+
+        template <typename Visit>
+        void ForEachLocation(Visit &&visit) const
+        {
+            if (pager)
+                pager->ForEachResident(visit);
+            else
+            {
+                for (const Node &location : locations)
+                {
+                    visit(location);
+                }
+            }
+        }
+
+        void Save(GameSnapshot &snapshot) const;
+        void SetRespawnDelay(uint32_t turns);
+        uint32_t GetRespawnDelay() const;
+        void Advance(uint64_t turn);
+        size_t PendingRespawns() const;
+        void SetMonsterAI(bool enabled, ThreadPool *pool = nullptr);
+        const MonsterAI *GetMonsterAI() const;
     };
 }
\ No newline at end of file
@@ -3,20 +3,34 @@
  * @brief Declaration of the Asset class, representing items in the game.
  *
  * The `Asset` class defines the properties and behavior of in-game items that the player can collect and use. 
- * These items can have various attributes, such as a name, description, value, and whether they are offensive (weapons).
+ * These items can have various attributes, such as a name, description, value, and a category: offensive (weapons),
+ * healing, navigation or passive.
+ *
+ * The name and the message are interned in the global `SymbolTable`, so an asset is a small, trivially copyable
+ * value: maps create theirs in an `ObjectArena` without destructors, and the player's inventory copies one in a few
+ * words.
+ *
+ * **Public Types**:
+ * - `AssetCategory`: What an asset is for; the player's `Inventory` keeps a list of the assets in each.
  *
  * **Public Methods**:
- * - `Asset(string name, string message, int value, bool isOffensive)`: Constructor to initialize the asset with its attributes.
- * - `string GetName() const`: Returns the name of the asset.
- * - `string GetMessage() const`: Returns the description or message associated with the asset.
+ * - `Asset(string_view name, string_view message, int value, AssetCategory category)`: Constructor to initialize the asset with its attributes.
+ * - `Asset(string_view name, string_view message, int value, bool isOffensive)`: Constructor for an offensive or a passive asset.
+ * - `const string& GetName() const`: Returns the name of the asset.
+ * - `Symbol GetSymbol() const`: Returns the interned symbol of the asset's name, for comparing names as integers.
+ * - `const string& GetMessage() const`: Returns the description or message associated with the asset.
  * - `int GetValue() const`: Returns the value of the asset.
+ * - `AssetCategory GetCategory() const`: Returns the category of the asset.
  * - `bool isOffensive() const`: Checks if the asset is offensive (e.g., a weapon).
+ * - `uint32_t GetPlacement() const`: Returns the index of the world file placement the asset was created for, or `kNoPlacement`.
+ * - `void SetPlacement(uint32_t placement)`: Records the placement the asset was created for, so saved games can refer to it.
  *
  * **Attributes**:
- * - `_name`: The name of the asset.
- * - `_message`: A description or message about the asset.
+ * - `_name`: The symbol of the asset's name in the global `SymbolTable`.
+ * - `_message`: The symbol of a description or message about the asset in `SymbolTable::Text()`, which keeps its case.
  * - `_value`: The value associated with the asset (e.g., its effectiveness or cost).
- * - `_isOffensive`: Whether the asset is offensive (used in combat).
+ * - `_category`: What the asset is for; offensive assets are used in combat.
+ * - `_placement`: The world file placement the asset was created for.
  * - `hasBeenUsed`: Tracks whether the asset has been used.
  *
  * @author Evan Aarons-Wood
@@ -27,26 +41,49 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include "SymbolTable.hpp"
 
 using namespace std;
 
 namespace chants
 {
+    enum class AssetCategory : uint8_t
+    {
+        Passive,
+        Offensive,  // adds to the player's attack
+        Healing,    // restores health or energy
+        Navigation, // maps and instruments
+        Count
+    };
+
+    constexpr size_t kAssetCategoryCount = static_cast<size_t>(AssetCategory::Count);
+
     class Asset
     {
     private:
-        string _name;
-        string _message;
+        Symbol _name;
+        Symbol _message;
         int _value;
-        bool _isOffensive;
+        AssetCategory _category;
+        uint32_t _placement;
 
     public:
+        static constexpr uint32_t kNoPlacement = UINT32_MAX;
+
         bool hasBeenUsed;
-        Asset(string name, string message, int value, bool isOffensive);
-        string GetName() const;
-        string GetMessage() const;
+        Asset(string_view name, string_view message, int value, AssetCategory category);
+        Asset(string_view name, string_view message, int value, bool isOffensive);
+        const string &GetName() const;
+        Symbol GetSymbol() const;
+        const string &GetMessage() const;
         int GetValue() const;
+        AssetCategory GetCategory() const;
         bool isOffensive() const;
+        uint32_t GetPlacement() const;
+        void SetPlacement(uint32_t placement);
     };
 }
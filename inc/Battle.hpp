@@ -0,0 +1,48 @@
+/**
+ * @file Battle.hpp
+ * @brief Declaration of the battle rules shared by the game and the battle simulator.
+ *
+ * A battle is a single exchange: the player and the monster each draw a fight value, the player adds the value of
+ * an offensive weapon if one is used, and the higher attack wins. Drawing the fight values advances each
+ * combatant's own random engine, so the combatants are taken by reference.
+ *
+ * **Public Types**:
+ * - `BattleOutcome`: Who won the exchange; the values match the results the game has always used (1, 0, -1).
+ * - `BattleReport`: Both attack values and the outcome of a battle.
+ *
+ * **Public Functions**:
+ * - `int WeaponBonus(const Asset* weapon)`: Returns what a weapon adds to the player's attack: its value if it is offensive, otherwise 0.
+ * - `BattleOutcome CompareAttacks(int playerAttack, int monsterAttack)`: Decides a battle from the two attack values.
+ * - `BattleReport ResolveBattle(Combatant& player, Combatant& monster, const Asset* weapon)`: Fights one battle.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include "Asset.hpp"
+#include "Combatant.hpp"
+
+namespace chants
+{
+    enum class BattleOutcome : int
+    {
+        MonsterWins = -1,
+        Draw = 0,
+        PlayerWins = 1
+    };
+
+    struct BattleReport
+    {
+        int playerAttack;
+        int monsterAttack;
+        BattleOutcome outcome;
+    };
+
+    int WeaponBonus(const Asset *weapon);
+    BattleOutcome CompareAttacks(int playerAttack, int monsterAttack);
+    BattleReport ResolveBattle(Combatant &player, Combatant &monster, const Asset *weapon = nullptr);
+}
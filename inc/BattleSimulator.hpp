@@ -0,0 +1,94 @@
+/**
+ * @file BattleSimulator.hpp
+ * @brief Declaration of the BattleSimulator class, estimating how battles go by fighting them millions of times.
+ *
+ * The `BattleSimulator` class plays the battle rules of `Battle.hpp` between one player and one monster, with an
+ * optional weapon, over and over on every core, and reports how often each side wins and how the attack values are
+ * spread. It is meant for balancing worlds: deciding monster coefficients and weapon values.
+ *
+ * The combatants are read once, when the simulator is built. Fights are then evaluated straight from the
+ * combatants' `FightTable`s with a `FightEngine` per block of fights, so the inner loop neither copies combatants
+ * nor allocates. Fights are split into blocks of `kBlockSize`, each seeded from the run's seed and its block number,
+ * so a seed gives the same result however many threads run it.
+ *
+ * A fight value is one of the `FightTable::kSize` quantiles of its table, so fights are counted by quantile rather
+ * than by value: a histogram is the same size whatever the coefficient, and the mean, deviation and percentiles
+ * read off it are still exact.
+ *
+ * **Public Types**:
+ * - `SimulationOptions`: The number of fights, worker threads (0 for one per hardware thread) and the seed.
+ * - `FightHistogram`: The fight value of each quantile of a side's table and the number of fights that drew it, with its mean, deviation and percentiles.
+ * - `SimulationResult`: Win, draw and loss counts and a histogram of each side's fight values; the player's attacks are its fight values plus `weaponBonus`.
+ *
+ * **Public Methods**:
+ * - `BattleSimulator(const Combatant& player, const Combatant& monster, const Asset* weapon = nullptr)`: Constructor that reads the combatants and weapon.
+ * - `SimulationResult Run(const SimulationOptions& options) const`: Fights `options.fights` battles and totals them.
+ *
+ * **Attributes**:
+ * - `_playerTable`, `_monsterTable`: The fight value distributions of the player and the monster.
+ * - `_weaponBonus`: What the weapon adds to every player attack.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Asset.hpp"
+#include "Combatant.hpp"
+#include "FightTable.hpp"
+
+using std::vector;
+
+namespace chants
+{
+    struct SimulationOptions
+    {
+        uint64_t fights = 1000000;
+        unsigned threads = 0;
+        uint64_t seed = 0;
+    };
+
+    struct FightHistogram
+    {
+        vector<int32_t> values;  // the fight value of each quantile, ascending, before the weapon bonus
+        vector<uint64_t> counts; // number of fights that drew each quantile
+
+        double Mean() const;
+        double Deviation() const;
+        int Percentile(double fraction) const;
+    };
+
+    struct SimulationResult
+    {
+        uint64_t fights = 0;
+        uint64_t playerWins = 0;
+        uint64_t draws = 0;
+        uint64_t monsterWins = 0;
+        int weaponBonus = 0;
+        FightHistogram playerFightValues;
+        FightHistogram monsterFightValues;
+
+        double WinRate() const;
+        double DrawRate() const;
+        double LossRate() const;
+    };
+
+    class BattleSimulator
+    {
+    public:
+        static constexpr uint64_t kBlockSize = 1 << 16;
+
+        BattleSimulator(const Combatant &player, const Combatant &monster, const Asset *weapon = nullptr);
+        SimulationResult Run(const SimulationOptions &options) const;
+
+    private:
+        const FightTable *_playerTable;
+        const FightTable *_monsterTable;
+        int _weaponBonus;
+    };
+}
@@ -5,16 +5,30 @@
  * The `Combatant` class defines the properties and behaviors of characters in the game that can participate in combat,
  * including the ability to fight and track health. This class serves as the base class for both players and monsters.
  *
+ * Each combatant draws its fight values from its own random engine, seeded differently for every combatant unless
+ * `Seed` is called, and looks them up in the shared `FightTable` for its coefficient, so a fight costs the same
+ * whatever the coefficient. Copies of a combatant carry on the same random sequence as the original.
+ *
  * **Public Methods**:
- * - `Combatant(string name, int health, int coefficient)`: Constructor to initialize the combatant with a name, health, and fight coefficient.
+ * - `Combatant(string_view name, int health, int coefficient)`: Constructor to initialize the combatant with a name, health, and fight coefficient.
  * - `int Fight()`: Calculates and returns the combatant's attack value based on their fight coefficient.
- * - `string GetName()`: Returns the name of the combatant.
- * - `int GetHealth()`: Returns the health of the combatant.
+ * - `void Seed(uint64_t seed)`: Restarts the combatant's random engine from a seed, for repeatable fights.
+ * - `const FightTable& GetFightTable() const`: Returns the distribution the combatant's fight values are drawn from.
+ * - `const string& GetName() const`: Returns the name of the combatant.
+ * - `Symbol GetSymbol() const`: Returns the interned symbol of the combatant's name, for comparing names as integers.
+ * - `int GetHealth() const`: Returns the health of the combatant.
+ * - `void SetHealth(int health)`: Sets the health of the combatant, when a saved game is restored.
+ * - `uint64_t GetFightState() const`: Returns the state of the combatant's random engine; `Seed` with it carries on the same sequence of fights.
+ *
+ * **Public Functions**:
+ * - `uint64_t MixSeed(uint64_t seed, uint64_t stream)`: Derives a well-mixed seed for one of many streams (a combatant, a block of fights) from a single seed.
  *
  * **Attributes**:
- * - `_name`: The name of the combatant.
+ * - `_name`: The symbol of the combatant's name in the global `SymbolTable`.
  * - `_health`: The health of the combatant, representing their vitality in combat.
  * - `_fightCoefficient`: A coefficient that influences the combatant's attack value.
+ * - `_fightTable`: The distribution of attack values for `_fightCoefficient`.
+ * - `_rng`: The combatant's random engine.
  *
  * @author Evan Aarons Wood
  * @version 1.0
@@ -23,22 +37,39 @@
 
 
 #pragma once
+#include <cstdint>
+#include <random>
 #include <string>
+#include <string_view>
+#include "FightTable.hpp"
+#include "SymbolTable.hpp"
 using namespace std;
 
 namespace chants
 {
+    // 64-bit LCG (Knuth's MMIX constants); small enough to give every combatant its own, and only its high bits are used
+    using FightEngine = std::linear_congruential_engine<uint64_t, 6364136223846793005ULL, 1442695040888963407ULL, 0>;
+
+    uint64_t MixSeed(uint64_t seed, uint64_t stream);
+
     class Combatant
     {
     protected:
-        string _name;
+        Symbol _name;
         int _health;
         int _fightCoefficient;
+        const FightTable *_fightTable;
+        FightEngine _rng;
 
     public:
-        Combatant(string name, int health, int coefficient);
+        Combatant(string_view name, int health, int coefficient);
         int Fight();
-        string GetName();
-        int GetHealth();
+        void Seed(uint64_t seed);
+        const FightTable &GetFightTable() const;
+        const string &GetName() const;
+        Symbol GetSymbol() const;
+        int GetHealth() const;
+        void SetHealth(int health);
+        uint64_t GetFightState() const;
     };
 }
\ No newline at end of file
@@ -0,0 +1,179 @@
+/**
+ * @file EventJournal.hpp
+ * @brief Declaration of the EventJournal class, an append-only log of everything that changes a game.
+ *
+ * A `GameEngine` with a journal records every change it makes to the game as a `GameEvent`: each step the player
+ * takes, each asset taken and each battle with its outcome and the combatants' fight states afterwards. Events are
+ * small fixed records that refer to locations and objects by id and placement, the same as a `GameSnapshot`, so the
+ * journal doubles as an audit trail of the game.
+ *
+ * The journal lives in two files: the journal itself at `path`, and a compacted snapshot at `path + ".snap"`.
+ * `Append` only copies the event into memory, so the game never waits for the disk. A writer thread writes what
+ * has been appended in one write and syncs it once per batch: every `syncInterval` milliseconds, or sooner once
+ * `batchEvents` are waiting. After `compactAfter` events the writer folds them into the snapshot, replaces the
+ * snapshot file and empties the journal, so neither file grows with the length of the game.
+ *
+ * Replaying events needs a player to replay them for, and a snapshot does not record who the player started as, so
+ * the journal is given the `PlayerProfile` the game's player was built from, and `Recover` is given it too.
+ *
+ * `Recover` reads the snapshot and applies the journal's events on top. Every event carries a checksum and a
+ * sequence number, and the files share a generation number, so a record torn by a crash, or a journal left over
+ * from before the snapshot was replaced, is ignored: a game recovers as it was at its last synced event.
+ *
+ * **File Layout** (little-endian):
+ * - Snapshot file: `SnapshotHeader` (magic, version, generation, the sequence of the last event folded in), then an encoded `GameSnapshot`.
+ * - Journal file: `JournalHeader` (magic, version, generation), then `GameEvent` records in sequence order.
+ *
+ * **Public Types**:
+ * - `GameEvent`: One change to the game.
+ * - `JournalOptions`: How often the journal is synced and compacted.
+ * - `JournalStats`: Counters of events, writes, syncs and compactions.
+ *
+ * **Public Methods**:
+ * - `EventJournal(const string& path, const WorldFile& world, const PlayerProfile& player, const GameSnapshot& start, const JournalOptions& options = JournalOptions())`: Starts a journal for a game in the state `start`, played by a player built from `player`, replacing any files at `path`; throws `std::runtime_error` if they cannot be written.
+ * - `~EventJournal()`: Writes and syncs everything appended, then stops the writer.
+ * - `void Append(GameEvent event)`: Numbers an event and queues it for the writer.
+ * - `void Sync()`: Blocks until every event appended so far is on disk.
+ * - `JournalStats Stats() const`: Returns the journal's counters.
+ * - `static bool Exists(const string& path)`: Checks whether a journal's snapshot file exists.
+ * - `static GameSnapshot Recover(const string& path, const WorldFile& world, const PlayerProfile& player)`: Returns the game as of the last event on disk; throws `std::runtime_error` if there is no valid snapshot.
+ * - `static void Fold(GameSnapshot& snapshot, const vector<GameEvent>& events, const WorldFile& world, const PlayerProfile& player)`: Applies events to a snapshot by replaying them on a map and a player built from it.
+ *
+ * **Attributes**:
+ * - `_path`, `_world`, `_player`, `_options`: The journal's path, the world the game is played in, the profile its player was built from and the options.
+ * - `_fd`, `_generation`: The open journal file and the generation it shares with the snapshot.
+ * - `_base`, `_baseSequence`, `_unfolded`: The snapshot on disk, the last event in it and the events written since (owned by the writer).
+ * - `_mutex`, `_wake`, `_synced`: Guard the queue, wake the writer and wake `Sync`.
+ * - `_queue`, `_appended`, `_written`, `_syncRequested`, `_stop`, `_error`: Events waiting to be written, the last sequence appended and written, the writer's flags and its first failure.
+ * - `_syncs`, `_compactions`: Counters for `Stats`.
+ * - `_writer`: The writer thread.
+ *
+ * **Private Methods**:
+ * - `void writerLoop()`: Writes, syncs and compacts on the writer thread.
+ * - `void writeSnapshot()`: Replaces the snapshot file with `_base`.
+ * - `void resetJournal()`: Empties the journal file down to its header.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GameSnapshot.hpp"
+#include "Player.hpp"
+#include "WorldFile.hpp"
+
+using std::string;
+using std::vector;
+
+namespace chants
+{
+    struct GameEvent
+    {
+        enum class Kind : uint32_t
+        {
+            Move = 0,  // the player stepped to `node`
+            Take = 1,  // the player took the asset of `placement` at `node`
+            Battle = 2 // the player fought the monster of `placement` at `node`
+        };
+
+        Kind kind;
+        uint32_t node;
+        uint32_t placement;
+        int32_t outcome;            // a battle's `BattleOutcome`
+        uint64_t sequence;          // set by `Append`, from 1
+        uint64_t turn;              // the engine's turn count after the event
+        uint64_t playerFightState;  // after a battle
+        uint64_t monsterFightState; // after a battle
+        uint64_t checksum;          // set by the writer
+    };
+
+    struct JournalOptions
+    {
+        uint32_t syncInterval = 50;   // milliseconds an event may wait to be written and synced
+        uint32_t batchEvents = 256;   // events that wake the writer before the interval is up
+        uint32_t compactAfter = 4096; // events written before they are folded into the snapshot
+    };
+
+    struct JournalStats
+    {
+        uint64_t appended = 0;
+        uint64_t written = 0;
+        uint64_t syncs = 0;
+        uint64_t compactions = 0;
+    };
+
+    class EventJournal
+    {
+    public:
+        static constexpr char kJournalMagic[4] = {'C', 'H', 'E', 'J'};
+        static constexpr char kSnapshotMagic[4] = {'C', 'H', 'J', 'S'};
+        static constexpr uint32_t kVersion = 1;
+
+        struct JournalHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint64_t generation;
+        };
+
+        struct SnapshotHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint64_t generation;
+            uint64_t sequence;
+        };
+
+        EventJournal(const string &path, const WorldFile &world, const PlayerProfile &player, const GameSnapshot &start,
+                     const JournalOptions &options = JournalOptions());
+        ~EventJournal();
+        EventJournal(const EventJournal &) = delete;
+        EventJournal &operator=(const EventJournal &) = delete;
+
+        void Append(GameEvent event);
+        void Sync();
+        JournalStats Stats() const;
+        static bool Exists(const string &path);
+        static GameSnapshot Recover(const string &path, const WorldFile &world, const PlayerProfile &player);
+        static void Fold(GameSnapshot &snapshot, const vector<GameEvent> &events, const WorldFile &world, const PlayerProfile &player);
+
+    private:
+        string _path;
+        const WorldFile &_world;
+        PlayerProfile _player;
+        JournalOptions _options;
+        int _fd;
+        uint64_t _generation;
+
+        // owned by the writer thread
+        GameSnapshot _base;
+        uint64_t _baseSequence;
+        vector<GameEvent> _unfolded;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _synced;
+        vector<GameEvent> _queue;
+        uint64_t _appended;
+        uint64_t _written;
+        bool _syncRequested;
+        bool _stop;
+        string _error; // the writer's first failure
+        uint64_t _syncs;
+        uint64_t _compactions;
+        std::thread _writer;
+
+        void writerLoop();
+        void writeSnapshot();
+        void resetJournal();
+    };
+}
@@ -0,0 +1,63 @@
+/**
+ * @file FightTable.hpp
+ * @brief Declaration of the FightTable class, drawing a combatant's fight value in constant time.
+ *
+ * A fight value is the average of `coefficient` whole numbers drawn uniformly from `[0, coefficient)`, rounded down.
+ * Drawing the numbers one by one costs `coefficient` steps per attack, so instead a `FightTable` works out the
+ * distribution of that average once per coefficient and stores it as `kSize` equally likely quantiles. A fight value
+ * is then one table lookup indexed by the top bits of a random number.
+ *
+ * The distribution is computed exactly for coefficients up to `kExactLimit`; above that the average is so close to
+ * normal that the normal distribution with the same mean and variance is used. Outcomes less likely than half a
+ * quantile (`1 / (2 * kSize)`) in either tail are folded into their neighbors.
+ *
+ * Tables are built on first use and shared: `For` keeps one table per coefficient for the life of the program, so
+ * a combatant can hold on to the reference it gets.
+ *
+ * **Public Methods**:
+ * - `explicit FightTable(int coefficient)`: Constructor that computes the quantiles for a coefficient.
+ * - `static const FightTable& For(int coefficient)`: Returns the shared table for a coefficient, building it if needed.
+ * - `int Sample(uint64_t bits) const`: Returns the fight value picked by a uniformly random 64-bit number.
+ * - `int Coefficient() const`: Returns the coefficient the table was built for.
+ * - `const int32_t *Values() const`: Returns the `kSize` quantiles, for callers that index the table themselves.
+ *
+ * **Attributes**:
+ * - `_coefficient`: The fight coefficient.
+ * - `_values`: The fight value at each quantile, in ascending order.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace chants
+{
+    class FightTable
+    {
+    public:
+        static constexpr uint32_t kBits = 12;
+        static constexpr uint32_t kSize = 1u << kBits;
+        static constexpr int kExactLimit = 256;
+
+        explicit FightTable(int coefficient);
+        static const FightTable &For(int coefficient);
+
+        int Sample(uint64_t bits) const
+        {
+            return _values[bits >> (64 - kBits)];
+        }
+
+        int Coefficient() const;
+        const int32_t *Values() const;
+
+    private:
+        int _coefficient;
+        std::array<int32_t, kSize> _values;
+    };
+}
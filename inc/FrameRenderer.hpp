@@ -0,0 +1,67 @@
+/**
+ * @file FrameRenderer.hpp
+ * @brief Declaration of the FrameRenderer class, an output sink that sends each turn's text in a single write.
+ *
+ * The `FrameRenderer` class collects everything written during a turn (a frame) in one buffer and hands it to the
+ * file descriptor with one `write` call when the engine flushes at the end of the turn. The buffer is cleared but not
+ * freed between frames, so once it has grown to the largest frame, a turn costs no allocations and one system call,
+ * however many lines and color changes it contains.
+ *
+ * Color is decided once, when the renderer is made; the game turns it on only when `IsTerminal` says the descriptor
+ * is a terminal, so piping the game into a file or another program gives plain text.
+ *
+ * **Public Methods**:
+ * - `FrameRenderer(int fd, bool color)`: Constructor that renders to a file descriptor it does not own.
+ * - `static bool IsTerminal(int fd)`: Checks whether a file descriptor is a terminal.
+ * - `void Write(string_view text)`: Appends text to the frame.
+ * - `void Flush()`: Writes the frame with one system call (more only if the descriptor takes part of it) and starts the next.
+ * - `bool UsesColor() const`: Returns whether ANSI colors are written.
+ * - `size_t Pending() const`: Returns the number of bytes waiting in the frame.
+ * - `uint64_t Frames() const`: Returns the number of frames written.
+ *
+ * **Attributes**:
+ * - `_fd`: The file descriptor written to.
+ * - `_color`: Whether ANSI colors are written.
+ * - `_frame`: The text of the current frame, reused from frame to frame.
+ * - `_frames`: The number of frames written.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "GameIO.hpp"
+
+using std::string;
+
+namespace chants
+{
+    class FrameRenderer : public OutputSink
+    {
+    public:
+        static constexpr size_t kInitialCapacity = 16 * 1024; // a few screens of text
+
+        FrameRenderer(int fd, bool color);
+        ~FrameRenderer() override;
+        FrameRenderer(const FrameRenderer &) = delete;
+        FrameRenderer &operator=(const FrameRenderer &) = delete;
+
+        static bool IsTerminal(int fd);
+        void Write(string_view text) override;
+        void Flush() override;
+        bool UsesColor() const override;
+        size_t Pending() const;
+        uint64_t Frames() const;
+
+    private:
+        int _fd;
+        bool _color;
+        string _frame;
+        uint64_t _frames;
+    };
+}
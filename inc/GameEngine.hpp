@@ -0,0 +1,138 @@
+/**
+ * @file GameEngine.hpp
+ * @brief Declaration of the GameEngine class, the game loop driven one command line at a time.
+ *
+ * The `GameEngine` class plays the game on a map for a player, reading nothing itself: every command line is passed
+ * to `HandleLine` and every bit of text goes to the `OutputSink` it was built with. `Run` feeds it from an
+ * `InputSource` until the game ends or the input runs out, which is all the interactive game does; scripted runs
+ * and servers call `HandleLine` with lines from wherever they come.
+ *
+ * Commands are the same as always: a location id or name to move, `t <asset>` to take, `a <monster>` to attack,
+ * `v` for the inventory and `x` to quit. `travel <location>` follows the shortest route from a `RoutePlanner` to any
+ * reachable location, passing through every location on the way. Attacking asks for a weapon, which is answered by the next line, so the
+ * engine is a small state machine: `Exploring`, `ChoosingWeapon` or `Finished`.
+ *
+ * A game is saved by `Save`, which fills a `GameSnapshot` with the engine's, the map's and the player's state. To
+ * resume it, build the map and the player from the snapshot and call `Restore` on a new engine; the next line is
+ * handled as it would have been had the game never stopped. A game left with `x` is saved as still exploring, so
+ * it can be picked up again.
+ *
+ * Every line is a turn. The engine hands the turn count to the map before running the line, so a map that respawns
+ * monsters brings back the ones due on that turn first; respawns are not recorded, since the turn count replays them.
+ *
+ * With an `EventJournal`, the engine also records every change it makes as it makes it: each step, each asset taken
+ * and each battle. `Apply` makes the same change from a recorded event without running the command or the fight,
+ * which is how a journal is folded into a snapshot. Lines that change nothing, such as viewing the inventory, are
+ * not recorded, and a game recovered from its journal is exploring, even if it stopped while choosing a weapon.
+ *
+ * **Public Types**:
+ * - `GameEngine::State`: What the next line is taken as, or that the game is over.
+ *
+ * **Public Methods**:
+ * - `GameEngine(AdventureGameMap& map, Player& player, OutputSink& out, uint32_t start = 0, const RoutePlanner* planner = nullptr)`: Constructor that places the player at `start`; without a planner, one is made for the map on the first `travel`.
+ * - `void Start()`: Describes the starting location and prompts for the first command.
+ * - `bool HandleLine(const string& line)`: Runs one line of input and flushes its text; returns false once the game is over.
+ * - `uint64_t Run(InputSource& in)`: Starts the game and handles lines until it is over or the input ends; returns the number of lines handled.
+ * - `State GetState() const`: Returns the engine's state.
+ * - `bool HasWon() const`: Checks whether the player defeated every monster.
+ * - `uint32_t GetPosition() const`: Returns the id of the player's location.
+ * - `uint64_t GetTurns() const`: Returns the number of lines handled.
+ * - `void Save(GameSnapshot& snapshot) const`: Records the whole game: the engine's state, the map and the player.
+ * - `void Restore(const GameSnapshot& snapshot)`: Takes up the engine's state from a snapshot the map and player were restored from; throws `std::runtime_error` if it does not fit the map.
+ * - `void SetJournal(EventJournal* journal)`: Records every change from now on in a journal, or stops recording with `nullptr`.
+ * - `void Apply(const GameEvent& event)`: Makes the change a recorded event describes; throws `std::runtime_error` if it does not fit the game.
+ *
+ * **Attributes**:
+ * - `_map`, `_player`, `_out`: The world, the player and where the text goes.
+ * - `_planner`, `_ownPlanner`: The route planner travel uses, and the one made for the map if none was given.
+ * - `_route`: The route being travelled, kept to reuse its memory.
+ * - `_position`: The id of the player's location.
+ * - `_state`: The engine's state.
+ * - `_target`: The symbol of the monster being attacked while choosing a weapon.
+ * - `_won`: Set when the last monster is defeated.
+ * - `_turns`: The number of lines handled.
+ * - `_journal`: Where changes are recorded, or `nullptr`.
+ *
+ * **Private Methods**:
+ * - `void describeLocation()`: Writes the location, its paths, assets and monsters.
+ * - `void prompt()`: Writes the prompt for the current state.
+ * - `void handleCommand(const string& line)`: Runs a command while exploring.
+ * - `void handleWeapon(const string& line)`: Fights the chosen monster with the named weapon.
+ * - `void travel(string_view destination)`: Moves the player along the route to a location.
+ * - `void endTurn()`: Checks for victory and describes the location for the next command.
+ * - `int findLocation(string_view name)`: Resolves a location id or name.
+ * - `void record(GameEvent::Kind kind, uint32_t placement, ...)`: Appends an event at the player's location to the journal, if there is one.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AdventureGameMap.hpp"
+#include "EventJournal.hpp"
+#include "GameSnapshot.hpp"
+#include "GameIO.hpp"
+#include "Player.hpp"
+#include "RoutePlanner.hpp"
+#include "SymbolTable.hpp"
+
+using std::string;
+using std::string_view;
+
+namespace chants
+{
+    class GameEngine
+    {
+    public:
+        enum class State
+        {
+            Exploring,
+            ChoosingWeapon,
+            Finished
+        };
+
+        GameEngine(AdventureGameMap &map, Player &player, OutputSink &out, uint32_t start = 0, const RoutePlanner *planner = nullptr);
+        void Start();
+        bool HandleLine(const string &line);
+        uint64_t Run(InputSource &in);
+        State GetState() const;
+        bool HasWon() const;
+        uint32_t GetPosition() const;
+        uint64_t GetTurns() const;
+        void Save(GameSnapshot &snapshot) const;
+        void Restore(const GameSnapshot &snapshot);
+        void SetJournal(EventJournal *journal);
+        void Apply(const GameEvent &event);
+
+    private:
+        AdventureGameMap &_map;
+        Player &_player;
+        OutputSink &_out;
+        const RoutePlanner *_planner;
+        std::unique_ptr<RoutePlanner> _ownPlanner;
+        std::vector<uint32_t> _route;
+        uint32_t _position;
+        State _state;
+        Symbol _target;
+        bool _won;
+        uint64_t _turns;
+        EventJournal *_journal;
+
+        void describeLocation();
+        void prompt();
+        void handleCommand(const string &line);
+        void handleWeapon(const string &line);
+        void travel(string_view destination);
+        void endTurn();
+        int findLocation(string_view name);
+        void record(GameEvent::Kind kind, uint32_t placement = 0, int32_t outcome = 0, uint64_t playerFightState = 0, uint64_t monsterFightState = 0);
+    };
+}
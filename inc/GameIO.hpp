@@ -0,0 +1,118 @@
+/**
+ * @file GameIO.hpp
+ * @brief Declaration of the input sources and output sinks the game engine reads commands from and writes text to.
+ *
+ * The game never touches `cin` or `cout` directly: it reads command lines from an `InputSource` and writes its text
+ * to an `OutputSink`. The interactive game plugs in the terminal; scripted runs read a command file and discard or
+ * capture the output.
+ *
+ * Text may be held back until `Flush`, which the engine calls once at the end of every turn; sinks that write as
+ * they go ignore it.
+ *
+ * Sinks decide whether text is colored. Code that colors its output asks the sink for the escape codes with
+ * `Color` and `Reset`, which are empty strings for sinks without color, so captured transcripts contain plain text.
+ *
+ * **Public Types**:
+ * - `TextColor`: The ANSI colors the game uses.
+ * - `InputSource`: Interface for anything that yields command lines.
+ * - `OutputSink`: Interface for anything that takes the game's text, with `<<` for strings and numbers.
+ * - `StreamInput`: Reads lines from an `istream` (the terminal or a script file).
+ * - `StreamOutput`: Writes to an `ostream`, optionally colored.
+ * - `NullOutput`: Discards everything.
+ * - `StringOutput`: Captures everything in a string.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+using std::string;
+using std::string_view;
+
+namespace chants
+{
+    enum class TextColor : int
+    {
+        Red = 31,
+        Green = 32,
+        Yellow = 33,
+        Blue = 34,
+        Magenta = 35,
+        Cyan = 36
+    };
+
+    class InputSource
+    {
+    public:
+        virtual ~InputSource() = default;
+        virtual bool ReadLine(string &line) = 0; // false once there is no more input
+    };
+
+    class OutputSink
+    {
+    public:
+        virtual ~OutputSink() = default;
+        virtual void Write(string_view text) = 0;
+        virtual void Flush();
+        virtual bool UsesColor() const;
+        string_view Color(TextColor color) const;
+        string_view Reset() const;
+    };
+
+    OutputSink &operator<<(OutputSink &out, string_view text);
+    OutputSink &operator<<(OutputSink &out, const char *text);
+    OutputSink &operator<<(OutputSink &out, const string &text);
+    OutputSink &operator<<(OutputSink &out, char c);
+    OutputSink &operator<<(OutputSink &out, int64_t value);
+    OutputSink &operator<<(OutputSink &out, int value);
+    OutputSink &operator<<(OutputSink &out, uint32_t value);
+
+    class StreamInput : public InputSource
+    {
+    public:
+        explicit StreamInput(std::istream &in);
+        bool ReadLine(string &line) override;
+
+    private:
+        std::istream &_in;
+    };
+
+    class StreamOutput : public OutputSink
+    {
+    public:
+        StreamOutput(std::ostream &out, bool color);
+        void Write(string_view text) override;
+        void Flush() override;
+        bool UsesColor() const override;
+
+    private:
+        std::ostream &_out;
+        bool _color;
+    };
+
+    class NullOutput : public OutputSink
+    {
+    public:
+        void Write(string_view text) override;
+    };
+
+    class StringOutput : public OutputSink
+    {
+    public:
+        void Write(string_view text) override;
+        const string &Text() const;
+        void Clear();
+
+    private:
+        string _text;
+    };
+}
@@ -0,0 +1,183 @@
+/**
+ * @file GameServer.hpp
+ * @brief Declaration of the GameServer class, hosting many independent games in one process.
+ *
+ * The `GameServer` class listens on a Unix domain socket or a local TCP port and plays one game per connection.
+ * Every session has its own `Player`, its own `AdventureGameMap` (in streaming mode, only the regions around the
+ * player) and its own `GameEngine`; what sessions share is everything read-only: the memory-mapped `WorldFile`,
+ * the `RoutePlanner` and the interned names. A client sends one command per line and receives each turn's text as
+ * it would appear on a terminal, so `nc` or `socat` is enough to play.
+ *
+ * One thread (the one calling `Run`) owns the sockets and waits on them with epoll. Commands are run on a fixed
+ * `ThreadPool`: a session with commands waiting gets a task that runs up to `batchSize` of them and then gives the
+ * thread back, so one busy player cannot hold a thread while others wait. A session is never run by two threads at
+ * once, and different sessions never touch each other's state.
+ *
+ * Every session is accounted for: its map and player (as reported by their `MemoryUsage`), the commands it has
+ * received but not run and the output it has produced but not sent. The server uses the accounts to:
+ * - apply backpressure: past `outputLimit` bytes of unsent output a session's commands stop being run, and past
+ *   `inputLimit` bytes of unrun commands (or the output limit) its socket stops being read, so a client that does
+ *   not read its replies is slowed down by TCP itself rather than growing the server's buffers;
+ * - close a session whose world grows past `sessionMemoryLimit`, and one sending a line longer than `maxLineLength`;
+ * - refuse new connections while `maxSessions` are open or all sessions together hold more than `memoryLimit`.
+ *
+ * A session that has sent nothing for `parkAfter` milliseconds is parked: its game is saved into a `GameSnapshot`
+ * and its map, player and engine are freed, leaving a few hundred bytes. Its next command resumes the game from the
+ * snapshot before running, and the client sees no difference. Parking lets a server hold far more idle players than
+ * it could keep maps for.
+ *
+ * Session `n` (counting connections from 0) plays with the same seeds as game `n` of `ChantsAdventure --script`
+ * with the same `--seed`, so a session's transcript can be checked against the scripted game.
+ *
+ * **Public Types**:
+ * - `GameServerOptions`: Where to listen, how many threads and sessions, and the memory limits.
+ * - `GameServerStats`: Counters of sessions, commands, bytes and memory.
+ *
+ * **Public Methods**:
+ * - `GameServer(const WorldFile& world, const RoutePlanner& planner, const GameServerOptions& options = GameServerOptions())`: Constructor that opens the listening socket; throws `runtime_error` if it cannot.
+ * - `~GameServer()`: Closes every session and the listening socket.
+ * - `uint16_t Port() const`: Returns the TCP port listened on (0 for a Unix domain socket).
+ * - `void Run()`: Serves sessions until `Stop` is called.
+ * - `void Stop()`: Makes `Run` return; safe to call from any thread and from a signal handler.
+ * - `GameServerStats Stats() const`: Returns the server's counters.
+ *
+ * **Attributes**:
+ * - `_world`, `_planner`, `_options`: The world every session plays, the shared route planner and the options.
+ * - `_listener`, `_epoll`, `_wakeup`: The listening socket, the epoll instance and the eventfd that wakes `Run`.
+ * - `_port`: The TCP port listened on.
+ * - `_pool`: The threads commands are run on.
+ * - `_sessions`, `_nextId`: The open sessions by id, and the id of the next one (owned by the thread in `Run`).
+ * - `_readyMutex`, `_ready`: The sessions whose tasks have finished since `Run` last looked.
+ * - `_stop`: Set by `Stop`.
+ * - `_open`, `_accepted`, `_refused`, `_closed`, `_commands`, `_bytesIn`, `_bytesOut`, `_throttled`, `_parked`, `_resumed`, `_memory`: The counters behind `Stats`.
+ *
+ * **Private Methods**:
+ * - `void listenUnix()`, `void listenTcp()`: Open the listening socket.
+ * - `void acceptAll()`: Accepts every waiting connection, refusing those over the limits.
+ * - `void receive(Session& session)`: Reads what a client sent and splits it into commands.
+ * - `void send(Session& session)`: Writes as much pending output as the socket takes.
+ * - `void update(const std::shared_ptr<Session>& session)`: Schedules commands, applies backpressure and the memory limit, and closes finished sessions.
+ * - `void runSession(const std::shared_ptr<Session>& session)`: Runs a batch of a session's commands on a pool thread, or parks it.
+ * - `void startGame(Session& session)`: Creates a session's game, or resumes it from its snapshot if it was parked.
+ * - `void parkGame(Session& session)`: Saves a session's game into a snapshot and frees it.
+ * - `void parkIdle()`: Schedules parking for every session idle for `parkAfter`.
+ * - `void close(Session& session)`: Closes a session's socket and forgets it.
+ * - `void watch(Session& session)`: Tells epoll which events the session waits for.
+ * - `void wake()`: Wakes the thread in `Run`.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "RoutePlanner.hpp"
+#include "ThreadPool.hpp"
+#include "WorldFile.hpp"
+
+using std::string;
+
+namespace chants
+{
+    struct GameServerOptions
+    {
+        string unixPath;                          // listen on this Unix domain socket if set,
+        string host = "127.0.0.1";                // otherwise on this local address
+        uint16_t port = 0;                        // and port (0 picks a free one, see Port)
+        unsigned threads = 0;                     // threads to run commands on, 0 for one per hardware thread
+        uint32_t maxSessions = 4096;
+        bool streaming = false;                   // keep only the regions around each player in memory
+        bool color = false;                       // send ANSI colors
+        uint64_t seed = 0;
+        uint32_t respawnDelay = 0;                // turns before a defeated monster respawns, 0 for never
+        bool monsterAI = false;                   // move every session's monsters each turn, on the session's thread
+        size_t sessionMemoryLimit = 64u << 20;    // a session whose world and player hold more is closed
+        size_t memoryLimit = 0;                   // refuse connections while all sessions hold more, 0 for no limit
+        size_t outputLimit = 256u << 10;          // unsent output at which a session's commands wait
+        size_t inputLimit = 64u << 10;            // unrun commands at which a session's socket is not read
+        size_t maxLineLength = 4096;              // a longer command closes the session
+        uint32_t batchSize = 32;                  // commands run before a session gives its thread back
+        uint32_t parkAfter = 0;                   // milliseconds idle before a session's game is saved and freed, 0 never
+    };
+
+    struct GameServerStats
+    {
+        uint64_t accepted = 0;  // connections that became sessions
+        uint64_t refused = 0;   // connections turned away by the limits
+        uint64_t closed = 0;    // sessions ended
+        uint64_t commands = 0;  // commands run
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+        uint64_t throttled = 0; // times a socket stopped being read for backpressure
+        uint64_t parked = 0;    // games saved and freed while idle
+        uint64_t resumed = 0;   // parked games brought back by a command
+        uint32_t sessions = 0;  // sessions open
+        size_t memory = 0;      // bytes held by the open sessions
+    };
+
+    class GameServer
+    {
+    public:
+        GameServer(const WorldFile &world, const RoutePlanner &planner, const GameServerOptions &options = GameServerOptions());
+        ~GameServer();
+        GameServer(const GameServer &) = delete;
+        GameServer &operator=(const GameServer &) = delete;
+
+        uint16_t Port() const;
+        void Run();
+        void Stop();
+        GameServerStats Stats() const;
+
+    private:
+        struct Session;
+
+        const WorldFile &_world;
+        const RoutePlanner &_planner;
+        GameServerOptions _options;
+        int _listener;
+        int _epoll;
+        int _wakeup;
+        uint16_t _port;
+        ThreadPool _pool;
+        std::unordered_map<uint64_t, std::shared_ptr<Session>> _sessions;
+        uint64_t _nextId;
+        std::mutex _readyMutex;
+        std::vector<uint64_t> _ready;
+        std::atomic<bool> _stop;
+        std::atomic<uint32_t> _open;
+        std::atomic<uint64_t> _accepted;
+        std::atomic<uint64_t> _refused;
+        std::atomic<uint64_t> _closed;
+        std::atomic<uint64_t> _commands;
+        std::atomic<uint64_t> _bytesIn;
+        std::atomic<uint64_t> _bytesOut;
+        std::atomic<uint64_t> _throttled;
+        std::atomic<uint64_t> _parked;
+        std::atomic<uint64_t> _resumed;
+        std::atomic<size_t> _memory;
+
+        void listenUnix();
+        void listenTcp();
+        void acceptAll();
+        void receive(Session &session);
+        void send(Session &session);
+        void update(const std::shared_ptr<Session> &session);
+        void runSession(const std::shared_ptr<Session> &session);
+        void startGame(Session &session);
+        void parkGame(Session &session);
+        void parkIdle();
+        void close(Session &session);
+        void watch(Session &session);
+        void wake();
+    };
+}
@@ -0,0 +1,136 @@
+/**
+ * @file GameSnapshot.hpp
+ * @brief Declaration of the GameSnapshot struct, a saved game in a compact, versioned binary form.
+ *
+ * A `GameSnapshot` holds everything a game has changed since it started, and nothing it can recompute. The world
+ * itself stays in its `WorldFile`, and the objects a map starts with follow from the world file and the map's seed,
+ * so a snapshot records the seed and only the placed objects that differ from that start: taken or defeated
+ * (`kGone`), moved, or monsters whose fights have used up some of their random numbers. Objects are referred to by
+ * the index of their placement in the world file, never by pointer. Taking an object reorders the others at its
+ * location, so every object left at a location where anything changed is recorded, in the order the location lists
+ * them; a map restored from the snapshot adds them in that order after the unchanged ones. Defeated monsters waiting
+ * to respawn are gone, and listed again with the turn they come back on. The player's inventory
+ * is the placements of the assets they hold, the engine's position is a location id and a pending attack is the
+ * target's name.
+ *
+ * A game that has taken a few objects and fought a few monsters saves to a few hundred bytes whatever the size of
+ * its world. The encoded form is a fixed header followed by the record arrays as they are laid out in memory, so
+ * encoding and decoding are a handful of copies; restoring a map from a snapshot costs about as much as building it.
+ * Snapshots do not depend on how the map is held: a game saved from a streaming map can be restored into a full
+ * one and back.
+ *
+ * **Encoded Layout** (little-endian, every section 8-byte aligned):
+ * - `Header`: magic, format version, the size of the world it was saved in, and the engine, player and map fields.
+ * - `inventoryCount` `HeldAsset` records, then `changeCount` `ObjectChange` records, each placement at most once.
+ * - `respawnCount` `Respawn` records in the order they are due, each placement at most once.
+ * - The name of the monster being attacked, `targetLength` bytes.
+ *
+ * **Public Methods**:
+ * - `void Check(const WorldFile& world) const`: Throws `std::runtime_error` unless the snapshot was saved in a world of the same shape.
+ * - `void Encode(string& out) const`: Replaces `out` with the encoded snapshot.
+ * - `static GameSnapshot Decode(string_view data)`: Decodes a snapshot; throws `std::runtime_error` if it is not a valid one.
+ * - `void WriteFile(const string& path) const`: Writes the encoded snapshot to a file.
+ * - `static GameSnapshot ReadFile(const string& path)`: Reads and decodes a snapshot file.
+ * - `static void Compare(const vector<ObjectChange>& left, const vector<ObjectChange>& start, vector<ObjectChange>& changes)`: Adds to `changes` what differs between the objects left (in the order their locations list them) and where the placements of `start` (in placement order) started.
+ *
+ * **Attributes**:
+ * - `nodeCount`, `placementCount`: The shape of the world the game was saved in.
+ * - `seed`: The seed the map was built with.
+ * - `position`, `state`, `won`, `turns`, `target`: The engine's state (see `GameEngine`).
+ * - `health`, `fightState`, `inventory`: The player's state.
+ * - `changes`: The placed objects that differ from the start of the game.
+ * - `respawnDelay`, `respawns`: The turns a defeated monster takes to respawn (0 for never), and the monsters waiting to.
+ * - `monsterAI`: Whether the monsters move (see `MonsterAI`); where they have moved to is in `changes`.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "WorldFile.hpp"
+
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace chants
+{
+    struct GameSnapshot
+    {
+        static constexpr char kMagic[4] = {'C', 'H', 'S', 'V'};
+        static constexpr uint32_t kVersion = 2;
+        static constexpr uint32_t kGone = UINT32_MAX; // an object taken or defeated
+
+        // encoded records
+        struct Header
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t nodeCount;
+            uint32_t placementCount;
+            uint64_t seed;
+            uint32_t position;
+            uint32_t state;
+            uint64_t turns;
+            uint64_t fightState;
+            int32_t health;
+            uint32_t won;
+            uint32_t inventoryCount;
+            uint32_t changeCount;
+            uint32_t targetLength;
+            uint32_t respawnCount;
+            uint32_t respawnDelay;
+            uint32_t monsterAI; // 0 in games saved before monsters could move
+        };
+
+        struct HeldAsset
+        {
+            uint32_t placement;
+            uint32_t used;
+        };
+
+        struct ObjectChange
+        {
+            uint32_t placement;
+            uint32_t node;       // where the object is now, or kGone
+            uint64_t fightState; // a monster's random engine, 0 for an asset
+        };
+
+        struct Respawn
+        {
+            uint32_t placement; // a defeated monster
+            uint32_t reserved;
+            uint64_t due;       // the turn it comes back on
+        };
+
+        uint32_t nodeCount = 0;
+        uint32_t placementCount = 0;
+        uint64_t seed = 0;
+        uint32_t position = 0;
+        uint32_t state = 0;
+        bool won = false;
+        uint64_t turns = 0;
+        string target;
+        int32_t health = 0;
+        uint64_t fightState = 0;
+        vector<HeldAsset> inventory;
+        vector<ObjectChange> changes;
+        uint32_t respawnDelay = 0;
+        vector<Respawn> respawns;
+        bool monsterAI = false;
+
+        void Check(const WorldFile &world) const;
+        void Encode(string &out) const;
+        static GameSnapshot Decode(string_view data);
+        void WriteFile(const string &path) const;
+        static GameSnapshot ReadFile(const string &path);
+        static void Compare(const vector<ObjectChange> &left, const vector<ObjectChange> &start, vector<ObjectChange> &changes);
+    };
+}
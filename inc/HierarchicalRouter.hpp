@@ -0,0 +1,107 @@
+/**
+ * @file HierarchicalRouter.hpp
+ * @brief Declaration of the HierarchicalRouter class, finding routes across huge worlds through their regions.
+ *
+ * The `HierarchicalRouter` class routes over a `WorldGraph` using its `RegionPartition` as clusters, so a query on a
+ * world of millions of locations only looks at a few hundred of them. It keeps, once per world:
+ * - the border locations of every region (those with a path into or out of another region),
+ * - a cluster graph over the border locations: every path between two regions, and for every pair of border
+ *   locations of one region, the length of the shortest route between them inside the region.
+ *
+ * A query searches outwards from the start inside its own region and backwards from the destination inside its own,
+ * searches the region graph for the fewest regions in between (the corridor), and runs Dijkstra over the cluster graph
+ * restricted to the corridor's border locations. Each step of the result is then expanded into locations: a path
+ * between regions is taken as is, a step inside a region by a search of that region alone. If the corridor holds no
+ * route (possible with one-way paths, or regions split into pockets), it is widened by the regions next to it, up to
+ * `kWidenings` times, and then the search is repeated over every region.
+ *
+ * Routes are shortest through the corridor and in practice within a few steps of the true shortest, which is what
+ * makes them cheap; worlds small enough for a full `RoutePlanner` table get exact routes from that instead. Building
+ * the cluster graph searches every region from each of its border locations, split over a `ThreadPool`. Queries
+ * keep their working memory per thread and may come from several threads at once.
+ *
+ * **Public Types**:
+ * - `RouteStats`: How many locations and border locations a query looked at.
+ *
+ * **Public Methods**:
+ * - `HierarchicalRouter(const WorldGraph& graph, RegionPartition regions, unsigned threads = 0)`: Constructor that builds the cluster graph on `threads` threads (0 for one per hardware thread).
+ * - `bool Route(uint32_t from, uint32_t to, vector<uint32_t>& route, RouteStats* stats = nullptr) const`: Fills `route` with the locations visited after `from`, ending with `to`; returns false if there is no route.
+ * - `uint32_t BorderCount() const`: Returns the number of border locations.
+ * - `uint64_t ClusterEdgeCount() const`: Returns the number of edges in the cluster graph.
+ * - `const RegionPartition& Regions() const`: Returns the regions routed through.
+ *
+ * **Attributes**:
+ * - `_graph`, `_regions`: The paths and their regions.
+ * - `_reverseOffsets`, `_reverseSources`: The paths reversed, for searching backwards from a destination.
+ * - `_borderOf`, `_borders`: The border index of every location (`kNone` inside a region) and the location of every border index.
+ * - `_edgeOffsets`, `_edgeTargets`, `_edgeCosts`: The cluster graph in CSR form, by border index.
+ * - `_linkOffsets`, `_links`: The regions next to every region, along or against the paths, for widening the corridor.
+ *
+ * **Private Methods**:
+ * - `void searchRegion(uint32_t start, bool backwards, uint32_t stopAt, Scratch& scratch, RouteStats& stats) const`: Breadth-first search confined to the region of `start`, along or against the paths.
+ * - `bool searchClusters(...) const`: Dijkstra over the cluster graph from the start's borders to the destination's, optionally confined to a corridor of regions.
+ * - `bool findCorridor(uint32_t fromRegion, uint32_t toRegion, Scratch& search, Scratch& corridor) const`: Marks the regions of a shortest route through the region graph.
+ * - `void widen(Scratch& corridor) const`: Adds the regions next to the corridor to it.
+ * - `bool walkRegion(uint32_t from, uint32_t to, Scratch& scratch, vector<uint32_t>& route, RouteStats& stats) const`: Appends a shortest route between two locations of one region.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "RegionPartition.hpp"
+#include "WorldGraph.hpp"
+
+using std::vector;
+
+namespace chants
+{
+    struct RouteStats
+    {
+        uint32_t locationsVisited = 0; // reached by the searches inside single regions
+        uint32_t bordersSettled = 0;   // settled by the cluster graph search
+        unsigned widenings = 0;        // times the corridor held no route; past kWidenings, every region was searched
+    };
+
+    class HierarchicalRouter
+    {
+    public:
+        static constexpr uint32_t kNone = UINT32_MAX;
+        static constexpr unsigned kWidenings = 2;
+
+        HierarchicalRouter(const WorldGraph &graph, RegionPartition regions, unsigned threads = 0);
+        HierarchicalRouter(const HierarchicalRouter &) = delete;
+        HierarchicalRouter &operator=(const HierarchicalRouter &) = delete;
+
+        bool Route(uint32_t from, uint32_t to, vector<uint32_t> &route, RouteStats *stats = nullptr) const;
+        uint32_t BorderCount() const;
+        uint64_t ClusterEdgeCount() const;
+        const RegionPartition &Regions() const;
+
+    private:
+        struct Scratch;
+
+        WorldGraph _graph;
+        RegionPartition _regions;
+        vector<uint32_t> _reverseOffsets;
+        vector<uint32_t> _reverseSources;
+        vector<uint32_t> _borderOf;
+        vector<uint32_t> _borders;
+        vector<uint64_t> _edgeOffsets;
+        vector<uint32_t> _edgeTargets;
+        vector<uint32_t> _edgeCosts;
+        vector<uint32_t> _linkOffsets;
+        vector<uint32_t> _links;
+
+        void searchRegion(uint32_t start, bool backwards, uint32_t stopAt, Scratch &scratch, RouteStats &stats) const;
+        bool searchClusters(const Scratch &start, const Scratch &goal, const Scratch *corridor, Scratch &clusters, uint32_t &last, RouteStats &stats) const;
+        bool findCorridor(uint32_t fromRegion, uint32_t toRegion, Scratch &search, Scratch &corridor) const;
+        void widen(Scratch &corridor) const;
+        bool walkRegion(uint32_t from, uint32_t to, Scratch &scratch, vector<uint32_t> &route, RouteStats &stats) const;
+    };
+}
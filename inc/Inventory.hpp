@@ -0,0 +1,95 @@
+/**
+ * @file Inventory.hpp
+ * @brief Declaration of the Inventory class, the player's assets stacked by name and indexed by name and category.
+ *
+ * Assets with the same name share a stack: picking up a second Meat adds a copy to the Meat stack rather than a
+ * second entry, or nothing at all as it used to. New stacks go at the end, and the inventory is shown in the order
+ * of `Stacks()`. A hash index from the symbol of a name to its stack makes adding, finding and removing by name
+ * constant time however many assets are held, and each `AssetCategory` keeps the list of its stacks, so listing the
+ * weapons walks the weapons only.
+ *
+ * Removing a stack's last copy moves the last stack into the freed position, and the last entry of its category list
+ * into its entry there, so giving up an asset entirely is constant time too. Collection order is therefore kept only
+ * until a stack is removed: after that the moved stack is shown where the removed one was.
+ *
+ * A stack keeps its first copy whole and only the world file placements of the others, which is all a saved game
+ * needs of them; a stack is used or unused as a whole.
+ *
+ * **Public Types**:
+ * - `Stack`: An asset and the placements of its further copies.
+ *
+ * **Public Methods**:
+ * - `uint32_t Add(const Asset& asset)`: Adds a copy of an asset to its stack, starting one if needed; returns the copies the stack then holds.
+ * - `bool Remove(Symbol name)`: Removes one copy of the named asset, and its stack with the last copy; returns false if none is held.
+ * - `Asset* Find(Symbol name)` / `const Asset* Find(Symbol name) const`: Returns the first copy of the named asset, or `nullptr`.
+ * - `uint32_t Count(Symbol name) const`: Returns the copies held of the named asset.
+ * - `const vector<Stack>& Stacks() const`: Returns the stacks, in the order they were started but for the moves of removals.
+ * - `const vector<uint32_t>& InCategory(AssetCategory category) const`: Returns the positions in `Stacks()` of the stacks in a category, in the order they were added to it but for the moves of removals.
+ * - `size_t Size() const`: Returns the number of stacks.
+ * - `size_t ItemCount() const`: Returns the number of copies in all stacks.
+ * - `bool Empty() const`: Returns whether nothing is held.
+ * - `void Clear()`: Removes everything.
+ * - `size_t MemoryUsage() const`: Returns an estimate of the bytes held by the stacks and indexes.
+ *
+ * **Attributes**:
+ * - `_stacks`: The stacks, each new one appended and the last one moved into the position of a removed one.
+ * - `_index`: The position of each stack in `_stacks`, by the symbol of its name.
+ * - `_categories`: The positions of the stacks in each category.
+ * - `_categorySlots`: The position of each stack in its category's list, by its position in `_stacks`.
+ * - `_items`: The number of copies in all stacks.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Asset.hpp"
+#include "SymbolTable.hpp"
+
+using std::vector;
+
+namespace chants
+{
+    class Inventory
+    {
+    public:
+        struct Stack
+        {
+            Asset asset;             // the first copy collected
+            vector<uint32_t> copies; // the placements of the others, in the order collected
+
+            uint32_t Count() const
+            {
+                return 1 + static_cast<uint32_t>(copies.size());
+            }
+        };
+
+        uint32_t Add(const Asset &asset);
+        bool Remove(Symbol name);
+        Asset *Find(Symbol name);
+        const Asset *Find(Symbol name) const;
+        uint32_t Count(Symbol name) const;
+        const vector<Stack> &Stacks() const;
+        const vector<uint32_t> &InCategory(AssetCategory category) const;
+        size_t Size() const;
+        size_t ItemCount() const;
+        bool Empty() const;
+        void Clear();
+        size_t MemoryUsage() const;
+
+    private:
+        vector<Stack> _stacks;
+        std::unordered_map<Symbol, uint32_t> _index;
+        std::array<vector<uint32_t>, kAssetCategoryCount> _categories;
+        vector<uint32_t> _categorySlots;
+        size_t _items = 0;
+    };
+}
@@ -0,0 +1,163 @@
+/**
+ * @file Metrics.hpp
+ * @brief Declaration of the game's metrics: counters and latency histograms kept per thread and exported on demand.
+ *
+ * The game loop is timed at a handful of points: every command, by kind, every battle, every frame handed to the
+ * output and every wait for a line of input. Each time is recorded into a `LatencyHistogram`, an HDR-style histogram
+ * whose buckets are 1/32 of a power of two wide, so any percentile is known to within about 3% at every scale from
+ * nanoseconds to a minute, in a fixed 8 KiB. Counters count the turns and the battles by outcome.
+ *
+ * Every thread records into a shard of its own, made the first time it records anything, so recording is a clock
+ * read and a few plain stores, with no lock and no shared cache line. `Metrics::Snapshot` adds up every shard; a
+ * shard outlives its thread, so nothing recorded is lost. `Metrics::WritePrometheus` renders a snapshot in the
+ * Prometheus text format, which `MetricsExporter` serves on a local socket and `Metrics::WriteFile` dumps to a file.
+ *
+ * The game is instrumented through `CHANTS_METRIC_TIME` and `CHANTS_METRIC_COUNT`, which do something only when the
+ * build defines `CHANTS_METRICS` (`-DCHANTS_METRICS=ON`); otherwise they expand to nothing, their arguments are not
+ * evaluated and the game is the same code as without them. `Metrics::Enabled` tells which build this is.
+ *
+ * **Public Types**:
+ * - `Metric`: What a latency is recorded for.
+ * - `MetricCounter`: What a counter counts.
+ * - `LatencyHistogram`: A histogram of latencies in nanoseconds that can be added to others.
+ * - `MetricsSnapshot`: Every histogram and counter, added up over all threads.
+ * - `MetricTimer`: Records the time from its construction to its destruction.
+ *
+ * **Public Methods** (`LatencyHistogram`):
+ * - `static uint32_t BucketOf(uint64_t nanoseconds)`, `static uint64_t BucketLimit(uint32_t bucket)`: Map a latency to its bucket, and a bucket to the longest latency it holds.
+ * - `void Record(uint64_t nanoseconds)`, `void Add(const LatencyHistogram& other)`: Add one latency, or every latency of another histogram.
+ * - `uint64_t CountAtMost(uint64_t nanoseconds) const`: Returns the number of latencies in buckets that end at or below a bound.
+ * - `uint64_t Percentile(double fraction) const`: Returns the end of the bucket holding the given fraction of latencies, capped at the longest.
+ *
+ * **Public Methods** (`Metrics`, all static):
+ * - `static constexpr bool Enabled()`: Returns whether the build records metrics.
+ * - `static void Record(Metric metric, uint64_t nanoseconds)`: Records a latency in the calling thread's shard.
+ * - `static void Add(MetricCounter counter, uint64_t count)`: Adds to a counter in the calling thread's shard.
+ * - `static MetricsSnapshot Snapshot()`: Adds up every shard.
+ * - `static void WritePrometheus(const MetricsSnapshot& snapshot, string& text)`: Appends a snapshot in the Prometheus text format.
+ * - `static void WriteFile(const string& path)`: Writes a snapshot to a file in the Prometheus text format; throws `std::runtime_error` if it cannot.
+ * - `static const char* Name(Metric metric)`, `static const char* Name(MetricCounter counter)`: Return the label or name a metric is exported under.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+namespace chants
+{
+    enum class Metric : uint32_t
+    {
+        Move,      // a line naming a path, or nothing the game knows
+        Take,      // t <asset>
+        Attack,    // a <monster>, and the weapon line that settles it
+        Inventory, // v
+        Travel,    // travel <location>
+        Battle,    // the fight itself, within Attack
+        Render,    // handing a turn's frame to the output
+        InputWait, // waiting for the next line
+        Count
+    };
+
+    enum class MetricCounter : uint32_t
+    {
+        Turns,
+        BattlesWon,
+        BattlesLost,
+        BattlesDrawn,
+        Count
+    };
+
+    constexpr size_t kMetricCount = static_cast<size_t>(Metric::Count);
+    constexpr size_t kMetricCounterCount = static_cast<size_t>(MetricCounter::Count);
+
+    struct LatencyHistogram
+    {
+        static constexpr uint32_t kSubBucketBits = 5;
+        static constexpr uint32_t kSubBuckets = 1u << kSubBucketBits;
+        static constexpr uint32_t kMaxBits = 36; // 2^36 ns is about 69 s; longer latencies land in the last bucket
+        static constexpr uint32_t kBuckets = (kMaxBits - kSubBucketBits + 1) * kSubBuckets;
+
+        static uint32_t BucketOf(uint64_t nanoseconds);
+        static uint64_t BucketLimit(uint32_t bucket);
+
+        void Record(uint64_t nanoseconds);
+        void Add(const LatencyHistogram &other);
+        uint64_t CountAtMost(uint64_t nanoseconds) const;
+        uint64_t Percentile(double fraction) const;
+
+        std::array<uint64_t, kBuckets> buckets{};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+    };
+
+    struct MetricsSnapshot
+    {
+        vector<LatencyHistogram> latencies = vector<LatencyHistogram>(kMetricCount);
+        std::array<uint64_t, kMetricCounterCount> counters{};
+        size_t threads = 0; // shards added up
+    };
+
+    class Metrics
+    {
+    public:
+        static constexpr bool Enabled()
+        {
+#ifdef CHANTS_METRICS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        static void Record(Metric metric, uint64_t nanoseconds);
+        static void Add(MetricCounter counter, uint64_t count);
+        static MetricsSnapshot Snapshot();
+        static void WritePrometheus(const MetricsSnapshot &snapshot, string &text);
+        static void WriteFile(const string &path);
+        static const char *Name(Metric metric);
+        static const char *Name(MetricCounter counter);
+    };
+
+    class MetricTimer
+    {
+    public:
+        explicit MetricTimer(Metric metric) : _metric(metric), _start(std::chrono::steady_clock::now()) {}
+        ~MetricTimer()
+        {
+            auto elapsed = std::chrono::steady_clock::now() - _start;
+            Metrics::Record(_metric, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+        MetricTimer(const MetricTimer &) = delete;
+        MetricTimer &operator=(const MetricTimer &) = delete;
+
+    private:
+        Metric _metric;
+        std::chrono::steady_clock::time_point _start;
+    };
+}
+
+#define CHANTS_METRIC_JOIN2(a, b) a##b
+#define CHANTS_METRIC_JOIN(a, b) CHANTS_METRIC_JOIN2(a, b)
+
+#ifdef CHANTS_METRICS
+// times the rest of the enclosing scope
+#define CHANTS_METRIC_TIME(metric) ::chants::MetricTimer CHANTS_METRIC_JOIN(chantsMetricTimer, __LINE__)(metric)
+#define CHANTS_METRIC_COUNT(counter, count) ::chants::Metrics::Add(counter, count)
+#else
+#define CHANTS_METRIC_TIME(metric) static_cast<void>(0)
+#define CHANTS_METRIC_COUNT(counter, count) static_cast<void>(0)
+#endif
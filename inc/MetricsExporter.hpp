@@ -0,0 +1,74 @@
+/**
+ * @file MetricsExporter.hpp
+ * @brief Declaration of the MetricsExporter class, serving the game's metrics on a local socket.
+ *
+ * A `MetricsExporter` listens on a Unix domain socket or a local TCP port on a thread of its own, and answers every
+ * connection with a fresh `Metrics::Snapshot` in the Prometheus text format, then closes it. A request that starts
+ * with `GET` gets an HTTP response, so Prometheus can scrape the port directly; a client that sends nothing, such as
+ * `nc`, gets the bare text after a short wait. Connections are answered one at a time; an answer takes a snapshot
+ * and one write, so the game is never held up by a slow reader for longer than the registry's lock.
+ *
+ * **Public Types**:
+ * - `MetricsExporterOptions`: Where to listen.
+ *
+ * **Public Methods**:
+ * - `MetricsExporter(const MetricsExporterOptions& options)`: Constructor that opens the socket and starts serving; throws `std::runtime_error` if it cannot listen.
+ * - `~MetricsExporter()`: Stops serving and closes the socket.
+ * - `uint16_t Port() const`: Returns the TCP port listened on, useful when port 0 picked a free one.
+ *
+ * **Attributes**:
+ * - `_options`: Where to listen.
+ * - `_listener`, `_wakeup`: The listening socket, and the eventfd that wakes the thread to stop.
+ * - `_port`: The TCP port listened on.
+ * - `_thread`: The thread answering connections.
+ *
+ * **Private Methods**:
+ * - `void serve()`: The thread's loop, waiting on both descriptors.
+ * - `void answer(int fd)`: Reads what the client sent, if anything, and writes the metrics.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+using std::string;
+
+namespace chants
+{
+    struct MetricsExporterOptions
+    {
+        string unixPath;           // listen on this Unix domain socket if set,
+        string host = "127.0.0.1"; // otherwise on this local address
+        uint16_t port = 0;         // and port (0 picks a free one, see Port)
+    };
+
+    class MetricsExporter
+    {
+    public:
+        static constexpr int kRequestWait = 100; // milliseconds to wait for a request before answering in bare text
+
+        explicit MetricsExporter(const MetricsExporterOptions &options);
+        ~MetricsExporter();
+        MetricsExporter(const MetricsExporter &) = delete;
+        MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+        uint16_t Port() const;
+
+    private:
+        MetricsExporterOptions _options;
+        int _listener;
+        int _wakeup;
+        uint16_t _port;
+        std::thread _thread;
+
+        void serve();
+        void answer(int fd);
+    };
+}
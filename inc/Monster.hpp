@@ -6,10 +6,13 @@
  * It initializes the monster with its name, health, and fight coefficient, inheriting the ability to fight from the `Combatant` class.
  *
  * **Public Methods**:
- * - `Monster(string name, int health, int fightCoefficient)`: Constructor to initialize the monster with a name, health, and fight coefficient.
+ * - `Monster(string_view name, int health, int fightCoefficient)`: Constructor to initialize the monster with a name, health, and fight coefficient.
+ * - `uint32_t GetPlacement() const`: Returns the index of the world file placement the monster was created for, or `kNoPlacement`.
+ * - `void SetPlacement(uint32_t placement)`: Records the placement the monster was created for, so saved games can refer to it.
  *
  * **Attributes**:
  * - Inherits attributes from `Combatant`: `_name`, `_health`, `_fightCoefficient`.
+ * - `_placement`: The world file placement the monster was created for.
  *
  * @author Evan Aarons Wood
  * @version 1.0
@@ -19,7 +22,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <Combatant.hpp>
 
 using namespace std;
@@ -29,6 +34,13 @@ namespace chants
     class Monster : public Combatant
     {
     public:
-        Monster(string name, int health, int fightCoefficient);
+        static constexpr uint32_t kNoPlacement = UINT32_MAX;
+
+        Monster(string_view name, int health, int fightCoefficient);
+        uint32_t GetPlacement() const;
+        void SetPlacement(uint32_t placement);
+
+    private:
+        uint32_t _placement;
     };
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+/**
+ * @file MonsterAI.hpp
+ * @brief Declaration of the MonsterAI class, which moves a map's monsters once per turn.
+ *
+ * With monster AI on, every monster placed by the world file acts at the start of every turn. What it does depends on
+ * its behavior, fixed for each placement by the map's seed:
+ * - A roamer wanders to a neighbouring location every other turn or so.
+ * - A hunter closes in on the player, one step a turn, once the player is within `kHuntRange` paths of it, and
+ *   roams otherwise.
+ * - A guard keeps to the location it was placed at, stepping out to a neighbour now and then and straight back.
+ * A monster at the player's location stays put, so whatever the player sees there can still be fought. No monster
+ * enters a location that held `kCapacity` monsters at the start of the turn.
+ *
+ * A tick is worked out region by region (see `RegionPartition`) and, for a world of at least `kParallelRegions`
+ * regions and a pool to run on, in parallel with `ThreadPool::ParallelForStealing`. The locations as they stood at
+ * the start of the tick are the front buffer: every monster decides from them alone, so no monster sees another's
+ * move of the same tick. Moves are claimed into a back buffer, one claim per target location, and where several
+ * monsters want the same location the one with the lowest placement gets it, whatever order the claims came in.
+ * Once every region is done the winning moves are applied in region order. The random numbers of a decision are a
+ * hash of the seed, the turn and the placement, so a tick comes out the same on any number of threads, and a
+ * replayed or restored game moves its monsters exactly as the original did.
+ *
+ * **Public Types**:
+ * - `MonsterBehavior`: What a monster does with its turn.
+ *
+ * **Public Methods**:
+ * - `MonsterAI(AdventureGameMap& map, const WorldFile& world, uint64_t seed, uint64_t turn)`: Constructor for the AI of a map held whole, whose last turn was `turn`.
+ * - `void SetPool(ThreadPool* pool)`: Sets the pool large worlds tick on, or `nullptr` to tick on the calling thread.
+ * - `void Advance(uint64_t turn)`: Runs a tick for every turn after the last one up to `turn`.
+ * - `uint64_t GetTurn() const`: Returns the last turn ticked.
+ * - `uint64_t GetMoves() const`: Returns the number of moves made so far.
+ * - `MonsterBehavior BehaviorOf(uint32_t placement) const`: Returns the behavior of a placed monster.
+ * - `size_t MemoryUsage() const`: Returns the bytes held by the buffers and the turned-around graph.
+ *
+ * **Private Methods**:
+ * - `void tick(uint64_t turn)`: Moves every monster once.
+ * - `void measureHunt(uint32_t focus)`: Finds how far every location within `kHuntRange` paths is from the player, following one-way paths the way they lead.
+ * - `void proposeMoves(uint32_t region, uint64_t turnSeed, uint32_t focus)`: Decides the moves of the monsters in a region and claims their targets.
+ * - `uint32_t pickNeighbor(uint32_t node, uint64_t roll) const`: Returns a random neighbour of a location, or the location itself if it has none.
+ *
+ * **Attributes**:
+ * - `_map`: The map whose monsters move.
+ * - `_regions`: The world file's partition, which a tick is split by.
+ * - `_seed`: The map's seed, mixed into a stream of its own.
+ * - `_turn`: The last turn ticked.
+ * - `_moves`: The moves made so far.
+ * - `_pool`: The pool large worlds tick on, if any.
+ * - `_incoming`: The map's graph turned around, listing for each location the locations with a path to it.
+ * - `_distance`, `_reached`: How far each location is from the player, and the locations measured this tick, to forget afterwards.
+ * - `_claims`: The back buffer: the lowest placement wanting to enter each location this tick.
+ * - `_proposals`: The moves each region wants to make this tick.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "RegionPartition.hpp"
+#include "ThreadPool.hpp"
+#include "WorldFile.hpp"
+#include "WorldGraph.hpp"
+
+using std::vector;
+
+namespace chants
+{
+    class AdventureGameMap;
+    class Monster;
+
+    enum class MonsterBehavior : uint8_t
+    {
+        Roam,
+        Hunt,
+        Guard
+    };
+
+    class MonsterAI
+    {
+    public:
+        static constexpr uint32_t kHuntRange = 4;         // paths within which a hunter picks up the player's trail
+        static constexpr uint32_t kCapacity = 3;          // monsters a location can hold before others stop entering
+        static constexpr uint32_t kParallelRegions = 16;  // fewer regions than this tick on the calling thread
+
+        MonsterAI(AdventureGameMap &map, const WorldFile &world, uint64_t seed, uint64_t turn);
+        void SetPool(ThreadPool *pool);
+        void Advance(uint64_t turn);
+        uint64_t GetTurn() const;
+        uint64_t GetMoves() const;
+        MonsterBehavior BehaviorOf(uint32_t placement) const;
+        size_t MemoryUsage() const;
+
+    private:
+        struct Move
+        {
+            Monster *monster;
+            uint32_t placement;
+            uint32_t from;
+            uint32_t to;
+        };
+
+        AdventureGameMap &_map;
+        RegionPartition _regions;
+        uint64_t _seed;
+        uint64_t _turn;
+        uint64_t _moves = 0;
+        ThreadPool *_pool = nullptr;
+        WorldGraph _incoming;
+        vector<uint32_t> _distance;
+        vector<uint32_t> _reached;
+        std::unique_ptr<std::atomic<uint32_t>[]> _claims;
+        vector<vector<Move>> _proposals;
+
+        void tick(uint64_t turn);
+        void measureHunt(uint32_t focus);
+        void proposeMoves(uint32_t region, uint64_t turnSeed, uint32_t focus);
+        uint32_t pickNeighbor(uint32_t node, uint64_t roll) const;
+    };
+}
@@ -0,0 +1,50 @@
+/**
+ * @file MonsterPool.hpp
+ * @brief Declaration of the MonsterPool class, which recycles the monsters of a map or region.
+ *
+ * A `MonsterPool` creates monsters in an `ObjectArena` and takes them back when they are defeated, so a world whose
+ * monsters respawn reuses the same few objects for as long as it runs instead of growing its arena with every
+ * respawn. A released monster is kept on a free list and built again in place by the next `Acquire`; monsters are
+ * trivially destructible, so nothing runs on release. Pointers to a released monster must not be used again.
+ *
+ * **Public Methods**:
+ * - `MonsterPool(ObjectArena& arena)`: Constructor for a pool that creates its monsters in `arena`, which must outlive it.
+ * - `Monster *Acquire(string_view name, int health, int fightCoefficient)`: Builds a monster in a released one's place, or in the arena if none is free.
+ * - `void Release(Monster* monster)`: Takes back a monster acquired from the pool.
+ * - `size_t FreeCount() const`: Returns the number of released monsters waiting to be reused.
+ * - `size_t MemoryUsage() const`: Returns the bytes held by the free list; the monsters belong to the arena.
+ *
+ * **Attributes**:
+ * - `_arena`: Where new monsters are created.
+ * - `_free`: The released monsters.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "Monster.hpp"
+#include "ObjectArena.hpp"
+
+namespace chants
+{
+    class MonsterPool
+    {
+    public:
+        explicit MonsterPool(ObjectArena &arena);
+        Monster *Acquire(string_view name, int health, int fightCoefficient);
+        void Release(Monster *monster);
+        size_t FreeCount() const;
+        size_t MemoryUsage() const;
+
+    private:
+        ObjectArena &_arena;
+        std::vector<Monster *> _free;
+    };
+}
@@ -6,29 +6,54 @@
  * name, description, and may contain connections to other nodes, assets, and monsters. Nodes are the core building blocks
  * of the game map, and they allow for player movement and interactions.
  *
+ * Nodes owned by an `AdventureGameMap` do not store their paths themselves: they look up their neighbor ids in the
+ * map's `WorldGraph`, so connections stay valid however the nodes are copied or moved. A standalone node keeps the
+ * connections added with `AddConnection` in its own list.
+ *
+ * Assets and monsters are also indexed by the owning map (see `ObjectIndex`), so `FindAsset`, `FindMonster` and the
+ * removals find a name in constant time. Removing an object moves the later objects down a slot, so `GetAssets()` and
+ * `GetMonsters()` keep the order the objects were added in, which is the order the player sees them listed; a node
+ * holds only a handful of objects, so this is cheap. Standalone nodes and copies of a map's nodes are not
+ * indexed and scan their lists instead. The map's own nodes also report every object added and removed to the map's
+ * `WorldState`.
+ *
+ * Reading a node never copies it: the description and the object lists are returned by const reference and the
+ * neighbor ids as a range over the map's graph, so describing a location allocates nothing. Only `GetConnections`
+ * builds a list, of the neighbors resolved to nodes.
+ *
  * **Public Methods**:
  * - `Node(int id, string name, string description = "")`: Constructor to initialize a node with an ID, name, and optional description.
- * - `int GetId()`: Returns the ID of the node.
+ * - `int GetId() const`: Returns the ID of the node.
  * - `void SetId(int id)`: Sets the ID of the node.
- * - `string GetName() const`: Returns the name of the node.
- * - `string GetDescription() const`: Returns the description of the node.
+ * - `const string& GetName() const`: Returns the name of the node.
+ * - `Symbol GetSymbol() const`: Returns the interned symbol of the node's name, for comparing names as integers.
+ * - `const string& GetDescription() const`: Returns the description of the node.
  * - `void SetDescription(const string& description)`: Sets the description of the node.
  * - `void AddConnection(Node *conn)`: Adds a connection to another node.
- * - `vector<Node *> GetConnections() const`: Returns a list of connected nodes.
+ * - `vector<Node *> GetConnections() const`: Returns a new list of connected nodes; `GetConnectionIds` reads them without one.
+ * - `WorldGraph::NeighborRange GetConnectionIds() const`: Returns the IDs of connected nodes without resolving them.
  * - `Node *GetAConnection(int connId)`: Retrieves a specific connected node by its ID.
  * - `void AddAsset(Asset *asset)`: Adds an asset to the node.
- * - `const vector<Asset *> GetAssets() const`: Returns a list of assets at the node.
- * - `void RemoveAsset(const string& assetName)`: Removes an asset from the node.
+ * - `const vector<Asset *>& GetAssets() const`: Returns the assets at the node.
+ * - `Asset *FindAsset(string_view assetName)`: Returns an asset at the node with the given name in any case, or `nullptr`.
+ * - `Asset *FindAsset(Symbol assetName)`: Returns an asset at the node by the symbol of its name, or `nullptr`.
+ * - `void RemoveAsset(string_view assetName)`: Removes an asset from the node, matching its name in any case.
+ * - `void RemoveAsset(Symbol assetName)`: Removes an asset from the node by the symbol of its name.
  * - `void AddMonster(Monster *monster)`: Adds a monster to the node.
- * - `vector<Monster *> GetMonsters() const`: Returns a list of monsters at the node.
- * - `void RemoveMonster(const string& monsterName)`: Removes a monster from the node.
+ * - `const vector<Monster *>& GetMonsters() const`: Returns the monsters at the node.
+ * - `Monster *FindMonster(string_view monsterName)`: Returns a monster at the node with the given name in any case, or `nullptr`.
+ * - `Monster *FindMonster(Symbol monsterName)`: Returns a monster at the node by the symbol of its name, or `nullptr`.
+ * - `void RemoveMonster(string_view monsterName)`: Removes a monster from the node, matching its name in any case.
+ * - `void RemoveMonster(Symbol monsterName)`: Removes a monster from the node by the symbol of its name; a map that respawns monsters reuses it, so no pointer to it may be kept.
  * - `bool operator==(const Node &rhs) const`: Compares two nodes for equality based on their IDs.
+ * - `size_t MemoryUsage() const`: Returns the bytes the node holds, not counting the objects it points to.
  *
  * **Attributes**:
  * - `_id`: The unique identifier for the node.
- * - `_name`: The name of the node (location).
+ * - `_name`: The symbol of the node's name (location) in the global `SymbolTable`.
  * - `_description`: The description of the node.
- * - `_connections`: A list of other nodes connected to this node.
+ * - `_map`: The map that owns this node and its paths, or `nullptr` for a standalone node.
+ * - `_connections`: A list of other nodes connected to a standalone node.
  * - `_assets`: A list of assets located at this node.
  * - `_monsters`: A list of monsters found at this node.
  *
@@ -42,42 +67,69 @@
 #define NODE_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include "Asset.hpp"
 #include "Monster.hpp"
+#include "ObjectIndex.hpp"
+#include "SymbolTable.hpp"
+#include "WorldGraph.hpp"
+#include "WorldState.hpp"
 
 using std::string;
+using std::string_view;
 using std::vector;
 
 namespace chants
 {
+    class AdventureGameMap;
+
     class Node
     {
     public:
         Node(int id, string name, string description = ""); // Updated constructor
-        int GetId();
+        int GetId() const;
         void SetId(int id);
-        string GetName() const;
-        string GetDescription() const; // Getter for description
+        const string &GetName() const;
+        Symbol GetSymbol() const;
+        const string &GetDescription() const; // Getter for description
         void SetDescription(const string& description); // Setter for description
         void AddConnection(Node *conn);
         vector<Node *> GetConnections() const;
+        WorldGraph::NeighborRange GetConnectionIds() const;
         Node *GetAConnection(int connId);
         void AddAsset(Asset *asset);
-        const vector<Asset *> GetAssets() const; // Updated to return const vector
-        void RemoveAsset(const string& assetName);
+        const vector<Asset *> &GetAssets() const;
+        Asset *FindAsset(string_view assetName);
+        Asset *FindAsset(Symbol assetName);
+        void RemoveAsset(string_view assetName);
+        void RemoveAsset(Symbol assetName);
         void AddMonster(Monster *monster);
-        vector<Monster *> GetMonsters() const;
-        void RemoveMonster(const string& monsterName);
+        const vector<Monster *> &GetMonsters() const;
+        Monster *FindMonster(string_view monsterName);
+        Monster *FindMonster(Symbol monsterName);
+        void RemoveMonster(string_view monsterName);
+        void RemoveMonster(Symbol monsterName);
         bool operator==(const Node &rhs) const;
+        size_t MemoryUsage() const;
 
     private:
+        friend class AdventureGameMap;
+        friend class RegionPager;
+        friend class MonsterAI;
+
         int _id;
-        string _name;
+        Symbol _name;
         string _description; // Added description member
+        AdventureGameMap *_map;
         vector<Node *> _connections;
         vector<Asset *> _assets;
         vector<Monster *> _monsters;
+
+        ObjectIndex *assetIndex() const;
+        ObjectIndex *monsterIndex() const;
+        WorldState *worldState() const;
+        bool detachMonster(Monster *monster);
     };
 }
 
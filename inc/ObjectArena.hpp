@@ -0,0 +1,92 @@
+/**
+ * @file ObjectArena.hpp
+ * @brief Declaration of the ObjectArena class, the memory a map's assets and monsters are created in.
+ *
+ * An `ObjectArena` hands out memory from large blocks by bumping a pointer, and gives it all back at once. Every
+ * asset and monster of a map (or of a streamed region) is created in the map's arena; nodes refer to them by
+ * pointer, and those pointers stay valid until the arena is released, whatever is created after them. Objects are
+ * never freed one by one: removing an object from a node only forgets it. Only trivially destructible types can be
+ * created, so releasing the arena runs no destructors and costs one `delete` per block; a map that reserves room
+ * for all of its objects up front holds them in a single block.
+ *
+ * **Public Methods**:
+ * - `ObjectArena(size_t blockBytes = kBlockBytes)`: Constructor for an empty arena that grows in blocks of at least `blockBytes`.
+ * - `~ObjectArena()`: Releases the arena.
+ * - `template <typename T, typename... Args> T *Create(Args&&... args)`: Constructs an object in the arena and returns a pointer that is valid until the arena is released.
+ * - `template <typename T> static constexpr size_t Footprint(size_t count)`: Returns the bytes `count` objects of type `T` take in an arena.
+ * - `void Reserve(size_t bytes)`: Makes sure the next `bytes` of objects fit in the current block.
+ * - `void Release()`: Frees every block, and with them every object created.
+ * - `size_t Used() const`: Returns the bytes taken by objects.
+ * - `size_t Capacity() const`: Returns the bytes held in blocks.
+ *
+ * **Attributes**:
+ * - `_blocks`: The blocks allocated, the current one last.
+ * - `_next`, `_end`: The free part of the current block.
+ * - `_blockBytes`: The smallest block the arena allocates.
+ * - `_used`, `_capacity`: The bytes handed out and allocated.
+ *
+ * **Private Methods**:
+ * - `void *allocate(size_t bytes)`: Takes `bytes` (a multiple of `kAlignment`) from the current block, starting a new one if it is full.
+ * - `void grow(size_t bytes)`: Starts a new block of at least `bytes`.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace chants
+{
+    class ObjectArena
+    {
+    public:
+        static constexpr size_t kAlignment = 8;
+        static constexpr size_t kBlockBytes = 16 * 1024;
+
+        explicit ObjectArena(size_t blockBytes = kBlockBytes);
+        ~ObjectArena();
+        ObjectArena(ObjectArena &&other) noexcept;
+        ObjectArena &operator=(ObjectArena &&other) noexcept;
+        ObjectArena(const ObjectArena &) = delete;
+        ObjectArena &operator=(const ObjectArena &) = delete;
+
+        template <typename T, typename... Args>
+        T *Create(Args &&...args)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "an arena never runs the destructors of its objects");
+            static_assert(alignof(T) <= kAlignment, "an arena aligns its objects to kAlignment");
+            return new (allocate(Footprint<T>(1))) T(std::forward<Args>(args)...);
+        }
+
+        template <typename T>
+        static constexpr size_t Footprint(size_t count)
+        {
+            return count * ((sizeof(T) + kAlignment - 1) / kAlignment * kAlignment);
+        }
+
+        void Reserve(size_t bytes);
+        void Release();
+        size_t Used() const;
+        size_t Capacity() const;
+
+    private:
+        std::vector<std::unique_ptr<unsigned char[]>> _blocks;
+        unsigned char *_next;
+        unsigned char *_end;
+        size_t _blockBytes;
+        size_t _used;
+        size_t _capacity;
+
+        void *allocate(size_t bytes);
+        void grow(size_t bytes);
+    };
+}
@@ -0,0 +1,61 @@
+/**
+ * @file ObjectIndex.hpp
+ * @brief Declaration of the ObjectIndex class, finding the assets or monsters at a node by name in constant time.
+ *
+ * An `AdventureGameMap` keeps one `ObjectIndex` for assets and one for monsters. Each maps a node id and the symbol
+ * of an object's name to the slot of that object in the node's list, along with how many objects at the node share
+ * the name, the slot being that of the first of them. The nodes keep the index current as objects are added and
+ * removed: a removal moves every later object at the node down a slot, and the node follows each one with `Move`.
+ *
+ * **Public Methods**:
+ * - `bool Find(uint32_t node, Symbol name, uint32_t &slot) const`: Looks up the slot of an object with the given name at a node.
+ * - `void Insert(uint32_t node, Symbol name, uint32_t slot)`: Records an object added at the given slot.
+ * - `bool Erase(uint32_t node, Symbol name, uint32_t slot)`: Forgets the object at a slot; returns true if other objects with the name remain and one of them must be `Set` as the new entry.
+ * - `void Move(uint32_t node, Symbol name, uint32_t from, uint32_t to)`: Follows an object moved from one slot to another.
+ * - `void Set(uint32_t node, Symbol name, uint32_t slot)`: Points the entry for a name at a different slot.
+ * - `void Clear(uint32_t node, Symbol name)`: Forgets every object with the name at a node.
+ * - `size_t Size() const`: Returns the number of (node, name) entries.
+ * - `size_t MemoryUsage() const`: Returns an estimate of the bytes held by the entries and buckets.
+ *
+ * **Attributes**:
+ * - `_entries`: The slot and count for each (node, name) pair, keyed by the node id in the upper and the symbol in the lower 32 bits.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "SymbolTable.hpp"
+
+namespace chants
+{
+    class ObjectIndex
+    {
+    public:
+        bool Find(uint32_t node, Symbol name, uint32_t &slot) const;
+        void Insert(uint32_t node, Symbol name, uint32_t slot);
+        bool Erase(uint32_t node, Symbol name, uint32_t slot);
+        void Move(uint32_t node, Symbol name, uint32_t from, uint32_t to);
+        void Set(uint32_t node, Symbol name, uint32_t slot);
+        void Clear(uint32_t node, Symbol name);
+        size_t Size() const;
+        size_t MemoryUsage() const;
+
+    private:
+        struct Entry
+        {
+            uint32_t slot;  // one slot holding an object with the name
+            uint32_t count; // how many objects at the node have the name
+        };
+
+        std::unordered_map<uint64_t, Entry> _entries;
+
+        static uint64_t key(uint32_t node, Symbol name);
+    };
+}
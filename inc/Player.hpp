@@ -6,18 +6,30 @@
  * the player's inventory, interacting with assets, and attacking monsters. The player can collect items from nodes,
  * view and remove assets, and engage in combat with monsters.
  *
+ * **Public Types**:
+ * - `PlayerProfile`: What a player starts a game as: a name, health and fight coefficient.
+ *
  * **Public Methods**:
  * - `Player(string name, int health, int fightCoefficient)`: Constructor to initialize the player with a name, health, and fight coefficient.
- * - `void AddAsset(Asset asset)`: Adds an asset to the player's inventory.
- * - `void ViewInventory()`: Displays the player's current inventory.
- * - `void RemoveAsset(const string& assetName)`: Removes an asset from the player's inventory.
+ * - `explicit Player(const PlayerProfile& profile)`: Constructor to initialize the player as a profile describes.
+ * - `void AddAsset(Asset asset)`: Adds a copy of an asset to the player's inventory, stacked with any others of the same name; assets are a few words with no strings of their own, so the copy is as cheap as a handle and outlives the map it came from.
+ * - `void ViewInventory()`: Displays the player's current inventory on standard output.
+ * - `void ViewInventory(OutputSink& out) const`: Writes the player's current inventory to a sink.
+ * - `void RemoveAsset(const string& assetName)`: Removes one copy of an asset from the player's inventory.
+ * - `void RemoveAsset(Symbol assetName)`: Removes one copy of an asset from the player's inventory by the symbol of its name.
  * - `void UseAsset(const string& assetName)`: Uses a specified asset from the inventory.
+ * - `void UseAsset(Symbol assetName)`: Uses an asset from the inventory by the symbol of its name.
  * - `void CollectItems(Node& node)`: Collects assets from a given node and adds them to the player's inventory.
- * - `void AttackMonster(Monster& monster, Node& node)`: Attacks a specified monster using available assets.
- * - `const vector<Asset>& GetAssets() const`: Returns a reference to the player's list of assets.
+ * - `void ListWeapons(OutputSink& out) const`: Writes the names of the offensive assets the player can attack with.
+ * - `const Asset* FindWeapon(const string& weaponName) const`: Returns the offensive asset with the given name, or `nullptr`.
+ * - `BattleOutcome AttackMonster(Monster& monster, Node& node, const string& weaponName, OutputSink& out)`: Attacks a monster with the named weapon (empty for none), writes the battle to `out` and removes a defeated monster from the node.
+ * - `const Inventory& GetInventory() const`: Returns a reference to the player's inventory.
+ * - `size_t MemoryUsage() const`: Returns the bytes held by the player and their inventory.
+ * - `void Save(GameSnapshot& snapshot) const`: Records the player's health, fights and inventory; throws `std::logic_error` if an asset did not come from a world file.
+ * - `void Restore(const GameSnapshot& snapshot, const WorldFile& world)`: Puts the player back as saved, recreating the inventory from the world file.
  *
  * **Attributes**:
- * - `_assets`: A vector that stores the assets (items) the player has collected.
+ * - `_inventory`: The assets (items) the player has collected, stacked by name and indexed by name and category (see `Inventory.hpp`).
  *
  * @author Evan Aarons Wood
  * @version 1.0
@@ -31,29 +43,50 @@
 #include <string>
 #include <vector>
 #include "Combatant.hpp"
+#include "GameSnapshot.hpp"
 #include "Asset.hpp"
+#include "Battle.hpp"
+#include "GameIO.hpp"
+#include "Inventory.hpp"
 #include "Node.hpp"
 #include "Monster.hpp"
+#include "WorldFile.hpp"
 
 using std::string;
 using std::vector;
 
 namespace chants
 {
+    struct PlayerProfile
+    {
+        string name;
+        int health;
+        int fightCoefficient;
+    };
+
     class Player : public Combatant
     {
     public:
         Player(string name, int health, int fightCoefficient);
+        explicit Player(const PlayerProfile& profile);
         void AddAsset(Asset asset);
         void ViewInventory();
+        void ViewInventory(OutputSink& out) const;
         void RemoveAsset(const std::string& assetName);
+        void RemoveAsset(Symbol assetName);
         void UseAsset(const std::string& assetName);
+        void UseAsset(Symbol assetName);
         void CollectItems(Node& node);
-        void AttackMonster(Monster& monster, Node& node); // Updated declaration
-        const vector<Asset>& GetAssets() const;
+        void ListWeapons(OutputSink& out) const;
+        const Asset* FindWeapon(const std::string& weaponName) const;
+        BattleOutcome AttackMonster(Monster& monster, Node& node, const std::string& weaponName, OutputSink& out);
+        const Inventory& GetInventory() const;
+        size_t MemoryUsage() const;
+        void Save(GameSnapshot& snapshot) const;
+        void Restore(const GameSnapshot& snapshot, const WorldFile& world);
 
     private:
-        vector<Asset> _assets; // Store assets as objects
+        Inventory _inventory;
     };
 }
 
@@ -0,0 +1,183 @@
+/**
+ * @file RegionPager.hpp
+ * @brief Declaration of the RegionPager class, keeping only the regions around the player in memory.
+ *
+ * The `RegionPager` class backs an `AdventureGameMap` in streaming mode. The world file stays memory-mapped and the
+ * pager only builds `Node` objects, with their assets and monsters, for the regions the player can currently reach:
+ * the region of the focus node and the regions bordering it. Bordering regions are built ahead of time by a
+ * background loader thread. Asking for a node whose region is not resident builds that region on the spot. A
+ * region's assets and monsters live in its own `ObjectArena`, so destroying a region frees its objects in a block
+ * or two.
+ *
+ * Regions are adopted and evicted only on the thread that owns the map, so `Node` pointers stay valid until the
+ * next `SetFocus` call. That call evicts the regions the player has left and hands them to the loader thread, which
+ * destroys them. Adopting a region adds its locations and objects to the map's name indexes and evicting it drops
+ * them; the regions holding the focus node's direct neighbors are always adopted, so every location one step away
+ * can be found by name.
+ *
+ * When a region is evicted the pager records which of the world file's objects are still in it, and the state of
+ * its monsters' fights, so a region comes back the way the player left it. The same records make a saved game: the
+ * pager reports the objects that differ from the world file's placements (see `GameSnapshot`), and a pager made
+ * from a snapshot starts every region the game changed from those records. Objects never leave the region they were
+ * placed in. The pager counts every placement into the map's `WorldState` when it is made; nodes are bound to the
+ * map only when adopted, so building and evicting regions leaves the counts alone.
+ *
+ * A map that respawns monsters hands defeated ones back to the pool of their region (see `MonsterPool`) and asks the
+ * pager to bring them back. A monster respawning in a resident region is built from the pool; one respawning in a
+ * region that is not is added to the region's saved objects, and counted into the map's `WorldState` by hand.
+ *
+ * **Public Methods**:
+ * - `RegionPager(const WorldFile& world, AdventureGameMap* map, unsigned seed, const StreamingOptions& options, const vector<GameSnapshot::ObjectChange>& changes = {})`: Constructor that starts the loader thread; `changes` restores a saved game.
+ * - `~RegionPager()`: Stops the loader thread and frees every resident region.
+ * - `Node *Find(uint32_t id)`: Returns a node, building its region first if it is not resident.
+ * - `void SetFocus(uint32_t id)`: Makes a node the player's position: its region and the regions bordering it become resident, and all others are evicted.
+ * - `Node *ResidentLocation(uint32_t id) const`: Returns a node if its region is resident, without building it.
+ * - `uint32_t ResidentRegionCount() const`: Returns the number of regions currently in memory.
+ * - `vector<Node> ResidentLocations() const`: Returns copies of the nodes of every resident region.
+ * - `void ForEachResident(Visit&& visit) const`: Calls `visit` with the nodes of every resident region, in place.
+ * - `size_t MemoryUsage() const`: Returns an estimate of the bytes held by the pager and every region it holds.
+ * - `void Save(GameSnapshot& snapshot) const`: Records the placed objects that differ from the world file's placements, resident or not.
+ * - `void Release(Monster* monster, uint32_t node)`: Takes back a monster defeated at a resident node, to be reused by its region.
+ * - `void Respawn(uint32_t placement, uint64_t due)`: Brings a defeated monster back at the node it was placed at, with a fight seeded from its starting one and `due`.
+ *
+ * **Attributes**:
+ * - `_world`, `_map`, `_options`, `_seed`: The world file read from, the map nodes are bound to, the paging options and the seed of the map.
+ * - `_regions`: The region partition stored in the world file.
+ * - `_placementNode`, `_placementOffsets`, `_placementsByRegion`: Where every placed object starts, grouped by region.
+ * - `_resident`, `_residentList`, `_lastFocus`, `_clock`: The regions built and adopted by the map, and when each was last focused.
+ * - `_mutex`, `_wake`, `_loaded`: Guard and signal the state shared with the loader thread below.
+ * - `_queue`, `_loading`, `_ready`, `_retired`, `_saved`, `_stop`: Regions to prefetch, in progress, built, waiting to be destroyed, the saved state of evicted regions, and the shutdown flag.
+ * - `_loader`: The background loader thread.
+ *
+ * **Private Methods**:
+ * - `static size_t regionBytes(const Region& region)`: Estimates the bytes held by one region.
+ * - `std::unique_ptr<Region> build(uint32_t region) const`: Creates a region's nodes and objects.
+ * - `void acquire(uint32_t region)`, `void adopt(std::unique_ptr<Region> region)`, `void evict(uint32_t region)`: Move regions in and out of the map.
+ * - `static vector<SavedObject> record(const Region& region)`: Lists the objects left in a region, in the order its nodes list them.
+ * - `void compare(uint32_t region, const vector<SavedObject>& objects, vector<GameSnapshot::ObjectChange>& changes) const`: Adds the objects of a region that differ from its placements to `changes`.
+ * - `uint64_t startingFightState(uint32_t placement) const`: Returns the fight state a placed monster starts with, 0 for an asset.
+ * - `void loaderLoop()`: Runs the loader thread.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Asset.hpp"
+#include "GameSnapshot.hpp"
+#include "Monster.hpp"
+#include "MonsterPool.hpp"
+#include "Node.hpp"
+#include "ObjectArena.hpp"
+#include "RegionPartition.hpp"
+#include "WorldFile.hpp"
+
+using std::vector;
+
+namespace chants
+{
+    class AdventureGameMap;
+
+    struct StreamingOptions
+    {
+        uint32_t spareRegions = 0; // recently left regions kept beyond the focus region and its neighbors
+        bool prefetch = true;      // build bordering regions on the loader thread
+    };
+
+    class RegionPager
+    {
+    public:
+        RegionPager(const WorldFile &world, AdventureGameMap *map, unsigned seed, const StreamingOptions &options,
+                    const vector<GameSnapshot::ObjectChange> &changes = {});
+        ~RegionPager();
+        RegionPager(const RegionPager &) = delete;
+        RegionPager &operator=(const RegionPager &) = delete;
+
+        Node *Find(uint32_t id);
+        void SetFocus(uint32_t id);
+        Node *ResidentLocation(uint32_t id) const;
+        uint32_t ResidentRegionCount() const;
+        vector<Node> ResidentLocations() const;
+        template <typename Visit>
+        void ForEachResident(Visit &&visit) const
+        {
+            for (uint32_t region : _residentList)
+            {
+                for (const Node &node : _resident[region]->nodes)
+                {
+                    visit(node);
+                }
+            }
+        }
+        size_t MemoryUsage() const;
+        void Save(GameSnapshot &snapshot) const;
+        void Release(Monster *monster, uint32_t node);
+        void Respawn(uint32_t placement, uint64_t due);
+
+    private:
+        static constexpr uint32_t kNone = UINT32_MAX;
+
+        struct Region
+        {
+            uint32_t id;
+            vector<Node> nodes;            // members of the region, in ascending id order
+            ObjectArena objects;           // the assets and monsters placed in the region, freed with it
+            MonsterPool monsters{objects}; // the region's monsters, reused when they respawn
+        };
+
+        struct SavedObject
+        {
+            uint32_t placement;
+            uint32_t node;
+            uint64_t fightState; // a monster's random engine, 0 for an asset
+        };
+
+        const WorldFile &_world;
+        AdventureGameMap *_map;
+        StreamingOptions _options;
+        unsigned _seed;
+        RegionPartition _regions;
+        vector<uint32_t> _placementNode;
+        vector<uint32_t> _placementOffsets;
+        vector<uint32_t> _placementsByRegion;
+
+        // owned by the map's thread
+        vector<std::unique_ptr<Region>> _resident;
+        vector<uint32_t> _residentList;
+        vector<uint64_t> _lastFocus;
+        uint64_t _clock;
+
+        // shared with the loader thread
+        mutable std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _loaded;
+        std::deque<uint32_t> _queue;
+        uint32_t _loading;
+        std::unordered_map<uint32_t, std::unique_ptr<Region>> _ready;
+        vector<std::unique_ptr<Region>> _retired;
+        std::unordered_map<uint32_t, vector<SavedObject>> _saved;
+        bool _stop;
+        std::thread _loader;
+
+        static size_t regionBytes(const Region &region);
+        std::unique_ptr<Region> build(uint32_t region) const;
+        void acquire(uint32_t region);
+        void adopt(std::unique_ptr<Region> region);
+        void evict(uint32_t region);
+        static vector<SavedObject> record(const Region &region);
+        void compare(uint32_t region, const vector<SavedObject> &objects, vector<GameSnapshot::ObjectChange> &changes) const;
+        uint64_t startingFightState(uint32_t placement) const;
+        void loaderLoop();
+    };
+}
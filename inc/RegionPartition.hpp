@@ -0,0 +1,77 @@
+/**
+ * @file RegionPartition.hpp
+ * @brief Declaration of the RegionPartition class, splitting the game map into regions of nearby locations.
+ *
+ * The `RegionPartition` class assigns every node of a `WorldGraph` to a region. Regions are grown breadth-first
+ * from the lowest unassigned node until they reach a target size, so the locations of a region are close to each
+ * other and most paths stay inside one region. The partition also keeps the member list of every region (sorted
+ * by node id) and a graph of which regions border each other.
+ *
+ * Like `WorldGraph`, a partition either owns its arrays or is a view over arrays stored elsewhere, such as a
+ * memory-mapped world file. It can be moved but not copied.
+ *
+ * **Public Methods**:
+ * - `static RegionPartition Build(const WorldGraph& graph, uint32_t targetSize)`: Partitions a graph into regions of about `targetSize` nodes.
+ * - `static RegionPartition View(...)`: Wraps partition arrays that live elsewhere without copying them.
+ * - `uint32_t NodeCount() const`: Returns the number of partitioned nodes.
+ * - `uint32_t RegionCount() const`: Returns the number of regions.
+ * - `uint32_t RegionOf(uint32_t node) const`: Returns the region a node belongs to.
+ * - `WorldGraph::NeighborRange Members(uint32_t region) const`: Returns the ids of the nodes in a region, in ascending order.
+ * - `uint32_t LocalIndex(uint32_t node) const`: Returns the position of a node within its region's member list.
+ * - `const WorldGraph& Adjacency() const`: Returns the graph of regions joined by at least one path.
+ *
+ * **Attributes**:
+ * - `_nodeCount`, `_regionCount`: The number of nodes and regions.
+ * - `_regionOf`: The region of every node.
+ * - `_memberOffsets`, `_members`: The members of every region in CSR form.
+ * - `_adjacency`: The region graph.
+ * - `_regionOfStore`, `_offsetStore`, `_memberStore`: The owned arrays, empty for a view.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "WorldGraph.hpp"
+
+using std::vector;
+
+namespace chants
+{
+    class RegionPartition
+    {
+    public:
+        RegionPartition();
+        RegionPartition(RegionPartition &&other) = default;
+        RegionPartition &operator=(RegionPartition &&other) = default;
+        RegionPartition(const RegionPartition &) = delete;
+        RegionPartition &operator=(const RegionPartition &) = delete;
+
+        static RegionPartition Build(const WorldGraph &graph, uint32_t targetSize);
+        static RegionPartition View(uint32_t nodeCount, uint32_t regionCount, const uint32_t *regionOf,
+                                    const uint32_t *memberOffsets, const uint32_t *members, WorldGraph adjacency);
+
+        uint32_t NodeCount() const;
+        uint32_t RegionCount() const;
+        uint32_t RegionOf(uint32_t node) const;
+        WorldGraph::NeighborRange Members(uint32_t region) const;
+        uint32_t LocalIndex(uint32_t node) const;
+        const WorldGraph &Adjacency() const;
+
+    private:
+        uint32_t _nodeCount;
+        uint32_t _regionCount;
+        const uint32_t *_regionOf;
+        const uint32_t *_memberOffsets;
+        const uint32_t *_members;
+        WorldGraph _adjacency;
+        vector<uint32_t> _regionOfStore;
+        vector<uint32_t> _offsetStore;
+        vector<uint32_t> _memberStore;
+    };
+}
@@ -0,0 +1,123 @@
+/**
+ * @file RoutePlanner.hpp
+ * @brief Declaration of the RoutePlanner class, answering "how do I get from here to there" on a world's paths.
+ *
+ * The `RoutePlanner` class finds shortest routes (fewest paths taken) over a `WorldGraph`. Paths are one-way, so it
+ * searches backwards from the destination: one breadth-first search over the reversed paths gives every location's
+ * next step towards that destination, stored as the position of the step in the location's own neighbor list.
+ * Following next steps walks the route in constant time per location.
+ *
+ * How the next steps are kept depends on the size of the world:
+ * - Up to `tableLimit` locations, the planner searches from every destination when it is built, splitting the
+ *   searches over a `ThreadPool`, and keeps the whole table. Every query is then a walk through the table. The
+ *   table keeps next steps in 16 bits, so a world with a location of 65535 paths or more is searched on demand.
+ * - Above that, if the planner was given the world's `RegionPartition`, it routes through a `HierarchicalRouter`
+ *   instead, which only looks at the regions between the two locations; its routes may be a few steps longer
+ *   than the shortest.
+ * - Otherwise a destination is searched the first time it is asked for and kept in a cache of the `cacheSize`
+ *   most recently used destinations. Players and scripts tend to head for the same few places, so most queries
+ *   still find their search cached.
+ *
+ * The planner copies the graph it is given, which costs nothing for graphs read from a `WorldFile` (the copy is a
+ * view of the same mapped file, which must outlive the planner), so one planner can serve every map opened from
+ * the same world. Queries may come from several threads at once.
+ *
+ * **Public Types**:
+ * - `RoutePlannerOptions`: The largest world to precompute, the size of the cache and the threads to precompute on.
+ *
+ * **Public Methods**:
+ * - `RoutePlanner(const WorldGraph& graph, const RoutePlannerOptions& options = RoutePlannerOptions())`: Constructor that precomputes the table for small worlds.
+ * - `RoutePlanner(const WorldGraph& graph, RegionPartition regions, const RoutePlannerOptions& options = RoutePlannerOptions())`: Constructor that routes large worlds through their regions.
+ * - `uint32_t NextStep(uint32_t from, uint32_t to) const`: Returns the location to go to next on a shortest route, `to` itself when one path away, or `kNone` if `to` cannot be reached.
+ * - `bool Route(uint32_t from, uint32_t to, vector<uint32_t>& route) const`: Fills `route` with the locations visited after `from`, ending with `to`; returns false if there is no route.
+ * - `uint32_t Distance(uint32_t from, uint32_t to) const`: Returns the number of paths on a shortest route, or `kNone`.
+ * - `bool IsPrecomputed() const`: Checks whether every route was computed up front.
+ * - `bool IsHierarchical() const`: Checks whether routes go through the regions.
+ * - `size_t CachedDestinations() const`: Returns the number of destinations in the cache.
+ * - `uint32_t LocationCount() const`: Returns the number of locations routed over.
+ *
+ * **Attributes**:
+ * - `_graph`: The paths routed over.
+ * - `_reverseOffsets`, `_reverseSources`, `_reverseSlots`: The paths reversed, in CSR form, with each path's position in its source's neighbor list.
+ * - `_options`: The planner's options.
+ * - `_table`: The next step from every location to every destination, in 16 bits, when precomputed.
+ * - `_mutex`, `_cache`, `_cacheOrder`: The searched destinations and the order they were last used in, when not precomputed.
+ * - `_hierarchy`: The region router, for large worlds with regions.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "RegionPartition.hpp"
+#include "WorldGraph.hpp"
+
+using std::vector;
+
+namespace chants
+{
+    struct RoutePlannerOptions
+    {
+        uint32_t tableLimit = 2048; // precompute every route up to this many locations (2 bytes per pair), if no location has 65535 paths
+        uint32_t cacheSize = 32;    // destinations kept when routes are searched on demand
+        unsigned threads = 0;       // threads to precompute on, 0 for one per hardware thread
+    };
+
+    class HierarchicalRouter;
+
+    class RoutePlanner
+    {
+    public:
+        static constexpr uint32_t kNone = UINT32_MAX;
+
+        explicit RoutePlanner(const WorldGraph &graph, const RoutePlannerOptions &options = RoutePlannerOptions());
+        RoutePlanner(const WorldGraph &graph, RegionPartition regions, const RoutePlannerOptions &options = RoutePlannerOptions());
+        ~RoutePlanner();
+        RoutePlanner(const RoutePlanner &) = delete;
+        RoutePlanner &operator=(const RoutePlanner &) = delete;
+
+        uint32_t NextStep(uint32_t from, uint32_t to) const;
+        bool Route(uint32_t from, uint32_t to, vector<uint32_t> &route) const;
+        uint32_t Distance(uint32_t from, uint32_t to) const;
+        bool IsPrecomputed() const;
+        bool IsHierarchical() const;
+        size_t CachedDestinations() const;
+        uint32_t LocationCount() const;
+
+    private:
+        using Steps = vector<uint32_t>; // per location, the position of the next step in its neighbor list
+        static constexpr uint32_t kNoStep = UINT32_MAX;
+        static constexpr uint16_t kNoTableStep = UINT16_MAX;
+
+        WorldGraph _graph;
+        vector<uint32_t> _reverseOffsets;
+        vector<uint32_t> _reverseSources;
+        vector<uint32_t> _reverseSlots;
+        RoutePlannerOptions _options;
+        vector<uint16_t> _table;
+
+        mutable std::mutex _mutex;
+        mutable std::unordered_map<uint32_t, std::pair<std::shared_ptr<const Steps>, std::list<uint32_t>::iterator>> _cache;
+        mutable std::list<uint32_t> _cacheOrder; // most recently used first
+        std::unique_ptr<HierarchicalRouter> _hierarchy;
+
+        void prepare(RegionPartition *regions);
+
+        template <typename Step>
+        void search(uint32_t to, Step *steps, vector<uint32_t> &queue) const;
+        template <typename Step>
+        bool walk(uint32_t from, uint32_t to, const Step *steps, vector<uint32_t> &route) const;
+        std::shared_ptr<const Steps> stepsTo(uint32_t to) const;
+        uint32_t follow(uint32_t from, uint32_t step) const;
+    };
+}
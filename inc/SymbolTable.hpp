@@ -0,0 +1,82 @@
+/**
+ * @file SymbolTable.hpp
+ * @brief Declaration of the SymbolTable class, interning the names of locations, assets and monsters.
+ *
+ * The `SymbolTable` class gives every distinct name a small integer `Symbol` the first time it is seen, normally
+ * while a world is loaded. Objects store the symbol instead of their own copy of the name, and comparing two names
+ * becomes an integer compare. Names are matched without regard to case, so "yoru" typed by the player resolves to
+ * the same symbol as "Yoru" from the world file; the spelling seen first is the one displayed.
+ *
+ * There is one global table of names. Free text that is only ever displayed, such as the message of an asset, is
+ * interned in a second table, `Text()`, which matches exactly: it keeps messages that differ only in case apart, and
+ * keeps prose out of the table the player's typed names are looked up in. Interning and lookups may happen from any
+ * thread; reading the name of a symbol takes no lock, because interned names are never moved or freed.
+ *
+ * **Public Methods**:
+ * - `explicit SymbolTable(bool foldCase = true)`: Constructor for a table matching names without regard to case, or exactly.
+ * - `static SymbolTable& Global()`: Returns the table of names shared by the whole program.
+ * - `static SymbolTable& Text()`: Returns the case-sensitive table of displayed text shared by the whole program.
+ * - `Symbol Intern(string_view name)`: Returns the symbol for a name, adding the name if it is new.
+ * - `Symbol Find(string_view name) const`: Returns the symbol for a name (typed in any case, if the table folds case), or `kNoSymbol` if it was never interned.
+ * - `const string& Name(Symbol symbol) const`: Returns the name of a symbol.
+ * - `uint32_t Size() const`: Returns the number of interned names.
+ *
+ * **Attributes**:
+ * - `_mutex`: Guards `_symbols` and the growth of `_chunks`.
+ * - `_foldCase`: Whether names are matched without regard to case.
+ * - `_symbols`: Maps the lowercase form of every name, or the name itself, to its symbol.
+ * - `_chunks`: Fixed-size blocks holding the names, indexed by symbol.
+ * - `_size`: The number of interned names.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using std::string;
+using std::string_view;
+
+namespace chants
+{
+    using Symbol = uint32_t;
+    constexpr Symbol kNoSymbol = UINT32_MAX;
+
+    class SymbolTable
+    {
+    public:
+        explicit SymbolTable(bool foldCase = true);
+        SymbolTable(const SymbolTable &) = delete;
+        SymbolTable &operator=(const SymbolTable &) = delete;
+
+        static SymbolTable &Global();
+        static SymbolTable &Text();
+        Symbol Intern(string_view name);
+        Symbol Find(string_view name) const;
+        const string &Name(Symbol symbol) const;
+        uint32_t Size() const;
+
+    private:
+        static constexpr uint32_t kChunkBits = 12;
+        static constexpr uint32_t kChunkSize = 1u << kChunkBits;
+        static constexpr uint32_t kMaxChunks = 1u << 16;
+
+        bool _foldCase;
+        mutable std::shared_mutex _mutex;
+        std::unordered_map<string, Symbol> _symbols;
+        std::unique_ptr<std::atomic<string *>[]> _chunks;
+        std::atomic<uint32_t> _size;
+
+        void fold(string_view name, string &folded) const;
+    };
+}
@@ -0,0 +1,71 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief Declaration of the ThreadPool class, a fixed set of worker threads running queued tasks.
+ *
+ * The `ThreadPool` class starts its workers once and feeds them tasks from a shared queue. `ParallelFor` splits a
+ * range of work items over the workers and blocks until all of them are done; each call to the body is told which
+ * of `Size()` slots it runs in, so callers can give every slot its own accumulator and merge them afterwards without
+ * locking. `ParallelForStealing` does the same with work stealing: every slot starts on a contiguous share of the
+ * items, so neighbouring items tend to run on the same worker, and a slot that finishes early steals half of what
+ * another has left. Destroying the pool finishes the queued tasks and joins the workers.
+ *
+ * **Public Methods**:
+ * - `explicit ThreadPool(unsigned threads = 0)`: Constructor that starts `threads` workers, or one per hardware thread if 0.
+ * - `~ThreadPool()`: Runs the remaining tasks and joins the workers.
+ * - `unsigned Size() const`: Returns the number of workers.
+ * - `void Submit(std::function<void()> task)`: Queues a task for the next free worker.
+ * - `void Wait()`: Blocks until every submitted task has finished.
+ * - `void ParallelFor(uint64_t count, const std::function<void(uint64_t item, unsigned slot)>& body)`: Runs `body` for every item in `[0, count)` and waits for all of them.
+ * - `void ParallelForStealing(uint32_t count, const std::function<void(uint64_t item, unsigned slot)>& body)`: Runs `body` for every item in `[0, count)` from per-slot shares that idle slots steal from, and waits for all of them.
+ *
+ * **Attributes**:
+ * - `_workers`: The worker threads.
+ * - `_mutex`, `_wake`, `_idle`: Guard the queue, wake workers for new tasks and wake `Wait` when the pool runs dry.
+ * - `_tasks`: Tasks waiting for a worker.
+ * - `_active`: The number of tasks being run.
+ * - `_stop`: Set when the pool is being destroyed.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace chants
+{
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(unsigned threads = 0);
+        ~ThreadPool();
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        unsigned Size() const;
+        void Submit(std::function<void()> task);
+        void Wait();
+        void ParallelFor(uint64_t count, const std::function<void(uint64_t item, unsigned slot)> &body);
+        void ParallelForStealing(uint32_t count, const std::function<void(uint64_t item, unsigned slot)> &body);
+
+    private:
+        std::vector<std::thread> _workers;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _idle;
+        std::deque<std::function<void()>> _tasks;
+        unsigned _active;
+        bool _stop;
+
+        void workerLoop();
+    };
+}
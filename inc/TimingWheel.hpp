@@ -0,0 +1,105 @@
+/**
+ * @file TimingWheel.hpp
+ * @brief Declaration of the TimingWheel class, a hierarchical timing wheel for events due at a later tick.
+ *
+ * A `TimingWheel` keeps timers, each an id due at a tick, and hands them back as its clock passes them. It has four
+ * levels of 64 slots: level 0 holds timers due within the next 64 ticks, one slot per tick, and each level above
+ * covers 64 times the span of the one below. Scheduling drops a timer into the slot of the level that covers its
+ * due tick, and every time a level's slot comes round its timers move down a level, so scheduling is constant time
+ * and advancing the clock costs one slot per tick, whatever the number of timers. Timers more than 2^24 ticks away
+ * wait in an overflow list that is revisited whenever the top level turns over.
+ *
+ * Timers due at the same tick come back in the order they were scheduled, and a jump of many ticks returns the same
+ * timers in the same order as advancing one tick at a time, so whatever the wheel drives replays the same way. The
+ * map uses it to respawn monsters, with game turns as ticks (see `AdventureGameMap`).
+ *
+ * **Public Types**:
+ * - `TimingWheel::Timer`: A timer's id, due tick and scheduling order.
+ *
+ * **Public Methods**:
+ * - `TimingWheel(uint64_t now = 0)`: Constructor for an empty wheel whose clock reads `now`.
+ * - `void Reset(uint64_t now)`: Drops every timer and sets the clock.
+ * - `void Schedule(uint32_t id, uint64_t due)`: Adds a timer; one due at or before the clock fires on the next `Advance`.
+ * - `void Advance(uint64_t now, vector<Timer>& fired)`: Moves the clock to `now` and replaces `fired` with the timers due by then, in due then scheduling order.
+ * - `void Pending(vector<Timer>& timers) const`: Replaces `timers` with every timer not yet fired, in the order they will fire.
+ * - `uint64_t Now() const`: Returns the clock.
+ * - `size_t Size() const`: Returns the number of timers not yet fired.
+ * - `size_t MemoryUsage() const`: Returns the bytes held by the wheel.
+ *
+ * **Attributes**:
+ * - `_now`: The clock, the last tick advanced to.
+ * - `_sequence`: The scheduling order given to the next timer.
+ * - `_entries`, `_free`: The timers, chained through `next` into slots or the free list.
+ * - `_slots`: The first timer in every slot of every level, `kEnd` if empty.
+ * - `_overflow`, `_late`: The heads of the lists of timers beyond the top level and of timers already due.
+ * - `_size`: The number of timers not yet fired.
+ *
+ * **Private Methods**:
+ * - `void place(uint32_t entry)`: Puts a timer into the slot or list its due tick calls for.
+ * - `void push(uint32_t& head, uint32_t entry)`: Chains a timer onto a list.
+ * - `void drain(uint32_t& head, vector<Timer>& fired)`: Empties a list into `fired`, freeing its timers.
+ * - `void cascade(uint32_t& head)`: Empties a list back into the wheel, one level down.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+namespace chants
+{
+    class TimingWheel
+    {
+    public:
+        static constexpr uint32_t kSlotBits = 6;
+        static constexpr uint32_t kSlots = 1u << kSlotBits;
+        static constexpr uint32_t kLevels = 4;
+
+        struct Timer
+        {
+            uint32_t id;
+            uint64_t due;
+            uint64_t sequence;
+        };
+
+        explicit TimingWheel(uint64_t now = 0);
+        void Reset(uint64_t now);
+        void Schedule(uint32_t id, uint64_t due);
+        void Advance(uint64_t now, vector<Timer> &fired);
+        void Pending(vector<Timer> &timers) const;
+        uint64_t Now() const;
+        size_t Size() const;
+        size_t MemoryUsage() const;
+
+    private:
+        static constexpr uint32_t kEnd = UINT32_MAX;
+
+        struct Entry
+        {
+            Timer timer;
+            uint32_t next;
+        };
+
+        uint64_t _now;
+        uint64_t _sequence;
+        vector<Entry> _entries;
+        uint32_t _free;
+        uint32_t _slots[kLevels][kSlots];
+        uint32_t _overflow;
+        uint32_t _late;
+        size_t _size;
+
+        void place(uint32_t entry);
+        void push(uint32_t &head, uint32_t entry);
+        void drain(uint32_t &head, vector<Timer> &fired);
+        void cascade(uint32_t &head);
+    };
+}
@@ -0,0 +1,81 @@
+/**
+ * @file WorldCompiler.hpp
+ * @brief Declaration of the world compiler, turning editable text worlds into binary world files.
+ *
+ * A world is written by hand as a text file and compiled into the binary layout read by `WorldFile`. Each line of
+ * the text format is a keyword followed by its fields; text containing spaces goes in double quotes (with `\n`,
+ * `\"` and `\\` escapes) and `#` starts a comment:
+ *
+ * ```
+ * node 0 "Fuschia Village" "A peaceful village ...\n"
+ * path 0 1 2                          # one-way paths from node 0 to nodes 1 and 2
+ * asset "Yoru" 500 offensive "A legendary black blade ..."   # offensive, healing, navigation or passive
+ * monster "Arlong" 4000 150           # health, fight coefficient
+ * place asset "Yoru" random           # a node id, a quoted node name, or random
+ * regions 64                          # optional: target number of locations per streaming region
+ * ```
+ *
+ * Node ids must run from 0 without gaps, since a node's id is its index in the map. The compiler partitions the
+ * map into regions (see `RegionPartition`) and stores the partition in the file for streaming maps.
+ *
+ * **Public Types**:
+ * - `WorldSource`: An in-memory world: nodes, paths, asset and monster definitions, placements and the region size.
+ *
+ * **Public Functions**:
+ * - `WorldSource ParseWorldText(istream& in, const string& sourceName)`: Parses the text format; throws `std::runtime_error` with the line number on errors.
+ * - `void WriteWorldFile(const WorldSource& world, const string& path)`: Writes a world in the binary format.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <istream>
+#include <string>
+#include <vector>
+#include "WorldFile.hpp"
+#include "WorldGraph.hpp"
+
+using std::istream;
+using std::string;
+using std::vector;
+
+namespace chants
+{
+    struct WorldSource
+    {
+        struct NodeDef
+        {
+            string name;
+            string description;
+        };
+
+        struct AssetDef
+        {
+            string name;
+            string message;
+            int value;
+            AssetCategory category;
+        };
+
+        struct MonsterDef
+        {
+            string name;
+            int health;
+            int fightCoefficient;
+        };
+
+        vector<NodeDef> nodes;
+        WorldGraph graph;
+        vector<AssetDef> assets;
+        vector<MonsterDef> monsters;
+        vector<WorldFile::Placement> placements;
+        uint32_t regionSize = 64;
+    };
+
+    WorldSource ParseWorldText(istream &in, const string &sourceName);
+    void WriteWorldFile(const WorldSource &world, const string &path);
+}
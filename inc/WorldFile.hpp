@@ -0,0 +1,193 @@
+/**
+ * @file WorldFile.hpp
+ * @brief Declaration of the WorldFile class, a memory-mapped binary game world.
+ *
+ * The `WorldFile` class maps a compiled world (see `WorldCompiler.hpp`) into memory and reads it in place: node
+ * names and descriptions, the CSR path arrays, asset and monster definitions, and where each object is placed.
+ * Nothing is parsed or copied at open time beyond a bounds check of every section, so loading a large world costs
+ * one page-in of the file rather than building it up call by call.
+ *
+ * **File Layout** (little-endian, every section 8-byte aligned):
+ * - `Header`: magic, format version, element counts and the byte offset of each section.
+ * - Node records, then the `nodeCount + 1` CSR offsets and the `edgeCount` path targets.
+ * - Asset records, monster records and placement records.
+ * - The region partition: the region of every node, the members of every region and the region graph (CSR).
+ * - One blob holding every string; records refer to it by offset and length.
+ *
+ * **Public Methods**:
+ * - `WorldFile(const string& path)`: Maps and validates a world file; throws `std::runtime_error` if it is not a valid world.
+ * - `uint32_t NodeCount() const`: Returns the number of nodes (locations).
+ * - `string_view NodeName(uint32_t id) const`: Returns the name of a node.
+ * - `string_view NodeDescription(uint32_t id) const`: Returns the description of a node.
+ * - `WorldGraph Graph() const`: Returns a graph that reads the mapped path arrays without copying them.
+ * - `RegionPartition Regions() const`: Returns the region partition stored in the file, read in place.
+ * - `uint32_t AssetCount() const` / `AssetDef GetAsset(uint32_t index) const`: Access the asset definitions.
+ * - `uint32_t MonsterCount() const` / `MonsterDef GetMonster(uint32_t index) const`: Access the monster definitions.
+ * - `uint32_t PlacementCount() const` / `Placement GetPlacement(uint32_t index) const`: Access the object placements.
+ * - `vector<uint32_t> ResolvePlacements(unsigned seed) const`: Returns the starting node of every placement, picking random ones from `seed`.
+ * - `static uint32_t CategoryFlags(AssetCategory category)` / `static AssetCategory CategoryOf(uint32_t flags)`: Convert between an asset's category and the flags of its record; a record with no flag is passive.
+ *
+ * **Attributes**:
+ * - `_data`: The start of the mapped file.
+ * - `_size`: The size of the mapped file in bytes.
+ * - `_header`: The file header, at the start of `_data`.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Asset.hpp"
+#include "RegionPartition.hpp"
+#include "WorldGraph.hpp"
+
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace chants
+{
+    class WorldFile
+    {
+    public:
+        static constexpr char kMagic[4] = {'C', 'H', 'W', 'D'};
+        static constexpr uint32_t kVersion = 2;
+        static constexpr uint32_t kRandomNode = 0xFFFFFFFFu; // placement node chosen when the map is built
+        static constexpr uint32_t kOffensiveFlag = 1u;
+        static constexpr uint32_t kHealingFlag = 2u;
+        static constexpr uint32_t kNavigationFlag = 4u;
+
+        enum class PlacementKind : uint32_t
+        {
+            Asset = 0,
+            Monster = 1
+        };
+
+        // on-disk records
+        struct Header
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t nodeCount;
+            uint32_t edgeCount;
+            uint32_t assetCount;
+            uint32_t monsterCount;
+            uint32_t placementCount;
+            uint32_t regionCount;
+            uint32_t regionEdgeCount;
+            uint32_t reserved;
+            uint64_t nodesOffset;
+            uint64_t offsetsOffset;
+            uint64_t targetsOffset;
+            uint64_t assetsOffset;
+            uint64_t monstersOffset;
+            uint64_t placementsOffset;
+            uint64_t regionOfOffset;
+            uint64_t regionMemberOffsetsOffset;
+            uint64_t regionMembersOffset;
+            uint64_t regionPathOffsetsOffset;
+            uint64_t regionPathsOffset;
+            uint64_t stringsOffset;
+            uint64_t stringsSize;
+        };
+
+        struct StringRef
+        {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        struct NodeRecord
+        {
+            StringRef name;
+            StringRef description;
+        };
+
+        struct AssetRecord
+        {
+            StringRef name;
+            StringRef message;
+            int32_t value;
+            uint32_t flags;
+        };
+
+        struct MonsterRecord
+        {
+            StringRef name;
+            int32_t health;
+            int32_t fightCoefficient;
+        };
+
+        struct PlacementRecord
+        {
+            uint32_t kind;
+            uint32_t object;
+            uint32_t node;
+            uint32_t reserved;
+        };
+
+        // decoded views handed to callers
+        struct AssetDef
+        {
+            string_view name;
+            string_view message;
+            int value;
+            AssetCategory category;
+        };
+
+        struct MonsterDef
+        {
+            string_view name;
+            int health;
+            int fightCoefficient;
+        };
+
+        struct Placement
+        {
+            PlacementKind kind;
+            uint32_t object;
+            uint32_t node;
+        };
+
+        explicit WorldFile(const string &path);
+        ~WorldFile();
+        WorldFile(const WorldFile &) = delete;
+        WorldFile &operator=(const WorldFile &) = delete;
+
+        uint32_t NodeCount() const;
+        string_view NodeName(uint32_t id) const;
+        string_view NodeDescription(uint32_t id) const;
+        WorldGraph Graph() const;
+        RegionPartition Regions() const;
+        uint32_t AssetCount() const;
+        AssetDef GetAsset(uint32_t index) const;
+        uint32_t MonsterCount() const;
+        MonsterDef GetMonster(uint32_t index) const;
+        uint32_t PlacementCount() const;
+        Placement GetPlacement(uint32_t index) const;
+        vector<uint32_t> ResolvePlacements(unsigned seed) const;
+        static uint32_t CategoryFlags(AssetCategory category);
+        static AssetCategory CategoryOf(uint32_t flags);
+
+    private:
+        const uint8_t *_data;
+        size_t _size;
+        const Header *_header;
+
+        template <typename T>
+        const T *section(uint64_t offset) const
+        {
+            return reinterpret_cast<const T *>(_data + offset);
+        }
+        string_view text(StringRef ref) const;
+        void validate(const string &path) const;
+    };
+}
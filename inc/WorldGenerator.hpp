@@ -0,0 +1,63 @@
+/**
+ * @file WorldGenerator.hpp
+ * @brief Declaration of the world generator, building large random worlds for scale testing.
+ *
+ * `GenerateWorld` makes a `WorldSource` with any number of locations, to be written with `WriteWorldFile` and
+ * played, streamed or served like a compiled one. Every location opens a number of two-way paths to locations
+ * with lower ids, drawn from a degree distribution; the first always leads to one of the `locality` locations
+ * just below it, so every location can be reached from every other, and most of the rest stay as close, so the
+ * region partition finds compact regions. A share of paths (`longRange`) may lead to any lower id instead. Assets
+ * and monsters are taken from the default world's definitions and placed at a given density, at a drawn location
+ * or, for a share of them, at `random` for the map's seed to pick.
+ *
+ * Locations are generated in blocks of `kBlockSize` on a `ThreadPool`, and placements likewise. Every location and
+ * every placement draws from its own random stream, derived from the seed and its index, and the blocks are joined
+ * in order, so a seed always generates the same world whatever the number of threads.
+ *
+ * **Public Types**:
+ * - `DegreeDistribution`: How the number of paths a location opens is drawn.
+ * - `GeneratorOptions`: The size, seed, path shape, object densities, region size and thread count of a world.
+ *
+ * **Public Functions**:
+ * - `WorldSource GenerateWorld(const GeneratorOptions& options)`: Generates a world; throws `std::invalid_argument` for an empty one.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include "WorldCompiler.hpp"
+
+namespace chants
+{
+    enum class DegreeDistribution
+    {
+        Uniform,   // every location opens about meanDegree / 2 paths
+        Geometric, // most open one or two, a few open many
+        PowerLaw   // a long tail of hubs, as in a Pareto distribution with exponent 2.5
+    };
+
+    struct GeneratorOptions
+    {
+        static constexpr uint32_t kBlockSize = 4096;
+
+        uint32_t nodes = 100000;
+        uint64_t seed = 0;
+        DegreeDistribution degrees = DegreeDistribution::Uniform;
+        double meanDegree = 4;         // paths per location on average, counting both ends of each
+        uint32_t maxDegree = 32;       // paths one location opens at most; paths opened to it come on top
+        uint32_t locality = 64;        // how many ids below a location its nearby paths reach
+        double longRange = 0.02;       // share of the extra paths that may lead to any lower id
+        double assetDensity = 0.05;    // assets per location
+        double monsterDensity = 0.05;  // monsters per location
+        double randomPlacements = 0;   // share of objects placed at random when a map is built
+        uint32_t regionSize = 64;
+        unsigned threads = 0;          // 0 for one per hardware thread
+    };
+
+    WorldSource GenerateWorld(const GeneratorOptions &options);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file WorldGraph.hpp
+ * @brief Declaration of the WorldGraph class, the adjacency store for paths between game locations.
+ *
+ * The `WorldGraph` class keeps the paths of the game world in compressed-sparse-row (CSR) form: an array of
+ * per-node edge offsets and an array of 32-bit neighbor ids. The neighbors of a node are one contiguous slice
+ * of the target array, so walking them never chases pointers, ids stay valid however the nodes themselves are
+ * stored, and the whole graph costs two allocations no matter how many locations the world has.
+ *
+ * Edges are staged with `AddEdge` and packed into CSR form by `Finalize`. Neighbors keep the order in which
+ * their edges were added, so paths are listed to the player in the order the map author wrote them.
+ *
+ * A graph can also be a read-only view over CSR arrays that live elsewhere, such as a memory-mapped world file
+ * (see `View`). The arrays must outlive the graph; adding edges to a view copies the arrays first.
+ *
+ * **Public Methods**:
+ * - `WorldGraph(uint32_t nodeCount = 0)`: Constructor to initialize an empty graph with a number of nodes.
+ * - `static WorldGraph View(uint32_t nodeCount, const uint32_t *offsets, const uint32_t *targets)`: Wraps existing CSR arrays without copying them.
+ * - `static WorldGraph Packed(vector<uint32_t> offsets, vector<uint32_t> targets)`: Takes over CSR arrays packed elsewhere, such as by a world generator.
+ * - `void AddEdge(uint32_t from, uint32_t to)`: Stages a one-way path between two nodes, growing the node count if needed.
+ * - `void Finalize()`: Packs all staged edges into the CSR arrays.
+ * - `WorldGraph Reversed() const`: Returns a graph of the packed edges turned around, whose neighbors of a node are the nodes with a path to it.
+ * - `uint32_t NodeCount() const`: Returns the number of nodes in the graph.
+ * - `uint32_t EdgeCount() const`: Returns the number of packed edges.
+ * - `uint32_t Degree(uint32_t node) const`: Returns the number of paths leaving a node.
+ * - `NeighborRange Neighbors(uint32_t node) const`: Returns the ids of the nodes a node connects to.
+ * - `bool HasEdge(uint32_t from, uint32_t to) const`: Checks whether a path leads from one node to another.
+ * - `size_t MemoryUsage() const`: Returns the bytes the graph owns; a view owns none of its arrays.
+ *
+ * **Attributes**:
+ * - `_nodeCount`: The number of nodes in the graph.
+ * - `_offsets`: For each node, the index of its first neighbor in `_targets` (one extra entry closes the last node).
+ * - `_targets`: The neighbor ids of every node, stored back to back.
+ * - `_pending`: Edges added since the last `Finalize`.
+ * - `_offsetData`, `_targetData`: The CSR arrays in use, either the owned vectors above or borrowed memory.
+ * - `_packedNodes`, `_edgeCount`: The number of rows and edges in the CSR arrays in use.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using std::vector;
+
+namespace chants
+{
+    class WorldGraph
+    {
+    public:
+        /// @brief Read-only view over the neighbor ids of one node
+        class NeighborRange
+        {
+        public:
+            NeighborRange(const uint32_t *begin, const uint32_t *end) : _begin(begin), _end(end) {}
+            const uint32_t *begin() const { return _begin; }
+            const uint32_t *end() const { return _end; }
+            uint32_t size() const { return static_cast<uint32_t>(_end - _begin); }
+            bool empty() const { return _begin == _end; }
+            uint32_t operator[](uint32_t i) const { return _begin[i]; }
+
+        private:
+            const uint32_t *_begin;
+            const uint32_t *_end;
+        };
+
+        explicit WorldGraph(uint32_t nodeCount = 0);
+        WorldGraph(const WorldGraph &other);
+        WorldGraph &operator=(const WorldGraph &other);
+        WorldGraph(WorldGraph &&other) = default;
+        WorldGraph &operator=(WorldGraph &&other) = default;
+        static WorldGraph View(uint32_t nodeCount, const uint32_t *offsets, const uint32_t *targets);
+        static WorldGraph Packed(vector<uint32_t> offsets, vector<uint32_t> targets);
+        void AddEdge(uint32_t from, uint32_t to);
+        void Finalize();
+        WorldGraph Reversed() const;
+        uint32_t NodeCount() const;
+        uint32_t EdgeCount() const;
+        uint32_t Degree(uint32_t node) const;
+        NeighborRange Neighbors(uint32_t node) const;
+        bool HasEdge(uint32_t from, uint32_t to) const;
+        size_t MemoryUsage() const;
+
+    private:
+        uint32_t _nodeCount;
+        vector<uint32_t> _offsets;
+        vector<uint32_t> _targets;
+        vector<std::pair<uint32_t, uint32_t>> _pending;
+        const uint32_t *_offsetData;
+        const uint32_t *_targetData;
+        uint32_t _packedNodes;
+        uint32_t _edgeCount;
+
+        bool isView() const;
+        void usePackedVectors();
+    };
+}
@@ -0,0 +1,84 @@
+/**
+ * @file WorldState.hpp
+ * @brief Declaration of the WorldState class, live counts of the assets and monsters left in the world.
+ *
+ * An `AdventureGameMap` keeps one `WorldState`, and its nodes update it as objects are added and removed, the same
+ * way they keep the `ObjectIndex` current. It holds the number of assets and monsters at every location, one
+ * occupancy bit per location for each kind (set while the location holds at least one), and the world-wide totals,
+ * so "are all monsters defeated?" and "how many are left?" are answered without looking at a single node.
+ *
+ * In streaming mode most regions are not in memory, so the counts start from the world file's placements instead of
+ * from nodes, and only change when the player takes or defeats something: paging a region in or out moves no
+ * objects and leaves the counts alone.
+ *
+ * **Public Methods**:
+ * - `void Reset(uint32_t locationCount)`: Empties the counts for a world of `locationCount` locations.
+ * - `void AddAssets(uint32_t node, uint32_t count = 1)`, `void RemoveAssets(uint32_t node, uint32_t count = 1)`: Record assets placed at or taken from a location.
+ * - `void AddMonsters(uint32_t node, uint32_t count = 1)`, `void RemoveMonsters(uint32_t node, uint32_t count = 1)`: Record monsters placed at or removed from a location.
+ * - `uint64_t AssetsRemaining() const`, `uint64_t MonstersRemaining() const`: Return the number left in the world.
+ * - `uint32_t AssetsAt(uint32_t node) const`, `uint32_t MonstersAt(uint32_t node) const`: Return the number at a location.
+ * - `uint32_t LocationsWithAssets() const`, `uint32_t LocationsWithMonsters() const`: Return the number of locations holding any.
+ * - `uint32_t NextLocationWithAssets(uint32_t from) const`, `uint32_t NextLocationWithMonsters(uint32_t from) const`: Return the first location at or after `from` holding any, or `kNone`.
+ * - `const vector<uint64_t>& MonsterOccupancy() const`: Returns the monster occupancy bits, 64 locations per word.
+ * - `bool AllMonstersDefeated() const`: Checks whether no monster is left.
+ * - `size_t MemoryUsage() const`: Returns the bytes held by the counts and occupancy bits.
+ *
+ * **Attributes**:
+ * - `_assets`, `_monsters`: The per-location counts, occupancy bits and totals of each kind.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+namespace chants
+{
+    class WorldState
+    {
+    public:
+        static constexpr uint32_t kNone = UINT32_MAX;
+
+        void Reset(uint32_t locationCount);
+        void AddAssets(uint32_t node, uint32_t count = 1);
+        void RemoveAssets(uint32_t node, uint32_t count = 1);
+        void AddMonsters(uint32_t node, uint32_t count = 1);
+        void RemoveMonsters(uint32_t node, uint32_t count = 1);
+        uint64_t AssetsRemaining() const;
+        uint64_t MonstersRemaining() const;
+        uint32_t AssetsAt(uint32_t node) const;
+        uint32_t MonstersAt(uint32_t node) const;
+        uint32_t LocationsWithAssets() const;
+        uint32_t LocationsWithMonsters() const;
+        uint32_t NextLocationWithAssets(uint32_t from) const;
+        uint32_t NextLocationWithMonsters(uint32_t from) const;
+        const vector<uint64_t> &MonsterOccupancy() const;
+        bool AllMonstersDefeated() const;
+        size_t MemoryUsage() const;
+
+    private:
+        struct Tally
+        {
+            vector<uint32_t> count;    // objects at each location
+            vector<uint64_t> occupied; // one bit per location holding any
+            uint64_t total = 0;
+            uint32_t locations = 0;    // set bits in occupied
+
+            void reset(uint32_t locationCount);
+            void add(uint32_t node, uint32_t n);
+            void remove(uint32_t node, uint32_t n);
+            uint32_t next(uint32_t from) const;
+        };
+
+        Tally _assets;
+        Tally _monsters;
+    };
+}
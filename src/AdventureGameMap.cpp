@@ -8,12 +8,44 @@
  *
  * **Methods**:
  * - `AdventureGameMap()`: Constructor that initializes the game map and builds all nodes and their connections.
+ * - `AdventureGameMap(const WorldFile& world, unsigned seed)`: Constructor that builds the map from a compiled world file.
+ * - `AdventureGameMap(const WorldFile& world, const GameSnapshot& snapshot)`: Constructor that rebuilds a saved map from its world file.
+ * - `void buildLocations(const WorldFile& world, const vector<GameSnapshot::ObjectChange>& changes)`: Private method that creates the world's nodes and places its objects.
+ * - `void placeObjects(const WorldFile& world, const vector<GameSnapshot::ObjectChange>& changes)`: Private method that reserves one arena block for every placement, then places the world's assets and monsters where they start, then those a saved game changed.
+ * - `void placeObject(const WorldFile& world, const GameSnapshot::ObjectChange& object)`: Private method that creates one asset or monster in the arena and adds it to its node.
+ * - `AdventureGameMap(const WorldFile& world, unsigned seed, const StreamingOptions& streaming)`: Constructor that serves locations from a `RegionPager`.
+ * - `AdventureGameMap(const WorldFile& world, const GameSnapshot& snapshot, const StreamingOptions& streaming)`: Constructor that hands a saved game's changes to the `RegionPager`.
+ * - `uint32_t LocationCount() const`: Returns the number of locations.
+ * - `bool IsStreaming() const`: Checks whether locations come from a `RegionPager`.
+ * - `void SetFocus(uint32_t id)`: Moves the pager's focus to the player's location.
  * - `void buildMapNodes()`: Private method that defines the nodes (locations) and connects them.
+ * - `void bindLocations()`: Private method that attaches every node to this map's path graph.
  * - `vector<Node> GetLocations()`: Returns a list of all the game locations (nodes).
+ * - `Node *GetLocation(uint32_t id)`: Returns the location with the given id, or `nullptr`.
+ * - `Node *FindLocation(string_view name)`: Resolves a typed name to its symbol and looks the location up.
+ * - `Node *FindLocation(Symbol name)`: Looks a location up in the name index.
+ * - `bool ownsLocation(const Node* node) const`: Private method that tells the map's own nodes from copies.
+ * - `ObjectIndex *assetIndexOf(const Node* node)`, `ObjectIndex *monsterIndexOf(const Node* node)`: Private methods handing the object indexes to the map's own nodes.
+ * - `WorldState *worldStateOf(const Node* node)`: Private method handing the world state to the map's own nodes.
+ * - `void indexLocation(const Node& node)`, `void unindexLocation(const Node& node)`: Private methods that add or drop a location's index entries.
+ * - `const WorldGraph &GetGraph() const`: Returns the CSR graph holding every path.
+ * - `void AddPath(uint32_t from, uint32_t to)`: Adds a path to the graph and repacks it.
+ * - `void AddPaths(const vector<pair<uint32_t, uint32_t>>& paths)`: Stages every path in the graph, then repacks it once.
+ * - `const WorldState &GetWorldState() const`: Returns the live counts of assets and monsters.
+ * - `size_t MemoryUsage() const`: Adds up the nodes, objects, graph, indexes, counts, respawns and pager.
+ * - `void Save(GameSnapshot& snapshot) const`: Lists the waiting respawns, then finds the objects left through the occupied locations and compares them with where they started, or asks the pager.
+ * - `void SetRespawnDelay(uint32_t turns)`, `uint32_t GetRespawnDelay() const`: Set and return the respawn delay.
+ * - `void Advance(uint64_t turn)`: Advances the respawn wheel and respawns the monsters it fires, and with monster AI on moves the monsters after each turn's respawns.
+ * - `size_t PendingRespawns() const`: Returns the size of the respawn wheel.
+ * - `void SetMonsterAI(bool enabled, ThreadPool* pool)`, `const MonsterAI *GetMonsterAI() const`: Start the monster AI at the wheel's turn, or drop it, and return it.
+ * - `void restoreRespawns(const WorldFile& world, const GameSnapshot& snapshot)`: Private method that sets the wheel's clock to the saved turn and schedules the saved respawns in order.
+ * - `bool respawnsMonsters(const Node* node) const`: Private method checking for a delay, a world file and a node of the map's own.
+ * - `void retireMonster(Monster* monster, uint32_t node)`: Private method that schedules the placement and hands the monster to the pool, or to the pager in streaming mode.
+ * - `void respawn(uint32_t placement, uint64_t due)`: Private method that builds the monster again with a fight seeded from its starting one and the turn, or asks the pager.
  *
  * **Game World Setup**:
  * - Locations: Fuschia Village, Shell Town, Orange Town, Syrup Village, Baratie, Arlong Park, Loguetown.
- * - Each location has a description and is connected to other locations.
+ * - Each location has a description and is connected to other locations through the map's `WorldGraph`.
  *
  * @author Evan Aarons-Wood
  * @version 1.0
@@ -22,6 +54,8 @@
 
 
 #include <AdventureGameMap.hpp>
+#include <Tracer.hpp>
+#include <stdexcept>
 
 namespace chants
 {
@@ -51,66 +85,468 @@ namespace chants
         // Marine
     }
 
-    void AdventureGameMap::buildMapNodes()
+    AdventureGameMap::AdventureGameMap(const WorldFile &world, unsigned seed) : graph(world.Graph()), seed(seed), worldFile(&world)
+    {
+        buildLocations(world, {});
+    }
+
+    AdventureGameMap::AdventureGameMap(const WorldFile &world, const GameSnapshot &snapshot)
+        : graph(world.Graph()), seed(static_cast<unsigned>(snapshot.seed)), worldFile(&world)
+    {
+        snapshot.Check(world);
+        buildLocations(world, snapshot.changes);
+        restoreRespawns(world, snapshot);
+        if (snapshot.monsterAI)
+            monsterAI = std::make_unique<MonsterAI>(*this, world, seed, snapshot.turns);
+    }
+
+    AdventureGameMap::AdventureGameMap(const WorldFile &world, unsigned seed, const StreamingOptions &streaming)
+        : graph(world.Graph()), seed(seed), worldFile(&world)
     {
-        // build all nodes
-        Node fuschiaVillage(0, "Fuschia Village");
-        fuschiaVillage.SetDescription("A peaceful village where Luffy grew up, known for its windmill and friendly people.\n");
+        worldState.Reset(world.NodeCount()); // the pager counts the world file's placements
+        pager = std::make_unique<RegionPager>(world, this, seed, streaming);
+    }
+
+    AdventureGameMap::AdventureGameMap(const WorldFile &world, const GameSnapshot &snapshot, const StreamingOptions &streaming)
+        : graph(world.Graph()), seed(static_cast<unsigned>(snapshot.seed)), worldFile(&world)
+    {
+        snapshot.Check(world);
+        if (snapshot.monsterAI)
+            throw std::runtime_error("the saved game moves its monsters, which a streaming map cannot");
+        worldState.Reset(world.NodeCount());
+        pager = std::make_unique<RegionPager>(world, this, seed, streaming, snapshot.changes);
+        restoreRespawns(world, snapshot);
+    }
+
+    void AdventureGameMap::restoreRespawns(const WorldFile &world, const GameSnapshot &snapshot)
+    {
+        // the wheel reads the saved turn, so a respawn keeps the turn it was due on
+        respawnDelay = snapshot.respawnDelay;
+        respawns.Reset(snapshot.turns);
+        for (const GameSnapshot::Respawn &waiting : snapshot.respawns)
+        {
+            if (world.GetPlacement(waiting.placement).kind != WorldFile::PlacementKind::Monster)
+                throw std::runtime_error("the saved game respawns an object that is not a monster");
+            respawns.Schedule(waiting.placement, waiting.due);
+        }
+    }
 
-        Node shellTown(1, "Shell Town");
-        shellTown.SetDescription("A marine base town where Captain Morgan rules with an iron fist.\n");
+    void AdventureGameMap::buildLocations(const WorldFile &world, const vector<GameSnapshot::ObjectChange> &changes)
+    {
+        CHANTS_TRACE_SCOPE("build map");
+        uint32_t locationCount = world.NodeCount();
+        locations.reserve(locationCount);
+        for (uint32_t id = 0; id < locationCount; id++)
+        {
+            locations.emplace_back(id, string(world.NodeName(id)), string(world.NodeDescription(id)));
+        }
+        bindLocations();
+        placeObjects(world, changes);
+    }
 
-        Node orangeTown(2, "Orange Town");
-        orangeTown.SetDescription("A town terrorized by the pirate Buggy the Clown.\n");
+    void AdventureGameMap::placeObjects(const WorldFile &world, const vector<GameSnapshot::ObjectChange> &changes)
+    {
+        vector<uint32_t> nodes = world.ResolvePlacements(seed);
+        startingObjects.resize(nodes.size());
+        size_t monsterCount = 0;
+        for (uint32_t i = 0; i < nodes.size(); i++)
+        {
+            bool monster = world.GetPlacement(i).kind == WorldFile::PlacementKind::Monster;
+            startingObjects[i] = GameSnapshot::ObjectChange{i, nodes[i], monster ? MixSeed(seed, i) : 0}; // the same seed replays the same fights
+            monsterCount += monster;
+        }
+        objects.Reserve(ObjectArena::Footprint<Asset>(nodes.size() - monsterCount) + ObjectArena::Footprint<Monster>(monsterCount));
 
-        Node syrupVillage(3, "Syrup Village");
-        syrupVillage.SetDescription("A quiet village with a long nose boy dreaming of adventure.\n");
+        // objects a saved game changed are added after the others, in the order their locations listed them
+        vector<bool> changed(nodes.size());
+        for (const GameSnapshot::ObjectChange &change : changes)
+        {
+            changed[change.placement] = true;
+        }
+        for (const GameSnapshot::ObjectChange &object : startingObjects)
+        {
+            if (!changed[object.placement])
+                placeObject(world, object);
+        }
+        for (const GameSnapshot::ObjectChange &change : changes)
+        {
+            if (change.node != GameSnapshot::kGone)
+                placeObject(world, change);
+        }
+    }
 
-        Node baratie(4, "Baratie");
-        baratie.SetDescription("A floating restaurant on the sea, known for its delicious food and fierce chefs.\n");
+    void AdventureGameMap::placeObject(const WorldFile &world, const GameSnapshot::ObjectChange &object)
+    {
+        WorldFile::Placement placement = world.GetPlacement(object.placement);
+        if (placement.kind == WorldFile::PlacementKind::Asset)
+        {
+            WorldFile::AssetDef def = world.GetAsset(placement.object);
+            Asset *asset = objects.Create<Asset>(def.name, def.message, def.value, def.category);
+            asset->SetPlacement(object.placement);
+            locations[object.node].AddAsset(asset);
+        }
+        else
+        {
+            WorldFile::MonsterDef def = world.GetMonster(placement.object);
+            Monster *monster = objects.Create<Monster>(def.name, def.health, def.fightCoefficient);
+            monster->Seed(object.fightState);
+            monster->SetPlacement(object.placement);
+            locations[object.node].AddMonster(monster);
+        }
+    }
 
-        Node arlongPark(5, "Arlong Park");
-        arlongPark.SetDescription("A stronghold of the fish-man Arlong, who oppresses the nearby village.\n");
+    void AdventureGameMap::buildMapNodes()
+    {
+        CHANTS_TRACE_SCOPE("build map");
+        // node ids, which are also the index of each node in locations
+        enum : uint32_t
+        {
+            fuschiaVillage,
+            shellTown,
+            orangeTown,
+            syrupVillage,
+            baratie,
+            arlongPark,
+            loguetown,
+            locationCount
+        };
 
-        Node loguetown(6, "Loguetown");
-        loguetown.SetDescription("The town of beginnings and endings, where the Pirate King was born and executed.\n");
+        // build all nodes in the same order as the ids above
+        locations.reserve(locationCount);
+        locations.emplace_back(fuschiaVillage, "Fuschia Village", "A peaceful village where Luffy grew up, known for its windmill and friendly people.\n");
+        locations.emplace_back(shellTown, "Shell Town", "A marine base town where Captain Morgan rules with an iron fist.\n");
+        locations.emplace_back(orangeTown, "Orange Town", "A town terrorized by the pirate Buggy the Clown.\n");
+        locations.emplace_back(syrupVillage, "Syrup Village", "A quiet village with a long nose boy dreaming of adventure.\n");
+        locations.emplace_back(baratie, "Baratie", "A floating restaurant on the sea, known for its delicious food and fierce chefs.\n");
+        locations.emplace_back(arlongPark, "Arlong Park", "A stronghold of the fish-man Arlong, who oppresses the nearby village.\n");
+        locations.emplace_back(loguetown, "Loguetown", "The town of beginnings and endings, where the Pirate King was born and executed.\n");
 
         // connect nodes paths
-        fuschiaVillage.AddConnection(&shellTown);
-        fuschiaVillage.AddConnection(&orangeTown);
+        graph = WorldGraph(locationCount);
+        graph.AddEdge(fuschiaVillage, shellTown);
+        graph.AddEdge(fuschiaVillage, orangeTown);
+
+        graph.AddEdge(shellTown, fuschiaVillage);
+        graph.AddEdge(shellTown, syrupVillage);
 
-        shellTown.AddConnection(&fuschiaVillage);
-        shellTown.AddConnection(&syrupVillage);
+        graph.AddEdge(orangeTown, fuschiaVillage);
+        graph.AddEdge(orangeTown, baratie);
 
-        orangeTown.AddConnection(&fuschiaVillage);
-        orangeTown.AddConnection(&baratie);
+        graph.AddEdge(syrupVillage, shellTown);
+        graph.AddEdge(syrupVillage, baratie);
 
-        syrupVillage.AddConnection(&shellTown);
-        syrupVillage.AddConnection(&baratie);
+        graph.AddEdge(baratie, orangeTown);
+        graph.AddEdge(baratie, syrupVillage);
+        graph.AddEdge(baratie, arlongPark);
 
-        baratie.AddConnection(&orangeTown);
-        baratie.AddConnection(&syrupVillage);
-        baratie.AddConnection(&arlongPark);
+        graph.AddEdge(arlongPark, baratie);
+        graph.AddEdge(arlongPark, loguetown);
 
-        arlongPark.AddConnection(&baratie);
-        arlongPark.AddConnection(&loguetown);
+        graph.AddEdge(loguetown, arlongPark);
+        graph.Finalize();
 
-        loguetown.AddConnection(&arlongPark);
+        bindLocations();
+    }
 
-        // build map in same order as Node Ids above.
-        // The index of each node in the vector must match its id.
-        locations.push_back(fuschiaVillage);
-        locations.push_back(shellTown);
-        locations.push_back(orangeTown);
-        locations.push_back(syrupVillage);
-        locations.push_back(baratie);
-        locations.push_back(arlongPark);
-        locations.push_back(loguetown);
+    void AdventureGameMap::bindLocations()
+    {
+        worldState.Reset(static_cast<uint32_t>(locations.size()));
+        for (auto &location : locations)
+        {
+            location._map = this;
+            indexLocation(location);
+            uint32_t id = static_cast<uint32_t>(location._id);
+            worldState.AddAssets(id, static_cast<uint32_t>(location._assets.size()));
+            worldState.AddMonsters(id, static_cast<uint32_t>(location._monsters.size()));
+        }
+    }
+
+    bool AdventureGameMap::ownsLocation(const Node *node) const
+    {
+        uint32_t id = static_cast<uint32_t>(node->_id);
+        if (pager)
+            return pager->ResidentLocation(id) == node;
+        return id < locations.size() && &locations[id] == node;
+    }
+
+    ObjectIndex *AdventureGameMap::assetIndexOf(const Node *node)
+    {
+        return ownsLocation(node) ? &assetIndex : nullptr;
+    }
+
+    ObjectIndex *AdventureGameMap::monsterIndexOf(const Node *node)
+    {
+        return ownsLocation(node) ? &monsterIndex : nullptr;
+    }
+
+    WorldState *AdventureGameMap::worldStateOf(const Node *node)
+    {
+        return ownsLocation(node) ? &worldState : nullptr;
+    }
+
+    void AdventureGameMap::indexLocation(const Node &node)
+    {
+        uint32_t id = static_cast<uint32_t>(node._id);
+        locationIndex.emplace(node._name, id);
+        for (uint32_t slot = 0; slot < node._assets.size(); slot++)
+        {
+            assetIndex.Insert(id, node._assets[slot]->GetSymbol(), slot);
+        }
+        for (uint32_t slot = 0; slot < node._monsters.size(); slot++)
+        {
+            monsterIndex.Insert(id, node._monsters[slot]->GetSymbol(), slot);
+        }
+    }
+
+    void AdventureGameMap::unindexLocation(const Node &node)
+    {
+        uint32_t id = static_cast<uint32_t>(node._id);
+        auto found = locationIndex.find(node._name);
+        if (found != locationIndex.end() && found->second == id)
+            locationIndex.erase(found);
+        for (Asset *asset : node._assets)
+        {
+            assetIndex.Clear(id, asset->GetSymbol());
+        }
+        for (Monster *monster : node._monsters)
+        {
+            monsterIndex.Clear(id, monster->GetSymbol());
+        }
+    }
+
+    uint32_t AdventureGameMap::LocationCount() const
+    {
+        return pager ? graph.NodeCount() : static_cast<uint32_t>(locations.size());
+    }
+
+    bool AdventureGameMap::IsStreaming() const
+    {
+        return pager != nullptr;
+    }
+
+    void AdventureGameMap::SetFocus(uint32_t id)
+    {
+        focus = id;
+        if (pager)
+            pager->SetFocus(id);
     }
 
     vector<Node> AdventureGameMap::GetLocations()
     {
+        if (pager)
+            return pager->ResidentLocations();
         return locations;
     }
 
+    Node *AdventureGameMap::GetLocation(uint32_t id)
+    {
+        if (pager)
+            return pager->Find(id);
+        if (id >= locations.size())
+            return nullptr;
+        return &locations[id];
+    }
+
+    Node *AdventureGameMap::FindLocation(string_view name)
+    {
+        Symbol symbol = SymbolTable::Global().Find(name);
+        return symbol == kNoSymbol ? nullptr : FindLocation(symbol);
+    }
+
+    Node *AdventureGameMap::FindLocation(Symbol name)
+    {
+        auto found = locationIndex.find(name);
+        return found == locationIndex.end() ? nullptr : GetLocation(found->second);
+    }
+
+    const WorldGraph &AdventureGameMap::GetGraph() const
+    {
+        return graph;
+    }
+
+    void AdventureGameMap::AddPath(uint32_t from, uint32_t to)
+    {
+        if (pager || from >= locations.size() || to >= locations.size()) // a streamed graph is read-only
+            return;
+        graph.AddEdge(from, to);
+        graph.Finalize();
+    }
+
+    void AdventureGameMap::AddPaths(const vector<pair<uint32_t, uint32_t>> &paths)
+    {
+        if (pager) // a streamed graph is read-only
+            return;
+        bool added = false;
+        for (const auto &path : paths)
+        {
+            if (path.first >= locations.size() || path.second >= locations.size())
+                continue;
+            graph.AddEdge(path.first, path.second);
+            added = true;
+        }
+        // a repack costs the whole graph, so it is paid once for the batch
+        if (added)
+            graph.Finalize();
+    }
+
+    const WorldState &AdventureGameMap::GetWorldState() const
+    {
+        return worldState;
+    }
+
+    size_t AdventureGameMap::MemoryUsage() const
+    {
+        size_t bytes = sizeof(*this) + locations.capacity() * sizeof(Node) + objects.Capacity() + graph.MemoryUsage() - sizeof(graph) +
+                       assetIndex.MemoryUsage() - sizeof(assetIndex) + monsterIndex.MemoryUsage() - sizeof(monsterIndex) +
+                       worldState.MemoryUsage() - sizeof(worldState);
+        for (const Node &node : locations)
+        {
+            bytes += node.MemoryUsage() - sizeof(Node);
+        }
+        using IndexEntry = std::unordered_map<Symbol, uint32_t>::value_type;
+        bytes += locationIndex.size() * (sizeof(IndexEntry) + sizeof(void *)) + locationIndex.bucket_count() * sizeof(void *);
+        bytes += startingObjects.capacity() * sizeof(GameSnapshot::ObjectChange);
+        bytes += monsterPool.MemoryUsage() - sizeof(monsterPool) + respawns.MemoryUsage() - sizeof(respawns) +
+                 due.capacity() * sizeof(TimingWheel::Timer);
+        if (pager)
+            bytes += pager->MemoryUsage();
+        if (monsterAI)
+            bytes += monsterAI->MemoryUsage();
+        return bytes;
+    }
+
+    void AdventureGameMap::Save(GameSnapshot &snapshot) const
+    {
+        snapshot.nodeCount = graph.NodeCount();
+        snapshot.seed = seed;
+        snapshot.respawnDelay = respawnDelay;
+        snapshot.monsterAI = monsterAI != nullptr;
+        snapshot.respawns.clear();
+        vector<TimingWheel::Timer> waiting;
+        respawns.Pending(waiting);
+        for (const TimingWheel::Timer &timer : waiting)
+        {
+            snapshot.respawns.push_back(GameSnapshot::Respawn{timer.id, 0, timer.due});
+        }
+        if (pager)
+        {
+            pager->Save(snapshot);
+            return;
+        }
+
+        // only occupied locations hold objects, so the walk is as long as what is left
+        snapshot.placementCount = static_cast<uint32_t>(startingObjects.size());
+        snapshot.changes.clear();
+        vector<GameSnapshot::ObjectChange> left;
+        for (uint32_t node = worldState.NextLocationWithAssets(0); node != WorldState::kNone; node = worldState.NextLocationWithAssets(node + 1))
+        {
+            for (const Asset *asset : locations[node]._assets)
+            {
+                left.push_back(GameSnapshot::ObjectChange{asset->GetPlacement(), node, 0});
+            }
+        }
+        for (uint32_t node = worldState.NextLocationWithMonsters(0); node != WorldState::kNone; node = worldState.NextLocationWithMonsters(node + 1))
+        {
+            for (const Monster *monster : locations[node]._monsters)
+            {
+                left.push_back(GameSnapshot::ObjectChange{monster->GetPlacement(), node, monster->GetFightState()});
+            }
+        }
+        GameSnapshot::Compare(left, startingObjects, snapshot.changes);
+    }
+
+    void AdventureGameMap::SetRespawnDelay(uint32_t turns)
+    {
+        respawnDelay = turns;
+    }
+
+    uint32_t AdventureGameMap::GetRespawnDelay() const
+    {
+        return respawnDelay;
+    }
+
+    void AdventureGameMap::Advance(uint64_t turn)
+    {
+        if (!monsterAI)
+        {
+            respawns.Advance(turn, due);
+            for (const TimingWheel::Timer &timer : due)
+            {
+                respawn(timer.id, timer.due);
+            }
+            return;
+        }
+
+        // a turn's respawns come back before its monsters move, as in a game played turn by turn
+        for (uint64_t next = monsterAI->GetTurn() + 1; next <= turn; next++)
+        {
+            respawns.Advance(next, due);
+            for (const TimingWheel::Timer &timer : due)
+            {
+                respawn(timer.id, timer.due);
+            }
+            monsterAI->Advance(next);
+        }
+    }
+
+    size_t AdventureGameMap::PendingRespawns() const
+    {
+        return respawns.Size();
+    }
+
+    void AdventureGameMap::SetMonsterAI(bool enabled, ThreadPool *pool)
+    {
+        if (!enabled)
+        {
+            monsterAI.reset();
+            return;
+        }
+        if (!worldFile)
+            return;
+        if (pager)
+            throw std::runtime_error("monsters cannot move in a streaming map");
+        if (!monsterAI)
+            monsterAI = std::make_unique<MonsterAI>(*this, *worldFile, seed, respawns.Now());
+        monsterAI->SetPool(pool);
+    }
+
+    const MonsterAI *AdventureGameMap::GetMonsterAI() const
+    {
+        return monsterAI.get();
+    }
+
+    bool AdventureGameMap::respawnsMonsters(const Node *node) const
+    {
+        return respawnDelay > 0 && worldFile && ownsLocation(node);
+    }
+
+    void AdventureGameMap::retireMonster(Monster *monster, uint32_t node)
+    {
+        uint32_t placement = monster->GetPlacement();
+        if (placement == Monster::kNoPlacement)
+            return; // added by hand, not placed by the world file
+        respawns.Schedule(placement, respawns.Now() + respawnDelay);
+        if (pager)
+            pager->Release(monster, node);
+        else
+            monsterPool.Release(monster);
+    }
+
+    void AdventureGameMap::respawn(uint32_t placement, uint64_t due)
+    {
+        if (pager)
+        {
+            pager->Respawn(placement, due);
+            return;
+        }
+
+        // a fresh fight, but the same one whenever this monster respawns on this turn
+        const GameSnapshot::ObjectChange &start = startingObjects[placement];
+        WorldFile::MonsterDef def = worldFile->GetMonster(worldFile->GetPlacement(placement).object);
+        Monster *monster = monsterPool.Acquire(def.name, def.health, def.fightCoefficient);
+        monster->Seed(MixSeed(start.fightState, due));
+        monster->SetPlacement(placement);
+        locations[start.node].AddMonster(monster);
+    }
+
 }
@@ -3,21 +3,26 @@
  * @brief Implementation of the Asset class, representing in-game items.
  *
  * The `Asset` class defines the properties and behaviors of items in the game. These items can be collected by the player
- * and used in various ways. Assets have attributes like a name, description, value, and a flag indicating whether they are 
- * offensive (weapons) or not.
+ * and used in various ways. Assets have attributes like a name, description, value, and a category telling whether they are
+ * offensive (weapons), healing, navigation or passive.
  *
  * **Methods**:
- * - `Asset(string name, string message, int value, bool isOffensive)`: Constructor to initialize an asset with its name, description, value, and whether it is offensive.
- * - `string GetName() const`: Returns the name of the asset.
- * - `string GetMessage() const`: Returns the description or message associated with the asset.
+ * - `Asset(string_view name, string_view message, int value, AssetCategory category)`: Constructor to initialize an asset with its name, description, value, and category.
+ * - `Asset(string_view name, string_view message, int value, bool isOffensive)`: Makes an offensive or a passive asset.
+ * - `const string& GetName() const`: Returns the name of the asset.
+ * - `Symbol GetSymbol() const`: Returns the interned symbol of the asset's name.
+ * - `const string& GetMessage() const`: Returns the description or message associated with the asset.
  * - `int GetValue() const`: Returns the value of the asset.
+ * - `AssetCategory GetCategory() const`: Returns the category of the asset.
  * - `bool isOffensive() const`: Returns whether the asset is offensive (e.g., a weapon).
+ * - `uint32_t GetPlacement() const`, `void SetPlacement(uint32_t placement)`: Read and record the world file placement of the asset.
  *
  * **Attributes**:
- * - `_name`: The name of the asset.
- * - `_message`: The description or message about the asset.
+ * - `_name`: The symbol of the asset's name, interned when the asset is created.
+ * - `_message`: The symbol of the description or message about the asset, interned in the case-sensitive text table.
  * - `_value`: The value or effectiveness of the asset.
- * - `_isOffensive`: Whether the asset is offensive (used for combat).
+ * - `_category`: What the asset is for (offensive assets are used for combat).
+ * - `_placement`: The world file placement the asset was created for, `kNoPlacement` if none.
  * - `hasBeenUsed`: Tracks if the asset has been used.
  *
  * @author Evan Aarons Wood
@@ -30,17 +35,25 @@
 
 namespace chants
 {
-    Asset::Asset(string name, string message, int value, bool isOffensive)
-        : _name(name), _message(message), _value(value), _isOffensive(isOffensive), hasBeenUsed(false) {}
+    Asset::Asset(string_view name, string_view message, int value, AssetCategory category)
+        : _name(SymbolTable::Global().Intern(name)), _message(SymbolTable::Text().Intern(message)), _value(value), _category(category), _placement(kNoPlacement), hasBeenUsed(false) {}
 
-    string Asset::GetName() const
+    Asset::Asset(string_view name, string_view message, int value, bool isOffensive)
+        : Asset(name, message, value, isOffensive ? AssetCategory::Offensive : AssetCategory::Passive) {}
+
+    const string &Asset::GetName() const
+    {
+        return SymbolTable::Global().Name(_name);
+    }
+
+    Symbol Asset::GetSymbol() const
     {
         return _name;
     }
 
-    string Asset::GetMessage() const
+    const string &Asset::GetMessage() const
     {
-        return _message;
+        return SymbolTable::Text().Name(_message);
     }
 
     int Asset::GetValue() const
@@ -48,8 +61,23 @@ namespace chants
         return _value;
     }
 
+    AssetCategory Asset::GetCategory() const
+    {
+        return _category;
+    }
+
     bool Asset::isOffensive() const
     {
-        return _isOffensive;
+        return _category == AssetCategory::Offensive;
+    }
+
+    uint32_t Asset::GetPlacement() const
+    {
+        return _placement;
+    }
+
+    void Asset::SetPlacement(uint32_t placement)
+    {
+        _placement = placement;
     }
 }
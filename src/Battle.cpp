@@ -0,0 +1,42 @@
+/**
+ * @file Battle.cpp
+ * @brief Implementation of the battle rules.
+ *
+ * **Functions**:
+ * - `int WeaponBonus(const Asset* weapon)`: Returns the value of an offensive weapon, or 0.
+ * - `BattleOutcome CompareAttacks(int playerAttack, int monsterAttack)`: The higher attack wins; equal attacks draw.
+ * - `BattleReport ResolveBattle(Combatant& player, Combatant& monster, const Asset* weapon)`: Draws the player's attack, then the monster's, and compares them.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "Battle.hpp"
+
+namespace chants
+{
+    int WeaponBonus(const Asset *weapon)
+    {
+        return weapon && weapon->isOffensive() ? weapon->GetValue() : 0;
+    }
+
+    BattleOutcome CompareAttacks(int playerAttack, int monsterAttack)
+    {
+        if (playerAttack > monsterAttack)
+            return BattleOutcome::PlayerWins;
+        if (playerAttack < monsterAttack)
+            return BattleOutcome::MonsterWins;
+        return BattleOutcome::Draw;
+    }
+
+    BattleReport ResolveBattle(Combatant &player, Combatant &monster, const Asset *weapon)
+    {
+        BattleReport report;
+        report.playerAttack = player.Fight() + WeaponBonus(weapon);
+        report.monsterAttack = monster.Fight();
+        report.outcome = CompareAttacks(report.playerAttack, report.monsterAttack);
+        return report;
+    }
+}
@@ -0,0 +1,149 @@
+/**
+ * @file BattleSimulator.cpp
+ * @brief Implementation of the BattleSimulator class, the parallel Monte Carlo battle runner.
+ *
+ * Every worker slot of the `ThreadPool` keeps its own counts and quantile histograms, `FightTable::kSize` entries
+ * per side; a block of fights only touches its slot's totals, and the slots are summed once all blocks are done.
+ *
+ * **Methods**:
+ * - `BattleSimulator(const Combatant& player, const Combatant& monster, const Asset* weapon)`: Reads the fight tables and weapon bonus.
+ * - `SimulationResult Run(const SimulationOptions& options) const`: Runs the blocks of fights on a thread pool and merges the slots.
+ * - `SimulationResult::WinRate()`, `DrawRate()`, `LossRate()`: Return the share of fights with each outcome.
+ * - `FightHistogram::Mean()`, `Deviation()`, `Percentile()`: Summarize the fights drawn, weighting each quantile's value by its count.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "BattleSimulator.hpp"
+#include "Battle.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace chants
+{
+    BattleSimulator::BattleSimulator(const Combatant &player, const Combatant &monster, const Asset *weapon)
+        : _playerTable(&player.GetFightTable()), _monsterTable(&monster.GetFightTable()), _weaponBonus(WeaponBonus(weapon))
+    {
+    }
+
+    SimulationResult BattleSimulator::Run(const SimulationOptions &options) const
+    {
+        const int32_t *playerValues = _playerTable->Values();
+        const int32_t *monsterValues = _monsterTable->Values();
+
+        ThreadPool pool(options.threads);
+        vector<SimulationResult> slots(pool.Size());
+        for (SimulationResult &slot : slots)
+        {
+            slot.playerFightValues.counts.assign(FightTable::kSize, 0);
+            slot.monsterFightValues.counts.assign(FightTable::kSize, 0);
+        }
+
+        uint64_t blocks = (options.fights + kBlockSize - 1) / kBlockSize;
+        pool.ParallelFor(blocks, [&](uint64_t block, unsigned slotIndex) {
+            SimulationResult &slot = slots[slotIndex];
+            FightEngine rng(MixSeed(options.seed, block));
+            uint64_t fights = std::min(kBlockSize, options.fights - block * kBlockSize);
+            uint64_t wins = 0;
+            uint64_t draws = 0;
+            for (uint64_t i = 0; i < fights; i++)
+            {
+                // the same quantiles FightTable::Sample picks, counted by quantile
+                uint64_t playerQuantile = rng() >> (64 - FightTable::kBits);
+                uint64_t monsterQuantile = rng() >> (64 - FightTable::kBits);
+                slot.playerFightValues.counts[playerQuantile]++;
+                slot.monsterFightValues.counts[monsterQuantile]++;
+                BattleOutcome outcome = CompareAttacks(playerValues[playerQuantile] + _weaponBonus, monsterValues[monsterQuantile]);
+                wins += outcome == BattleOutcome::PlayerWins;
+                draws += outcome == BattleOutcome::Draw;
+            }
+            slot.fights += fights;
+            slot.playerWins += wins;
+            slot.draws += draws;
+            slot.monsterWins += fights - wins - draws;
+        });
+
+        SimulationResult result;
+        result.weaponBonus = _weaponBonus;
+        result.playerFightValues.values.assign(playerValues, playerValues + FightTable::kSize);
+        result.monsterFightValues.values.assign(monsterValues, monsterValues + FightTable::kSize);
+        result.playerFightValues.counts.assign(FightTable::kSize, 0);
+        result.monsterFightValues.counts.assign(FightTable::kSize, 0);
+        for (const SimulationResult &slot : slots)
+        {
+            result.fights += slot.fights;
+            result.playerWins += slot.playerWins;
+            result.draws += slot.draws;
+            result.monsterWins += slot.monsterWins;
+            for (uint32_t quantile = 0; quantile < FightTable::kSize; quantile++)
+            {
+                result.playerFightValues.counts[quantile] += slot.playerFightValues.counts[quantile];
+                result.monsterFightValues.counts[quantile] += slot.monsterFightValues.counts[quantile];
+            }
+        }
+        return result;
+    }
+
+    double SimulationResult::WinRate() const
+    {
+        return fights ? static_cast<double>(playerWins) / fights : 0.0;
+    }
+
+    double SimulationResult::DrawRate() const
+    {
+        return fights ? static_cast<double>(draws) / fights : 0.0;
+    }
+
+    double SimulationResult::LossRate() const
+    {
+        return fights ? static_cast<double>(monsterWins) / fights : 0.0;
+    }
+
+    double FightHistogram::Mean() const
+    {
+        double sum = 0.0;
+        double count = 0.0;
+        for (size_t quantile = 0; quantile < counts.size(); quantile++)
+        {
+            sum += static_cast<double>(values[quantile]) * counts[quantile];
+            count += counts[quantile];
+        }
+        return count > 0 ? sum / count : 0.0;
+    }
+
+    double FightHistogram::Deviation() const
+    {
+        double mean = Mean();
+        double squares = 0.0;
+        double count = 0.0;
+        for (size_t quantile = 0; quantile < counts.size(); quantile++)
+        {
+            double offset = values[quantile] - mean;
+            squares += offset * offset * counts[quantile];
+            count += counts[quantile];
+        }
+        return count > 0 ? std::sqrt(squares / count) : 0.0;
+    }
+
+    int FightHistogram::Percentile(double fraction) const
+    {
+        uint64_t count = 0;
+        for (uint64_t n : counts)
+        {
+            count += n;
+        }
+        uint64_t target = static_cast<uint64_t>(std::ceil(fraction * count));
+        uint64_t seen = 0;
+        for (size_t quantile = 0; quantile < counts.size(); quantile++)
+        {
+            seen += counts[quantile];
+            if (seen >= target && seen > 0)
+                return values[quantile]; // the values ascend, so this is the first value reaching the target
+        }
+        return values.empty() ? 0 : values.back();
+    }
+}
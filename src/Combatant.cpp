@@ -7,15 +7,23 @@
  * the combatant's name and health.
  *
  * **Methods**:
- * - `Combatant(string name, int health, int fightCoefficient)`: Constructor to initialize the combatant with a name, health, and fight coefficient.
- * - `string GetName()`: Returns the name of the combatant.
- * - `int GetHealth()`: Returns the health of the combatant.
- * - `int Fight()`: Calculates and returns the combatant's fight value based on the fight coefficient. It simulates multiple attack values and returns the average.
+ * - `Combatant(string_view name, int health, int fightCoefficient)`: Constructor to initialize the combatant with a name, health, and fight coefficient.
+ * - `const string& GetName() const`: Returns the name of the combatant.
+ * - `Symbol GetSymbol() const`: Returns the interned symbol of the combatant's name.
+ * - `int GetHealth() const`: Returns the health of the combatant.
+ * - `void SetHealth(int health)`: Sets the health of the combatant.
+ * - `uint64_t GetFightState() const`: Recovers the random engine's state by undoing one step of a copy.
+ * - `int Fight()`: Returns the combatant's fight value: the average of as many draws as the fight coefficient, sampled in one step from the coefficient's `FightTable`.
+ * - `void Seed(uint64_t seed)`: Reseeds the combatant's random engine.
+ * - `uint64_t MixSeed(uint64_t seed, uint64_t stream)`: Derives the seed of one stream with splitmix64.
+ * - `const FightTable& GetFightTable() const`: Returns the shared distribution of the combatant's fight values.
  *
  * **Attributes**:
- * - `_name`: The name of the combatant.
+ * - `_name`: The symbol of the combatant's name, interned when the combatant is created.
  * - `_health`: The health of the combatant, representing their vitality.
  * - `_fightCoefficient`: A coefficient that influences the combatant's attack value.
+ * - `_fightTable`: The shared distribution of fight values for the coefficient.
+ * - `_rng`: The combatant's own random engine.
  *
  * @author Evan Aarons Wood
  * @version 1.0
@@ -24,39 +32,85 @@
 
 
 #include <Combatant.hpp>
-#include <time.h>
+#include <atomic>
 using namespace std;
 
 namespace chants
 {
-    Combatant::Combatant(string name, int health, int fightCoefficient)
+    // splitmix64 of the seed stepped once per stream, so neighbouring streams do not start on correlated sequences
+    uint64_t MixSeed(uint64_t seed, uint64_t stream)
     {
-        _name = name;
+        uint64_t z = seed + (stream + 1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // a different seed for every combatant: a random starting point and a counter
+    static uint64_t nextSeed()
+    {
+        static const uint64_t start = std::random_device{}();
+        static std::atomic<uint64_t> counter(0);
+        return MixSeed(start, counter.fetch_add(1, std::memory_order_relaxed));
+    }
+
+    Combatant::Combatant(string_view name, int health, int fightCoefficient)
+    {
+        _name = SymbolTable::Global().Intern(name);
         _health = health;
         _fightCoefficient = fightCoefficient;
+        _fightTable = &FightTable::For(fightCoefficient);
+        _rng.seed(nextSeed());
     }
 
-    string Combatant::GetName()
+    const string &Combatant::GetName() const
+    {
+        return SymbolTable::Global().Name(_name);
+    }
+
+    Symbol Combatant::GetSymbol() const
     {
         return _name;
     }
 
-    int Combatant::GetHealth()
+    int Combatant::GetHealth() const
     {
         return _health;
     }
 
-    /// @brief Average fight value over several interations
-    /// @return
-    int Combatant::Fight()
+    void Combatant::SetHealth(int health)
+    {
+        _health = health;
+    }
+
+    // the engine only shows its next output, so step a copy once and undo the step: x = (x' - c) / a mod 2^64
+    uint64_t Combatant::GetFightState() const
     {
-        int subTotal = 0;
-        srand(time(nullptr));
-        for (int i = 0; i < _fightCoefficient; i++)
+        constexpr uint64_t a = FightEngine::multiplier;
+        constexpr uint64_t c = FightEngine::increment;
+        uint64_t inverse = a; // Newton's iteration doubles the correct low bits each step: 3, 6, 12, 24, 48, 96
+        for (int i = 0; i < 5; i++)
         {
-            subTotal += rand() % _fightCoefficient;
+            inverse *= 2 - a * inverse;
         }
-        float Total = subTotal / _fightCoefficient;
-        return (int)Total;
+        FightEngine next = _rng;
+        return (next() - c) * inverse;
+    }
+
+    /// @brief Average fight value over several interations, drawn in one step from the precomputed distribution
+    /// @return
+    int Combatant::Fight()
+    {
+        return _fightTable->Sample(_rng());
+    }
+
+    void Combatant::Seed(uint64_t seed)
+    {
+        _rng.seed(seed);
+    }
+
+    const FightTable &Combatant::GetFightTable() const
+    {
+        return *_fightTable;
     }
 }
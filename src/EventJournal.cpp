@@ -0,0 +1,363 @@
+/**
+ * @file EventJournal.cpp
+ * @brief Implementation of the EventJournal class, an append-only log of everything that changes a game.
+ *
+ * The game and the writer share only the queue: `Append` pushes under the mutex and wakes the writer, which waits
+ * for the first event, then up to `syncInterval` for more, and takes the whole queue at once. A batch is checksummed
+ * and written with one `write` and one `fdatasync`, however many turns it spans. Compaction runs on the writer too,
+ * so folding events into the snapshot costs the game nothing but the events queuing a little longer meanwhile.
+ *
+ * Every step that replaces a file is ordered so a crash between any two of them recovers the same game: the new
+ * snapshot is written to a temporary file, synced and renamed over the old one before the journal is emptied, and
+ * the events it folded in are skipped by their sequence numbers until then. A new journal writes its snapshot with
+ * a new generation before emptying the journal, so events from an earlier game are never applied to it.
+ *
+ * **Methods**:
+ * - `EventJournal(const string& path, const WorldFile& world, const PlayerProfile& player, const GameSnapshot& start, const JournalOptions& options)`: Keeps the profile, writes the starting snapshot, creates the journal and starts the writer.
+ * - `~EventJournal()`: Stops the writer once the queue is written.
+ * - `void Append(GameEvent event)`: Numbers the event and queues it; throws `std::runtime_error` if the writer has failed.
+ * - `void Sync()`: Wakes the writer and waits until it has written everything appended.
+ * - `JournalStats Stats() const`: Reads the counters under the mutex.
+ * - `static bool Exists(const string& path)`: Checks for the snapshot file.
+ * - `static GameSnapshot Recover(const string& path, const WorldFile& world, const PlayerProfile& player)`: Reads the snapshot, then the events after it up to the first torn, corrupt or missing one, and folds them in.
+ * - `static void Fold(GameSnapshot& snapshot, const vector<GameEvent>& events, const WorldFile& world, const PlayerProfile& player)`: Restores a streaming map (a whole one if the monsters move), a player built from the profile and an engine from the snapshot, applies the events and saves them back.
+ * - `void writerLoop()`: Private method that batches, writes, syncs and compacts until stopped.
+ * - `void writeSnapshot()`: Private method that replaces the snapshot file through a synced temporary file.
+ * - `void resetJournal()`: Private method that truncates the journal to its header.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "EventJournal.hpp"
+#include "AdventureGameMap.hpp"
+#include "GameEngine.hpp"
+#include "GameIO.hpp"
+#include "Player.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace chants
+{
+    static_assert(sizeof(GameEvent) % 8 == 0 && sizeof(EventJournal::JournalHeader) % 8 == 0,
+                  "journal records must follow each other without padding");
+
+    // FNV-1a over the event without its checksum
+    static uint64_t eventChecksum(const GameEvent &event)
+    {
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&event);
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < offsetof(GameEvent, checksum); i++)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    static string ioError(const string &what, const string &path)
+    {
+        return what + " " + path + ": " + std::strerror(errno);
+    }
+
+    static void writeAll(int fd, const void *data, size_t size, const string &path)
+    {
+        const char *at = static_cast<const char *>(data);
+        while (size > 0)
+        {
+            ssize_t written = ::write(fd, at, size);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw std::runtime_error(ioError("failed writing", path));
+            }
+            at += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+
+    // a renamed or created file survives a crash only once its directory is synced
+    static void syncDirectory(const string &path)
+    {
+        size_t slash = path.find_last_of('/');
+        string directory = slash == string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::runtime_error(ioError("cannot open directory", directory));
+        ::fsync(fd);
+        ::close(fd);
+    }
+
+    static bool readWholeFile(const string &path, string &data)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return false;
+        std::ostringstream text;
+        text << in.rdbuf();
+        data = text.str();
+        return true;
+    }
+
+    EventJournal::EventJournal(const string &path, const WorldFile &world, const PlayerProfile &player, const GameSnapshot &start,
+                               const JournalOptions &options)
+        : _path(path), _world(world), _player(player), _options(options), _fd(-1), _base(start), _baseSequence(0), _appended(0), _written(0),
+          _syncRequested(false), _stop(false), _syncs(0), _compactions(0)
+    {
+        _generation = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+        writeSnapshot(); // before the journal is emptied, so a crash in between leaves the old journal unread
+
+        _fd = ::open(_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+        if (_fd < 0)
+            throw std::runtime_error(ioError("cannot write journal", _path));
+        JournalHeader header{};
+        std::memcpy(header.magic, kJournalMagic, sizeof(header.magic));
+        header.version = kVersion;
+        header.generation = _generation;
+        try
+        {
+            writeAll(_fd, &header, sizeof(header), _path);
+            if (::fdatasync(_fd) != 0)
+                throw std::runtime_error(ioError("failed syncing", _path));
+            syncDirectory(_path);
+        }
+        catch (...)
+        {
+            ::close(_fd);
+            throw;
+        }
+        _writer = std::thread(&EventJournal::writerLoop, this);
+    }
+
+    EventJournal::~EventJournal()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_one();
+        _writer.join();
+        ::close(_fd);
+    }
+
+    void EventJournal::Append(GameEvent event)
+    {
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_error.empty())
+                throw std::runtime_error("the journal stopped: " + _error);
+            event.sequence = ++_appended;
+            _queue.push_back(event);
+            wake = _queue.size() == 1 || _queue.size() >= _options.batchEvents;
+        }
+        if (wake)
+            _wake.notify_one();
+    }
+
+    void EventJournal::Sync()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _syncRequested = true;
+        _wake.notify_one();
+        _synced.wait(lock, [&] { return _written >= _appended || !_error.empty(); });
+        if (!_error.empty())
+            throw std::runtime_error("the journal stopped: " + _error);
+    }
+
+    JournalStats EventJournal::Stats() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        JournalStats stats;
+        stats.appended = _appended;
+        stats.written = _written;
+        stats.syncs = _syncs;
+        stats.compactions = _compactions;
+        return stats;
+    }
+
+    bool EventJournal::Exists(const string &path)
+    {
+        struct stat info;
+        return ::stat((path + ".snap").c_str(), &info) == 0;
+    }
+
+    GameSnapshot EventJournal::Recover(const string &path, const WorldFile &world, const PlayerProfile &player)
+    {
+        string data;
+        SnapshotHeader snapshotHeader;
+        if (!readWholeFile(path + ".snap", data))
+            throw std::runtime_error("cannot open journal snapshot " + path + ".snap");
+        if (data.size() < sizeof(snapshotHeader))
+            throw std::runtime_error("journal snapshot is truncated");
+        std::memcpy(&snapshotHeader, data.data(), sizeof(snapshotHeader));
+        if (std::memcmp(snapshotHeader.magic, kSnapshotMagic, sizeof(snapshotHeader.magic)) != 0 || snapshotHeader.version != kVersion)
+            throw std::runtime_error("not a journal snapshot");
+        GameSnapshot snapshot = GameSnapshot::Decode(string_view(data).substr(sizeof(snapshotHeader)));
+        snapshot.Check(world);
+
+        // the events after the snapshot, up to the last one written whole
+        vector<GameEvent> events;
+        JournalHeader journalHeader;
+        if (readWholeFile(path, data) && data.size() >= sizeof(journalHeader))
+        {
+            std::memcpy(&journalHeader, data.data(), sizeof(journalHeader));
+            bool current = std::memcmp(journalHeader.magic, kJournalMagic, sizeof(journalHeader.magic)) == 0 &&
+                           journalHeader.version == kVersion && journalHeader.generation == snapshotHeader.generation;
+            uint64_t next = snapshotHeader.sequence + 1;
+            for (size_t at = sizeof(journalHeader); current && at + sizeof(GameEvent) <= data.size(); at += sizeof(GameEvent))
+            {
+                GameEvent event;
+                std::memcpy(&event, data.data() + at, sizeof(event));
+                if (event.checksum != eventChecksum(event))
+                    break; // torn by a crash
+                if (event.sequence < next)
+                    continue; // already folded into the snapshot
+                if (event.sequence != next)
+                    break;
+                events.push_back(event);
+                next++;
+            }
+        }
+        Fold(snapshot, events, world, player);
+        return snapshot;
+    }
+
+    void EventJournal::Fold(GameSnapshot &snapshot, const vector<GameEvent> &events, const WorldFile &world, const PlayerProfile &profile)
+    {
+        if (events.empty())
+            return;
+
+        // a streaming map pages in only the regions the events touch, whatever the size of the world; monsters that
+        // move need the whole map
+        StreamingOptions options;
+        options.prefetch = false;
+        std::unique_ptr<AdventureGameMap> held = snapshot.monsterAI ? std::make_unique<AdventureGameMap>(world, snapshot)
+                                                                    : std::make_unique<AdventureGameMap>(world, snapshot, options);
+        AdventureGameMap &map = *held;
+        Player player(profile); // the snapshot restores what changed; the name and fight coefficient are the profile's
+        player.Restore(snapshot, world);
+        NullOutput out;
+        GameEngine engine(map, player, out, snapshot.position);
+        engine.Restore(snapshot);
+        for (const GameEvent &event : events)
+        {
+            engine.Apply(event);
+        }
+        engine.Save(snapshot);
+    }
+
+    void EventJournal::writerLoop()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        vector<GameEvent> batch;
+        while (true)
+        {
+            // the first event starts the interval; a full batch, a sync or stopping cuts it short
+            _wake.wait(lock, [&] { return _stop || !_queue.empty(); });
+            _wake.wait_for(lock, std::chrono::milliseconds(_options.syncInterval),
+                           [&] { return _stop || _syncRequested || _queue.size() >= _options.batchEvents; });
+            if (_queue.empty() && _stop)
+                break;
+            batch.clear();
+            batch.swap(_queue);
+            _syncRequested = false;
+            lock.unlock();
+
+            string error;
+            bool compacted = false;
+            try
+            {
+                for (GameEvent &event : batch)
+                {
+                    event.checksum = eventChecksum(event);
+                }
+                writeAll(_fd, batch.data(), batch.size() * sizeof(GameEvent), _path);
+                if (::fdatasync(_fd) != 0)
+                    throw std::runtime_error(ioError("failed syncing", _path));
+
+                _unfolded.insert(_unfolded.end(), batch.begin(), batch.end());
+                if (_unfolded.size() >= _options.compactAfter)
+                {
+                    Fold(_base, _unfolded, _world, _player);
+                    _baseSequence = _unfolded.back().sequence;
+                    _unfolded.clear();
+                    writeSnapshot();
+                    resetJournal();
+                    compacted = true;
+                }
+            }
+            catch (const std::exception &e)
+            {
+                error = e.what();
+            }
+
+            lock.lock();
+            _syncs++;
+            _compactions += compacted;
+            if (error.empty())
+                _written = batch.back().sequence;
+            else if (_error.empty())
+            {
+                _error = error;
+                _queue.clear(); // nothing more is written once the journal is in doubt
+            }
+            _synced.notify_all();
+            if (!_error.empty())
+            {
+                _wake.wait(lock, [&] { return _stop; });
+                break;
+            }
+        }
+    }
+
+    void EventJournal::writeSnapshot()
+    {
+        SnapshotHeader header{};
+        std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+        header.version = kVersion;
+        header.generation = _generation;
+        header.sequence = _baseSequence;
+        string encoded;
+        _base.Encode(encoded);
+
+        string target = _path + ".snap";
+        string temporary = target + ".tmp";
+        int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+            throw std::runtime_error(ioError("cannot write journal snapshot", temporary));
+        try
+        {
+            writeAll(fd, &header, sizeof(header), temporary);
+            writeAll(fd, encoded.data(), encoded.size(), temporary);
+            if (::fsync(fd) != 0)
+                throw std::runtime_error(ioError("failed syncing", temporary));
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+        if (::rename(temporary.c_str(), target.c_str()) != 0)
+            throw std::runtime_error(ioError("cannot replace", target));
+        syncDirectory(target);
+    }
+
+    void EventJournal::resetJournal()
+    {
+        if (::ftruncate(_fd, sizeof(JournalHeader)) != 0 || ::fdatasync(_fd) != 0)
+            throw std::runtime_error(ioError("cannot empty journal", _path));
+    }
+}
@@ -0,0 +1,128 @@
+/**
+ * @file FightTable.cpp
+ * @brief Implementation of the FightTable class, the precomputed distribution of fight values.
+ *
+ * The exact distribution is found by convolving the uniform distribution with itself `coefficient` times, keeping a
+ * running window sum so each step is linear in the number of possible totals, then grouping the totals into fight
+ * values. The quantile table is read off the cumulative distribution.
+ *
+ * **Methods**:
+ * - `FightTable(int coefficient)`: Computes the probability of every fight value and fills the quantiles.
+ * - `static const FightTable& For(int coefficient)`: Looks the coefficient up in a cache guarded by a mutex.
+ * - `int Coefficient() const`: Returns the coefficient.
+ * - `const int32_t *Values() const`: Returns the quantiles.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "FightTable.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace chants
+{
+    // probability of each fight value floor(total / n), where total is the sum of n draws from [0, n)
+    static std::vector<double> exactDistribution(int n)
+    {
+        std::vector<double> totals(1, 1.0);
+        for (int draw = 0; draw < n; draw++)
+        {
+            std::vector<double> next(totals.size() + n - 1, 0.0);
+            double window = 0.0;
+            for (size_t total = 0; total < next.size(); total++)
+            {
+                if (total < totals.size())
+                    window += totals[total];
+                if (total >= static_cast<size_t>(n) && total - n < totals.size())
+                    window -= totals[total - n];
+                next[total] = window / n;
+            }
+            totals.swap(next);
+        }
+
+        std::vector<double> values(n, 0.0);
+        for (size_t total = 0; total < totals.size(); total++)
+        {
+            values[total / n] += totals[total];
+        }
+        return values;
+    }
+
+    // the same distribution approximated by a normal with matching mean and variance, for large n
+    static std::vector<double> normalDistribution(int n, int &first)
+    {
+        double mean = (n - 1) / 2.0;
+        double deviation = std::sqrt((static_cast<double>(n) * n - 1) / (12.0 * n));
+        first = std::max(0, static_cast<int>(std::floor(mean - 10 * deviation)));
+        int last = std::min(n - 1, static_cast<int>(std::ceil(mean + 10 * deviation)));
+
+        auto below = [&](double x) { return 0.5 * std::erfc(-(x - mean) / (deviation * std::sqrt(2.0))); };
+        std::vector<double> values;
+        for (int value = first; value <= last; value++)
+        {
+            values.push_back(below(value + 1.0) - below(value));
+        }
+        return values;
+    }
+
+    FightTable::FightTable(int coefficient) : _coefficient(coefficient)
+    {
+        if (coefficient <= 1)
+        {
+            _values.fill(0); // a coefficient of 1 always averages 0, and anything lower cannot fight at all
+            return;
+        }
+
+        int first = 0;
+        std::vector<double> values = coefficient <= kExactLimit ? exactDistribution(coefficient)
+                                                                : normalDistribution(coefficient, first);
+
+        double total = 0.0;
+        for (double p : values)
+        {
+            total += p;
+        }
+
+        // quantile i holds the value whose cumulative probability first reaches the middle of slice i
+        double cumulative = values[0] / total;
+        size_t value = 0;
+        for (uint32_t i = 0; i < kSize; i++)
+        {
+            double target = (i + 0.5) / kSize;
+            while (cumulative < target && value + 1 < values.size())
+            {
+                cumulative += values[++value] / total;
+            }
+            _values[i] = static_cast<int32_t>(first + value);
+        }
+    }
+
+    const FightTable &FightTable::For(int coefficient)
+    {
+        static std::mutex mutex;
+        static std::unordered_map<int, std::unique_ptr<FightTable>> tables;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unique_ptr<FightTable> &table = tables[coefficient];
+        if (!table)
+            table = std::make_unique<FightTable>(coefficient);
+        return *table;
+    }
+
+    int FightTable::Coefficient() const
+    {
+        return _coefficient;
+    }
+
+    const int32_t *FightTable::Values() const
+    {
+        return _values.data();
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file FrameRenderer.cpp
+ * @brief Implementation of the FrameRenderer class, an output sink that sends each turn's text in a single write.
+ *
+ * **Methods**:
+ * - `FrameRenderer(int fd, bool color)`: Reserves the frame buffer.
+ * - `~FrameRenderer()`: Writes whatever is left of the last frame.
+ * - `static bool IsTerminal(int fd)`: Asks `isatty`.
+ * - `void Write(string_view text)`: Appends to the frame.
+ * - `void Flush()`: Writes the frame, retrying after signals and partial writes, and empties it; throws `std::runtime_error` if the write fails.
+ * - `bool UsesColor() const`, `size_t Pending() const`, `uint64_t Frames() const`: Report on the renderer.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "FrameRenderer.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace chants
+{
+    FrameRenderer::FrameRenderer(int fd, bool color) : _fd(fd), _color(color), _frames(0)
+    {
+        _frame.reserve(kInitialCapacity);
+    }
+
+    FrameRenderer::~FrameRenderer()
+    {
+        try
+        {
+            Flush();
+        }
+        catch (const std::exception &)
+        {
+            // nowhere left to report it; the reader has gone
+        }
+    }
+
+    bool FrameRenderer::IsTerminal(int fd)
+    {
+        return ::isatty(fd) == 1;
+    }
+
+    void FrameRenderer::Write(string_view text)
+    {
+        _frame.append(text);
+    }
+
+    void FrameRenderer::Flush()
+    {
+        if (_frame.empty())
+            return;
+        const char *data = _frame.data();
+        size_t left = _frame.size();
+        while (left > 0)
+        {
+            ssize_t written = ::write(_fd, data, left);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                _frame.clear();
+                throw std::runtime_error(string("cannot write game output: ") + std::strerror(errno));
+            }
+            data += written;
+            left -= static_cast<size_t>(written);
+        }
+        _frame.clear(); // keeps the capacity for the next frame
+        _frames++;
+    }
+
+    bool FrameRenderer::UsesColor() const
+    {
+        return _color;
+    }
+
+    size_t FrameRenderer::Pending() const
+    {
+        return _frame.size();
+    }
+
+    uint64_t FrameRenderer::Frames() const
+    {
+        return _frames;
+    }
+}
@@ -0,0 +1,453 @@
+/**
+ * @file GameEngine.cpp
+ * @brief Implementation of the GameEngine class, the game loop driven one command line at a time.
+ *
+ * The text is the same, character for character, as the interactive loop it replaces; only where it goes changed.
+ * Each turn's text is flushed to the sink in one piece when the turn is over. A turn ends by checking for victory
+ * and describing the location again, except after viewing the inventory (which describes it straight away) and
+ * between attacking and choosing a weapon (which waits for the weapon line).
+ *
+ * With `CHANTS_METRICS` defined, every turn is timed as the kind of command its first word names, apart from the
+ * flush, which is timed as rendering; battles and the waits for input are timed too (see `Metrics.hpp`). While a
+ * trace runs, the same turns and flushes are recorded as spans (see `Tracer.hpp`).
+ *
+ * **Methods**:
+ * - `GameEngine(AdventureGameMap& map, Player& player, OutputSink& out, uint32_t start, const RoutePlanner* planner)`: Places the player and focuses the map on the start.
+ * - `void Start()`: Describes the starting location and prompts for the first command.
+ * - `bool HandleLine(const string& line)`: Counts the turn, lets the map respawn the monsters due, then runs the line as a command or as the weapon for a pending attack.
+ * - `uint64_t Run(InputSource& in)`: Starts the game and feeds it lines until it is over or the input ends.
+ * - `void travel(const string& destination)`: Private method that plans a route and steps along it, focusing the map on every location passed.
+ * - `State GetState() const`, `bool HasWon() const`, `uint32_t GetPosition() const`, `uint64_t GetTurns() const`: Report on the game.
+ * - `void Save(GameSnapshot& snapshot) const`: Saves the map and player, then the position, state, turns and the name of a pending attack's target.
+ * - `void Restore(const GameSnapshot& snapshot)`: Checks the position against the map, takes up the saved state and focuses the map there.
+ * - `void SetJournal(EventJournal* journal)`: Sets the journal `record` appends to.
+ * - `void Apply(const GameEvent& event)`: Advances the map to the event's turn, then moves, takes or settles a battle as recorded, finding objects by their placement, then takes up the event's turn count and checks for victory.
+ * - `void record(...)`: Private method that fills in the location and turn and appends the event.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "GameEngine.hpp"
+#include "Asset.hpp"
+#include "Metrics.hpp"
+#include "Monster.hpp"
+#include "Node.hpp"
+#include "Tracer.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <stdexcept>
+
+namespace chants
+{
+    // views into the line, so parsing a command copies nothing
+    static string_view commandArgument(string_view line)
+    {
+        // Trim leading spaces
+        size_t start = line.find_first_not_of(' ');
+        if (start == string_view::npos)
+            return string_view();
+        line.remove_prefix(start);
+
+        // the argument is everything after the first space
+        size_t pos = line.find_first_of(' ');
+        return pos == string_view::npos ? string_view() : line.substr(pos + 1);
+    }
+
+    static string_view commandName(string_view line)
+    {
+        size_t start = line.find_first_not_of(' ');
+        if (start == string_view::npos)
+            return string_view();
+        return line.substr(start, line.find_first_of(' ', start) - start);
+    }
+
+    // the kind of command a line is timed and traced as, from its first word alone
+    static Metric commandMetric(string_view line, bool choosingWeapon)
+    {
+        string_view name = commandName(line);
+        if (choosingWeapon || (name == "a" && line.size() > 1))
+            return Metric::Attack;
+        if (name == "t" && line.size() > 1)
+            return Metric::Take;
+        if (name == "v")
+            return Metric::Inventory;
+        if (name == "travel")
+            return Metric::Travel;
+        return Metric::Move;
+    }
+
+    static bool readLine(InputSource &in, string &line)
+    {
+        CHANTS_METRIC_TIME(Metric::InputWait);
+        return in.ReadLine(line);
+    }
+
+    static bool isNumber(string_view s)
+    {
+        return !s.empty() && std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isdigit(c); });
+    }
+
+    GameEngine::GameEngine(AdventureGameMap &map, Player &player, OutputSink &out, uint32_t start, const RoutePlanner *planner)
+        : _map(map), _player(player), _out(out), _planner(planner), _position(start), _state(State::Exploring), _target(kNoSymbol), _won(false), _turns(0), _journal(nullptr)
+    {
+        _map.SetFocus(_position);
+    }
+
+    void GameEngine::Start()
+    {
+        describeLocation();
+        prompt();
+        CHANTS_TRACE_SCOPE("flush");
+        _out.Flush();
+    }
+
+    bool GameEngine::HandleLine(const string &line)
+    {
+        if (_state == State::Finished)
+            return false;
+        CHANTS_METRIC_COUNT(MetricCounter::Turns, 1);
+        {
+            CHANTS_METRIC_TIME(commandMetric(line, _state == State::ChoosingWeapon));
+            CHANTS_TRACE_SCOPE(Metrics::Name(commandMetric(line, _state == State::ChoosingWeapon)));
+            _turns++;
+            _map.Advance(_turns); // monsters due back return before the player acts
+            if (_state == State::ChoosingWeapon)
+                handleWeapon(line);
+            else
+                handleCommand(line);
+        }
+        CHANTS_METRIC_TIME(Metric::Render);
+        CHANTS_TRACE_SCOPE("flush");
+        _out.Flush(); // one frame per turn
+        return _state != State::Finished;
+    }
+
+    uint64_t GameEngine::Run(InputSource &in)
+    {
+        Start();
+        string line;
+        while (_state != State::Finished && readLine(in, line))
+        {
+            HandleLine(line);
+        }
+        return _turns;
+    }
+
+    GameEngine::State GameEngine::GetState() const
+    {
+        return _state;
+    }
+
+    bool GameEngine::HasWon() const
+    {
+        return _won;
+    }
+
+    uint32_t GameEngine::GetPosition() const
+    {
+        return _position;
+    }
+
+    uint64_t GameEngine::GetTurns() const
+    {
+        return _turns;
+    }
+
+    void GameEngine::Save(GameSnapshot &snapshot) const
+    {
+        _map.Save(snapshot);
+        _player.Save(snapshot);
+        snapshot.position = _position;
+        State state = _state == State::Finished && !_won ? State::Exploring : _state; // a game left with x goes on
+        snapshot.state = static_cast<uint32_t>(state);
+        snapshot.won = _won;
+        snapshot.turns = _turns;
+        snapshot.target = _target == kNoSymbol ? string() : SymbolTable::Global().Name(_target);
+    }
+
+    void GameEngine::Restore(const GameSnapshot &snapshot)
+    {
+        if (snapshot.position >= _map.LocationCount())
+            throw std::runtime_error("the saved game is at a location this map does not have");
+        _position = snapshot.position;
+        _state = static_cast<State>(snapshot.state);
+        _won = snapshot.won;
+        _turns = snapshot.turns;
+        _target = _state == State::ChoosingWeapon ? SymbolTable::Global().Intern(snapshot.target) : kNoSymbol;
+        _map.SetFocus(_position);
+    }
+
+    void GameEngine::SetJournal(EventJournal *journal)
+    {
+        _journal = journal;
+    }
+
+    void GameEngine::Apply(const GameEvent &event)
+    {
+        if (event.node >= _map.LocationCount())
+            throw std::runtime_error("the journal has an event at a location this map does not have");
+        _map.Advance(event.turn); // the respawns of the turns in between, as they happened
+        _position = event.node;
+        _map.SetFocus(_position);
+        Node &node = *_map.GetLocation(_position);
+
+        // the engine found the object by name, so the same name must still find the recorded placement
+        if (event.kind == GameEvent::Kind::Take)
+        {
+            Asset *asset = nullptr;
+            for (Asset *candidate : node.GetAssets())
+            {
+                if (candidate->GetPlacement() == event.placement)
+                    asset = candidate;
+            }
+            if (!asset || node.FindAsset(asset->GetSymbol()) != asset)
+                throw std::runtime_error("the journal takes an asset the game does not have there");
+            Symbol name = asset->GetSymbol();
+            _player.AddAsset(*asset);
+            node.RemoveAsset(name);
+        }
+        else if (event.kind == GameEvent::Kind::Battle)
+        {
+            Monster *monster = nullptr;
+            for (Monster *candidate : node.GetMonsters())
+            {
+                if (candidate->GetPlacement() == event.placement)
+                    monster = candidate;
+            }
+            if (!monster || node.FindMonster(monster->GetSymbol()) != monster)
+                throw std::runtime_error("the journal fights a monster the game does not have there");
+            _player.Seed(event.playerFightState);
+            if (static_cast<BattleOutcome>(event.outcome) == BattleOutcome::PlayerWins)
+                node.RemoveMonster(monster->GetSymbol());
+            else
+                monster->Seed(event.monsterFightState);
+        }
+
+        _turns = event.turn;
+        _state = State::Exploring;
+        _target = kNoSymbol;
+        if (_map.GetWorldState().AllMonstersDefeated())
+        {
+            _won = true;
+            _state = State::Finished;
+        }
+    }
+
+    void GameEngine::describeLocation()
+    {
+        const Node &node = *_map.GetLocation(_position);
+        _out << _out.Color(TextColor::Magenta) << "Location: " << node.GetName() << _out.Reset() << "\n";
+        _out << node.GetDescription() << "\n";
+
+        _out << "There are paths here ...\n";
+        for (uint32_t connection : node.GetConnectionIds())
+        {
+            _out << connection << " " << _map.GetLocation(connection)->GetName() << "\n";
+        }
+
+        for (const auto &asset : node.GetAssets())
+        {
+            _out << "Asset at this node: " << asset->GetName() << " " << asset->GetMessage() << " " << asset->GetValue() << "\n";
+        }
+
+        for (const auto &monster : node.GetMonsters())
+        {
+            _out << "Monster at this node: " << monster->GetName() << "\n";
+        }
+    }
+
+    void GameEngine::prompt()
+    {
+        if (_state == State::ChoosingWeapon)
+            _out << "Specify weapon or ability to use (or press enter to skip): ";
+        else
+            _out << "\nGo to node? e(x)it, (v)iew inventory, (a)ttack monster, (t)ake item, travel <location>: ";
+    }
+
+    void GameEngine::handleCommand(const string &line)
+    {
+        // exit app?
+        if (line == "x")
+        {
+            _state = State::Finished;
+            return;
+        }
+
+        if (line == "v")
+        {
+            _player.ViewInventory(_out);
+            describeLocation();
+            prompt();
+            return;
+        }
+
+        // travel Loguetown
+        if (commandName(line) == "travel")
+        {
+            travel(commandArgument(line));
+            endTurn();
+            return;
+        }
+
+        // a path can be taken by the id or the name of the location it leads to
+        int dir = findLocation(line);
+        bool validConnection = dir >= 0 && _map.GetGraph().HasEdge(_position, dir);
+        if (validConnection)
+        {
+            _position = dir;
+            _map.SetFocus(_position); // a streaming map pages regions in and out around the player
+            record(GameEvent::Kind::Move);
+        }
+
+        // if player wants to take an asset (t hammer)
+        if (!validConnection && line.length() > 1 && line[0] == 't')
+        {
+            // the map indexes the objects at each location by name
+            Node &node = *_map.GetLocation(_position);
+            const Asset *targetAsset = node.FindAsset(commandArgument(line));
+            if (targetAsset)
+            {
+                record(GameEvent::Kind::Take, targetAsset->GetPlacement());
+                _player.AddAsset(*targetAsset);
+                Symbol name = targetAsset->GetSymbol();
+                node.RemoveAsset(name);
+                _out << _out.Color(TextColor::Green) << "Collected: " << SymbolTable::Global().Name(name) << _out.Reset() << "\n";
+            }
+            else
+            {
+                _out << "Asset not found!\n";
+            }
+        }
+
+        // if player wants to attack a monster (a kraken), the next line names the weapon
+        if (!validConnection && line.length() > 1 && line[0] == 'a')
+        {
+            const Monster *targetMonster = _map.GetLocation(_position)->FindMonster(commandArgument(line));
+            if (targetMonster)
+            {
+                _target = targetMonster->GetSymbol();
+                _state = State::ChoosingWeapon;
+                _player.ListWeapons(_out);
+                prompt();
+                return;
+            }
+            _out << "Monster not found!\n";
+        }
+
+        if (!validConnection && line[0] != 't' && line[0] != 'a')
+        {
+            _out << "Not a valid node address\n";
+        }
+        endTurn();
+    }
+
+    void GameEngine::handleWeapon(const string &line)
+    {
+        _state = State::Exploring;
+        Node &node = *_map.GetLocation(_position);
+        Monster *targetMonster = node.FindMonster(_target);
+        _target = kNoSymbol;
+        if (targetMonster)
+        {
+            uint32_t placement = targetMonster->GetPlacement();
+            BattleOutcome outcome;
+            {
+                CHANTS_METRIC_TIME(Metric::Battle);
+                CHANTS_TRACE_SCOPE("battle");
+                outcome = _player.AttackMonster(*targetMonster, node, line, _out);
+            }
+            CHANTS_METRIC_COUNT(outcome == BattleOutcome::PlayerWins    ? MetricCounter::BattlesWon
+                                : outcome == BattleOutcome::MonsterWins ? MetricCounter::BattlesLost
+                                                                        : MetricCounter::BattlesDrawn, 1);
+            // a defeated monster is gone from the node, and its random engine with it
+            uint64_t monsterFightState = outcome == BattleOutcome::PlayerWins ? 0 : targetMonster->GetFightState();
+            record(GameEvent::Kind::Battle, placement, static_cast<int32_t>(outcome), _player.GetFightState(), monsterFightState);
+        }
+        endTurn();
+    }
+
+    void GameEngine::travel(string_view destination)
+    {
+        int to = findLocation(destination);
+        if (to < 0)
+        {
+            _out << "Location not found!\n";
+            return;
+        }
+        if (static_cast<uint32_t>(to) == _position)
+        {
+            _out << "You are already there!\n";
+            return;
+        }
+        if (!_planner)
+        {
+            _ownPlanner = std::make_unique<RoutePlanner>(_map.GetGraph());
+            _planner = _ownPlanner.get();
+        }
+        if (!_planner->Route(_position, static_cast<uint32_t>(to), _route))
+        {
+            _out << "No route to " << _map.GetLocation(to)->GetName() << "!\n";
+            return;
+        }
+
+        // step through every location on the way, so a streaming map pages the regions along the route
+        _out << "Route: " << _map.GetLocation(_position)->GetName();
+        for (uint32_t step : _route)
+        {
+            _position = step;
+            _map.SetFocus(_position);
+            record(GameEvent::Kind::Move);
+            _out << " -> " << _map.GetLocation(_position)->GetName();
+        }
+        _out << "\n";
+    }
+
+    void GameEngine::endTurn()
+    {
+        // the map counts the monsters left as they are defeated, streamed or not
+        if (_map.GetWorldState().AllMonstersDefeated())
+        {
+            _out << _out.Color(TextColor::Blue) << "Congratulations! You have defeated all the monsters and won the game!" << _out.Reset() << "\n";
+            _won = true;
+            _state = State::Finished;
+            return;
+        }
+
+        _out << "\n";
+        describeLocation();
+        prompt();
+    }
+
+    int GameEngine::findLocation(string_view name)
+    {
+        if (isNumber(name))
+        {
+            if (name.size() > 9)
+                return -1; // too large to be an id (and to fit in an int)
+            int id = 0;
+            std::from_chars(name.data(), name.data() + name.size(), id);
+            return static_cast<uint32_t>(id) < _map.LocationCount() ? id : -1; // ids are indices
+        }
+        Node *node = _map.FindLocation(name);
+        return node ? static_cast<int>(node->GetId()) : -1;
+    }
+
+    void GameEngine::record(GameEvent::Kind kind, uint32_t placement, int32_t outcome, uint64_t playerFightState, uint64_t monsterFightState)
+    {
+        if (!_journal)
+            return;
+        GameEvent event{};
+        event.kind = kind;
+        event.node = _position;
+        event.placement = placement;
+        event.outcome = outcome;
+        event.turn = _turns;
+        event.playerFightState = playerFightState;
+        event.monsterFightState = monsterFightState;
+        _journal->Append(event);
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ * @file GameIO.cpp
+ * @brief Implementation of the game's input sources and output sinks.
+ *
+ * **Methods**:
+ * - `OutputSink::Flush()`: Sinks write as they go unless they say otherwise.
+ * - `OutputSink::UsesColor()`: Sinks are plain unless they say otherwise.
+ * - `OutputSink::Color(TextColor)`, `OutputSink::Reset()`: Return the ANSI escape codes, or empty strings for plain sinks.
+ * - `operator<<(OutputSink&, ...)`: Format strings and numbers and pass them to `Write`.
+ * - `StreamInput::ReadLine(string&)`: Reads a line with `getline`, dropping a trailing carriage return.
+ * - `StreamOutput::Write(string_view)`, `Flush()`: Write to and flush the stream.
+ * - `NullOutput::Write(string_view)`: Does nothing.
+ * - `StringOutput::Write(string_view)`, `Text()`, `Clear()`: Append to, read and empty the captured text.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "GameIO.hpp"
+#include <charconv>
+
+namespace chants
+{
+    void OutputSink::Flush() {}
+
+    bool OutputSink::UsesColor() const
+    {
+        return false;
+    }
+
+    string_view OutputSink::Color(TextColor color) const
+    {
+        // indexed by the color code less 31, the first of them
+        static constexpr string_view kCodes[] = {"\033[1;31m", "\033[1;32m", "\033[1;33m", "\033[1;34m", "\033[1;35m", "\033[1;36m"};
+        return UsesColor() ? kCodes[static_cast<int>(color) - static_cast<int>(TextColor::Red)] : string_view();
+    }
+
+    string_view OutputSink::Reset() const
+    {
+        return UsesColor() ? string_view("\033[0m") : string_view();
+    }
+
+    OutputSink &operator<<(OutputSink &out, string_view text)
+    {
+        out.Write(text);
+        return out;
+    }
+
+    OutputSink &operator<<(OutputSink &out, const char *text)
+    {
+        out.Write(text);
+        return out;
+    }
+
+    OutputSink &operator<<(OutputSink &out, const string &text)
+    {
+        out.Write(text);
+        return out;
+    }
+
+    OutputSink &operator<<(OutputSink &out, char c)
+    {
+        out.Write(string_view(&c, 1));
+        return out;
+    }
+
+    OutputSink &operator<<(OutputSink &out, int64_t value)
+    {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.Write(string_view(digits, result.ptr - digits));
+        return out;
+    }
+
+    OutputSink &operator<<(OutputSink &out, int value)
+    {
+        return out << static_cast<int64_t>(value);
+    }
+
+    OutputSink &operator<<(OutputSink &out, uint32_t value)
+    {
+        return out << static_cast<int64_t>(value);
+    }
+
+    StreamInput::StreamInput(std::istream &in) : _in(in) {}
+
+    bool StreamInput::ReadLine(string &line)
+    {
+        if (!std::getline(_in, line))
+            return false;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back(); // scripts written on Windows
+        return true;
+    }
+
+    StreamOutput::StreamOutput(std::ostream &out, bool color) : _out(out), _color(color) {}
+
+    void StreamOutput::Write(string_view text)
+    {
+        _out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    void StreamOutput::Flush()
+    {
+        _out.flush();
+    }
+
+    bool StreamOutput::UsesColor() const
+    {
+        return _color;
+    }
+
+    void NullOutput::Write(string_view) {}
+
+    void StringOutput::Write(string_view text)
+    {
+        _text.append(text);
+    }
+
+    const string &StringOutput::Text() const
+    {
+        return _text;
+    }
+
+    void StringOutput::Clear()
+    {
+        _text.clear();
+    }
+}
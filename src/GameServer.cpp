@@ -0,0 +1,691 @@
+/**
+ * @file GameServer.cpp
+ * @brief Implementation of the GameServer class, hosting many independent games in one process.
+ *
+ * Each session's state is split by owner. The thread in `Run` owns the socket side: bytes received but not yet a
+ * whole line, the output being written and which events epoll watches. Whichever pool thread runs the session owns
+ * the game: map, player and engine. Between the two sit the commands waiting to run and the output waiting to be
+ * sent, under the session's mutex. The engine writes a turn into a private frame and moves it to the waiting output
+ * when it flushes, and the socket side swaps the waiting output with its emptied send buffer, so text is never
+ * copied more than once and the two buffers are reused for the life of the session.
+ *
+ * A session's game is created by its first task, on a pool thread, so a slow world never holds up the sockets.
+ * Streaming sessions page their regions without a loader thread, or the server would start one thread per player.
+ *
+ * Parking is a task like any other, so it never runs alongside the session's commands: the thread in `Run` notices
+ * an idle session when epoll times out, asks for it to be parked and schedules it. The task saves the game into an
+ * encoded snapshot, which is all the session keeps until its next command's task resumes it.
+ *
+ * **Methods**:
+ * - `GameServer(const WorldFile& world, const RoutePlanner& planner, const GameServerOptions& options)`: Creates the epoll instance and eventfd and opens the listening socket.
+ * - `~GameServer()`: Waits for running tasks, then closes every socket.
+ * - `uint16_t Port() const`, `GameServerStats Stats() const`: Report on the server.
+ * - `void Run()`: Waits for socket events and finished tasks, and hands each to the session it belongs to.
+ * - `void Stop()`: Sets the stop flag and wakes `Run`.
+ * - `void listenUnix()`, `void listenTcp()`: Private methods binding the listening socket.
+ * - `void acceptAll()`: Private method accepting connections and starting their games.
+ * - `void receive(Session& session)`: Private method reading a socket until it would block or the session has enough waiting.
+ * - `void send(Session& session)`: Private method writing a socket until it would block or nothing is left.
+ * - `void update(const std::shared_ptr<Session>& session)`: Private method deciding what a session does next.
+ * - `void runSession(const std::shared_ptr<Session>& session)`: Private method run on the pool.
+ * - `void startGame(Session& session)`, `void parkGame(Session& session)`: Private methods creating or resuming a game, and saving and freeing it.
+ * - `void parkIdle()`: Private method asking idle sessions to park.
+ * - `void close(Session& session)`, `void watch(Session& session)`, `void wake()`: Private helpers.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "GameServer.hpp"
+#include "AdventureGameMap.hpp"
+#include "Combatant.hpp"
+#include "GameEngine.hpp"
+#include "GameIO.hpp"
+#include "GameSnapshot.hpp"
+#include "Player.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace chants
+{
+    namespace
+    {
+        constexpr uint64_t kListener = UINT64_MAX; // epoll keys; sessions are keyed by their ids
+        constexpr uint64_t kWakeup = UINT64_MAX - 1;
+        constexpr size_t kReadSize = 16384;
+        constexpr int kEventBatch = 256;
+
+        std::runtime_error systemError(const string &what)
+        {
+            return std::runtime_error(what + ": " + std::strerror(errno));
+        }
+
+        // collects a turn's text and moves it to the session's waiting output when the engine flushes
+        class SessionOutput : public OutputSink
+        {
+        public:
+            SessionOutput(std::mutex &mutex, string &waiting, bool color) : _mutex(mutex), _waiting(waiting), _color(color) {}
+
+            void Write(string_view text) override
+            {
+                _frame.append(text);
+            }
+
+            void Flush() override
+            {
+                if (_frame.empty())
+                    return;
+                std::lock_guard<std::mutex> lock(_mutex);
+                _waiting.append(_frame);
+                _frame.clear();
+            }
+
+            bool UsesColor() const override
+            {
+                return _color;
+            }
+
+        private:
+            std::mutex &_mutex;
+            string &_waiting;
+            string _frame;
+            bool _color;
+        };
+    }
+
+    struct GameServer::Session
+    {
+        uint64_t id = 0;
+        int fd = -1;
+
+        // owned by the thread in Run
+        string input;          // received, not yet a whole line
+        string sending;        // output being written to the socket
+        size_t sent = 0;       // bytes of `sending` written
+        uint32_t events = 0;   // what epoll watches for
+        bool reading = true;
+        bool inputClosed = false;
+        bool closing = false;  // ends once its output is sent
+        bool parked = false;   // parked, or asked to be
+        size_t accounted = 0;  // bytes counted in the server's memory
+        std::chrono::steady_clock::time_point active; // when it last sent a command
+
+        // owned by the pool thread running the session
+        std::unique_ptr<AdventureGameMap> map;
+        std::unique_ptr<Player> player;
+        std::unique_ptr<SessionOutput> out;
+        std::unique_ptr<GameEngine> engine;
+        string snapshot;        // the encoded game while parked
+
+        // shared, under the mutex
+        std::mutex mutex;
+        std::deque<string> lines;
+        size_t lineBytes = 0;
+        string output;          // produced, waiting to be sent
+        bool scheduled = false; // a task is queued or running
+        bool finished = false;  // the game is over
+        bool park = false;      // the next task parks the game
+        size_t stateBytes = 0;  // held by the map and player after the last task
+    };
+
+    GameServer::GameServer(const WorldFile &world, const RoutePlanner &planner, const GameServerOptions &options)
+        : _world(world), _planner(planner), _options(options), _listener(-1), _epoll(-1), _wakeup(-1), _port(0),
+          _pool(options.threads), _nextId(0), _stop(false), _open(0), _accepted(0), _refused(0), _closed(0),
+          _commands(0), _bytesIn(0), _bytesOut(0), _throttled(0), _parked(0), _resumed(0), _memory(0)
+    {
+        try
+        {
+            _epoll = ::epoll_create1(EPOLL_CLOEXEC);
+            if (_epoll < 0)
+                throw systemError("cannot create epoll instance");
+            _wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (_wakeup < 0)
+                throw systemError("cannot create eventfd");
+            if (_options.unixPath.empty())
+                listenTcp();
+            else
+                listenUnix();
+
+            for (uint64_t key : {kListener, kWakeup})
+            {
+                epoll_event event{};
+                event.events = EPOLLIN;
+                event.data.u64 = key;
+                if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, key == kListener ? _listener : _wakeup, &event) < 0)
+                    throw systemError("cannot watch the listening socket");
+            }
+        }
+        catch (...)
+        {
+            for (int fd : {_listener, _epoll, _wakeup})
+            {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+            throw;
+        }
+    }
+
+    GameServer::~GameServer()
+    {
+        _pool.Wait(); // no task may touch a session while it is torn down
+        for (auto &entry : _sessions)
+        {
+            ::close(entry.second->fd);
+        }
+        _sessions.clear();
+        ::close(_listener);
+        ::close(_epoll);
+        ::close(_wakeup);
+        if (!_options.unixPath.empty())
+            ::unlink(_options.unixPath.c_str());
+    }
+
+    uint16_t GameServer::Port() const
+    {
+        return _port;
+    }
+
+    void GameServer::Run()
+    {
+        epoll_event events[kEventBatch];
+        vector<uint64_t> ready;
+        int timeout = _options.parkAfter ? static_cast<int>(std::max<uint32_t>(_options.parkAfter / 4, 1)) : -1;
+        auto scanned = std::chrono::steady_clock::now();
+        while (!_stop)
+        {
+            if (_options.parkAfter && std::chrono::steady_clock::now() - scanned >= std::chrono::milliseconds(timeout))
+            {
+                parkIdle();
+                scanned = std::chrono::steady_clock::now();
+            }
+
+            int count = ::epoll_wait(_epoll, events, kEventBatch, timeout);
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw systemError("cannot wait for clients");
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                uint64_t key = events[i].data.u64;
+                if (key == kListener)
+                {
+                    acceptAll();
+                    continue;
+                }
+                if (key == kWakeup)
+                {
+                    uint64_t value;
+                    while (::read(_wakeup, &value, sizeof(value)) > 0)
+                    {
+                    }
+                    continue;
+                }
+
+                auto found = _sessions.find(key);
+                if (found == _sessions.end())
+                    continue; // closed earlier in this round
+                std::shared_ptr<Session> session = found->second;
+                uint32_t happened = events[i].events;
+                if ((happened & EPOLLERR) || ((happened & EPOLLHUP) && !session->reading))
+                {
+                    close(*session); // the client is gone; nothing more can be sent
+                    continue;
+                }
+                if (happened & (EPOLLIN | EPOLLHUP))
+                    receive(*session);
+                if (session->fd >= 0 && (happened & EPOLLOUT))
+                    send(*session);
+                if (session->fd >= 0)
+                    update(session);
+            }
+
+            // sessions whose tasks have finished: send what they wrote and run what is waiting
+            {
+                std::lock_guard<std::mutex> lock(_readyMutex);
+                ready.swap(_ready);
+            }
+            for (uint64_t id : ready)
+            {
+                auto found = _sessions.find(id);
+                if (found == _sessions.end())
+                    continue;
+                std::shared_ptr<Session> session = found->second;
+                send(*session);
+                if (session->fd >= 0)
+                    update(session);
+            }
+            ready.clear();
+        }
+    }
+
+    void GameServer::Stop()
+    {
+        _stop = true;
+        wake();
+    }
+
+    GameServerStats GameServer::Stats() const
+    {
+        GameServerStats stats;
+        stats.accepted = _accepted;
+        stats.refused = _refused;
+        stats.closed = _closed;
+        stats.commands = _commands;
+        stats.bytesIn = _bytesIn;
+        stats.bytesOut = _bytesOut;
+        stats.throttled = _throttled;
+        stats.parked = _parked;
+        stats.resumed = _resumed;
+        stats.sessions = _open;
+        stats.memory = _memory;
+        return stats;
+    }
+
+    void GameServer::listenUnix()
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (_options.unixPath.size() >= sizeof(address.sun_path))
+            throw std::runtime_error("socket path too long: " + _options.unixPath);
+        std::memcpy(address.sun_path, _options.unixPath.c_str(), _options.unixPath.size() + 1);
+
+        _listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (_listener < 0)
+            throw systemError("cannot create socket");
+        ::unlink(_options.unixPath.c_str()); // left over from a server that did not shut down
+        if (::bind(_listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+            throw systemError("cannot listen on " + _options.unixPath);
+        if (::listen(_listener, SOMAXCONN) < 0)
+            throw systemError("cannot listen on " + _options.unixPath);
+    }
+
+    void GameServer::listenTcp()
+    {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(_options.port);
+        if (::inet_pton(AF_INET, _options.host.c_str(), &address.sin_addr) != 1)
+            throw std::runtime_error("not an IPv4 address: " + _options.host);
+
+        _listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (_listener < 0)
+            throw systemError("cannot create socket");
+        int on = 1;
+        ::setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        string where = _options.host + ":" + std::to_string(_options.port);
+        if (::bind(_listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+            throw systemError("cannot listen on " + where);
+        if (::listen(_listener, SOMAXCONN) < 0)
+            throw systemError("cannot listen on " + where);
+
+        socklen_t length = sizeof(address);
+        if (::getsockname(_listener, reinterpret_cast<sockaddr *>(&address), &length) == 0)
+            _port = ntohs(address.sin_port);
+    }
+
+    void GameServer::acceptAll()
+    {
+        static constexpr string_view kFull = "The seas are crowded right now, come back later.\n";
+        while (true)
+        {
+            int fd = ::accept4(_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0)
+            {
+                if (errno == EINTR || errno == ECONNABORTED)
+                    continue;
+                return; // none left, or out of descriptors until a session closes
+            }
+            if (_open >= _options.maxSessions || (_options.memoryLimit != 0 && _memory >= _options.memoryLimit))
+            {
+                ::send(fd, kFull.data(), kFull.size(), MSG_NOSIGNAL); // best effort, the socket is new and empty
+                ::close(fd);
+                _refused++;
+                continue;
+            }
+            if (_options.unixPath.empty())
+            {
+                int on = 1; // every turn is one write; send it at once
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            }
+
+            auto session = std::make_shared<Session>();
+            session->id = _nextId++;
+            session->fd = fd;
+            session->active = std::chrono::steady_clock::now();
+            session->events = EPOLLIN;
+            epoll_event event{};
+            event.events = session->events;
+            event.data.u64 = session->id;
+            if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) < 0)
+            {
+                ::close(fd);
+                continue;
+            }
+            _sessions.emplace(session->id, session);
+            _open++;
+            _accepted++;
+
+            // the first task creates the game and sends its opening turn
+            session->scheduled = true;
+            _pool.Submit([this, session] { runSession(session); });
+        }
+    }
+
+    void GameServer::receive(Session &session)
+    {
+        char buffer[kReadSize];
+        while (session.reading)
+        {
+            ssize_t got = ::read(session.fd, buffer, sizeof(buffer));
+            if (got < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK)
+                    close(session);
+                return;
+            }
+            if (got == 0)
+            {
+                session.inputClosed = true; // run what was sent, then end
+                session.reading = false;
+                return;
+            }
+            _bytesIn += static_cast<uint64_t>(got);
+            session.input.append(buffer, static_cast<size_t>(got));
+            session.active = std::chrono::steady_clock::now();
+
+            size_t start = 0;
+            size_t waiting;
+            {
+                std::lock_guard<std::mutex> lock(session.mutex);
+                for (size_t end; (end = session.input.find('\n', start)) != string::npos; start = end + 1)
+                {
+                    size_t length = end - start;
+                    if (length > 0 && session.input[end - 1] == '\r')
+                        length--;
+                    session.lines.emplace_back(session.input, start, length);
+                    session.lineBytes += length + 1;
+                }
+                waiting = session.lineBytes;
+                if (session.input.size() - start > _options.maxLineLength)
+                {
+                    session.output.append("\nThat order is too long for any pirate to follow. Farewell!\n");
+                    session.closing = true;
+                }
+            }
+            session.input.erase(0, start);
+            if (session.closing)
+            {
+                session.reading = false;
+                session.input.clear();
+                return;
+            }
+            if (waiting >= _options.inputLimit)
+                return; // update stops reading until the commands have run
+        }
+    }
+
+    void GameServer::send(Session &session)
+    {
+        while (true)
+        {
+            if (session.sent == session.sending.size())
+            {
+                session.sending.clear();
+                session.sent = 0;
+                std::lock_guard<std::mutex> lock(session.mutex);
+                session.sending.swap(session.output); // both buffers keep their capacity
+                if (session.sending.empty())
+                    return;
+            }
+            ssize_t wrote = ::send(session.fd, session.sending.data() + session.sent, session.sending.size() - session.sent, MSG_NOSIGNAL);
+            if (wrote < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK)
+                    close(session);
+                return;
+            }
+            _bytesOut += static_cast<uint64_t>(wrote);
+            session.sent += static_cast<size_t>(wrote);
+        }
+    }
+
+    void GameServer::update(const std::shared_ptr<Session> &session)
+    {
+        Session &s = *session;
+        size_t unsent = s.sending.size() - s.sent;
+        bool schedule = false;
+        bool idle;
+        bool done;
+        bool inputFull;
+        size_t usage;
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            if (!s.closing && s.stateBytes > _options.sessionMemoryLimit)
+            {
+                s.output.append("\nYour adventure has grown too large for these seas and has to end here.\n");
+                s.closing = true;
+                s.reading = false;
+            }
+            unsent += s.output.size();
+            done = s.finished || s.closing || (s.inputClosed && s.lines.empty());
+            if (!done && !s.scheduled && !s.lines.empty() && unsent < _options.outputLimit)
+            {
+                s.scheduled = true;
+                schedule = true;
+            }
+            idle = !s.scheduled;
+            inputFull = s.lineBytes >= _options.inputLimit;
+            usage = s.stateBytes + s.lineBytes + s.output.capacity();
+        }
+        if (schedule)
+        {
+            s.parked = false; // the task resumes a parked game first
+            _pool.Submit([this, session] { runSession(session); });
+        }
+
+        usage += s.input.capacity() + s.sending.capacity();
+        _memory += usage - s.accounted; // wraps correctly when the session shrank
+        s.accounted = usage;
+
+        if (done && idle && unsent == 0)
+        {
+            close(s);
+            return;
+        }
+
+        bool reading = !done && !s.inputClosed && !inputFull && unsent < _options.outputLimit;
+        if (s.reading && !reading && !done && !s.inputClosed)
+            _throttled++;
+        s.reading = reading;
+        watch(s);
+    }
+
+    void GameServer::runSession(const std::shared_ptr<Session> &session)
+    {
+        Session &s = *session;
+        size_t stateBytes = 0;
+        bool park;
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            park = s.park;
+            s.park = false;
+        }
+        try
+        {
+            if (park)
+                parkGame(s);
+            else if (!s.engine)
+                startGame(s);
+
+            for (uint32_t run = 0; !park && run < _options.batchSize; run++)
+            {
+                string line;
+                {
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    if (s.lines.empty() || s.output.size() >= _options.outputLimit)
+                        break;
+                    line = std::move(s.lines.front());
+                    s.lines.pop_front();
+                    s.lineBytes -= line.size() + 1;
+                }
+                _commands++;
+                if (!s.engine->HandleLine(line))
+                {
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    s.finished = true;
+                    break;
+                }
+            }
+            stateBytes = s.engine ? s.map->MemoryUsage() + s.player->MemoryUsage() : sizeof(Session) + s.snapshot.capacity();
+        }
+        catch (const std::exception &e)
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.output.append("\nThe adventure cannot go on: ").append(e.what()).append("\n");
+            s.finished = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.stateBytes = stateBytes;
+            s.scheduled = false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_readyMutex);
+            _ready.push_back(s.id);
+        }
+        wake();
+    }
+
+    void GameServer::startGame(Session &s)
+    {
+        StreamingOptions streaming;
+        streaming.prefetch = false;
+        s.out = std::make_unique<SessionOutput>(s.mutex, s.output, _options.color);
+        s.player = std::make_unique<Player>("Luffy", 10000, 200);
+        if (!s.snapshot.empty())
+        {
+            // the client already has the last turn; carry on from it without a word
+            GameSnapshot snapshot = GameSnapshot::Decode(s.snapshot);
+            if (_options.streaming)
+                s.map = std::make_unique<AdventureGameMap>(_world, snapshot, streaming);
+            else
+                s.map = std::make_unique<AdventureGameMap>(_world, snapshot);
+            s.player->Restore(snapshot, _world);
+            s.engine = std::make_unique<GameEngine>(*s.map, *s.player, *s.out, snapshot.position, &_planner);
+            s.engine->Restore(snapshot);
+            string().swap(s.snapshot);
+            _resumed++;
+            return;
+        }
+
+        // the same seeds as game `id` of a scripted run
+        uint64_t seed = MixSeed(_options.seed, s.id);
+        if (_options.streaming)
+            s.map = std::make_unique<AdventureGameMap>(_world, static_cast<unsigned>(seed), streaming);
+        else
+            s.map = std::make_unique<AdventureGameMap>(_world, static_cast<unsigned>(seed));
+        s.map->SetRespawnDelay(_options.respawnDelay); // a parked game keeps its own, saved with it
+        s.map->SetMonsterAI(_options.monsterAI);       // the sessions share the pool already, so one ticks serially
+        s.player->Seed(MixSeed(seed, 0));
+        s.engine = std::make_unique<GameEngine>(*s.map, *s.player, *s.out, 0, &_planner);
+        s.engine->Start();
+    }
+
+    void GameServer::parkGame(Session &s)
+    {
+        if (!s.engine)
+            return;
+        GameSnapshot snapshot;
+        s.engine->Save(snapshot);
+        snapshot.Encode(s.snapshot);
+        s.snapshot.shrink_to_fit();
+        s.engine.reset();
+        s.player.reset();
+        s.map.reset();
+        s.out.reset();
+        _parked++;
+    }
+
+    void GameServer::parkIdle()
+    {
+        auto idleSince = std::chrono::steady_clock::now() - std::chrono::milliseconds(_options.parkAfter);
+        for (auto &entry : _sessions)
+        {
+            Session &s = *entry.second;
+            if (s.parked || s.active > idleSince)
+                continue;
+            {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                if (s.scheduled || !s.lines.empty() || s.finished || s.closing)
+                    continue;
+                s.scheduled = true;
+                s.park = true;
+            }
+            s.parked = true;
+            std::shared_ptr<Session> session = entry.second;
+            _pool.Submit([this, session] { runSession(session); });
+        }
+    }
+
+    void GameServer::close(Session &session)
+    {
+        ::epoll_ctl(_epoll, EPOLL_CTL_DEL, session.fd, nullptr);
+        ::close(session.fd);
+        session.fd = -1;
+        _memory -= session.accounted;
+        session.accounted = 0;
+        _open--;
+        _closed++;
+        _sessions.erase(session.id); // a running task keeps the session alive until it returns
+    }
+
+    void GameServer::watch(Session &session)
+    {
+        bool unsent = session.sent < session.sending.size();
+        if (!unsent)
+        {
+            std::lock_guard<std::mutex> lock(session.mutex);
+            unsent = !session.output.empty();
+        }
+        uint32_t events = (session.reading ? static_cast<uint32_t>(EPOLLIN) : 0u) | (unsent ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        if (events == session.events)
+            return;
+        epoll_event event{};
+        event.events = events;
+        event.data.u64 = session.id;
+        ::epoll_ctl(_epoll, EPOLL_CTL_MOD, session.fd, &event);
+        session.events = events;
+    }
+
+    void GameServer::wake()
+    {
+        uint64_t one = 1;
+        if (::write(_wakeup, &one, sizeof(one)) < 0)
+        {
+            // the counter is already non-zero (or full), so Run is being woken anyway
+        }
+    }
+}
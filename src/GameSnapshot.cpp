@@ -0,0 +1,218 @@
+/**
+ * @file GameSnapshot.cpp
+ * @brief Implementation of the GameSnapshot struct, encoding and decoding saved games.
+ *
+ * Every record is a multiple of 8 bytes, so the sections follow each other without padding and the arrays are
+ * copied straight into and out of the buffer. Decoding checks everything the rest of the game relies on: the magic,
+ * the version, the exact size, placements in range and no placement changed twice. Whether the placements and
+ * locations fit the world being played is left to `Check`.
+ *
+ * **Methods**:
+ * - `void Check(const WorldFile& world) const`: Compares the saved world's shape with `world`.
+ * - `void Encode(string& out) const`: Writes the header, the inventory, the changes, the respawns and the target name.
+ * - `static GameSnapshot Decode(string_view data)`: Validates the header and sizes, then copies the records out.
+ * - `void WriteFile(const string& path) const`, `static GameSnapshot ReadFile(const string& path)`: Move encoded snapshots to and from files.
+ * - `static void Compare(...)`: Finds the missing and changed objects, then records every object left at the locations they touched.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "GameSnapshot.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace chants
+{
+    static_assert(sizeof(GameSnapshot::Header) % 8 == 0 && sizeof(GameSnapshot::HeldAsset) % 8 == 0 &&
+                      sizeof(GameSnapshot::ObjectChange) % 8 == 0 && sizeof(GameSnapshot::Respawn) % 8 == 0,
+                  "snapshot records must keep the sections aligned");
+
+    void GameSnapshot::Check(const WorldFile &world) const
+    {
+        if (nodeCount != world.NodeCount() || placementCount != world.PlacementCount())
+            throw std::runtime_error("the saved game was played in a different world");
+    }
+
+    void GameSnapshot::Encode(string &out) const
+    {
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(header.magic));
+        header.version = kVersion;
+        header.nodeCount = nodeCount;
+        header.placementCount = placementCount;
+        header.seed = seed;
+        header.position = position;
+        header.state = state;
+        header.turns = turns;
+        header.fightState = fightState;
+        header.health = health;
+        header.won = won;
+        header.inventoryCount = static_cast<uint32_t>(inventory.size());
+        header.changeCount = static_cast<uint32_t>(changes.size());
+        header.targetLength = static_cast<uint32_t>(target.size());
+        header.respawnCount = static_cast<uint32_t>(respawns.size());
+        header.respawnDelay = respawnDelay;
+        header.monsterAI = monsterAI;
+
+        size_t inventoryBytes = inventory.size() * sizeof(HeldAsset);
+        size_t changeBytes = changes.size() * sizeof(ObjectChange);
+        size_t respawnBytes = respawns.size() * sizeof(Respawn);
+        out.resize(sizeof(header) + inventoryBytes + changeBytes + respawnBytes + target.size());
+        char *at = &out[0];
+        std::memcpy(at, &header, sizeof(header));
+        at += sizeof(header);
+        if (inventoryBytes)
+            std::memcpy(at, inventory.data(), inventoryBytes);
+        at += inventoryBytes;
+        if (changeBytes)
+            std::memcpy(at, changes.data(), changeBytes);
+        at += changeBytes;
+        if (respawnBytes)
+            std::memcpy(at, respawns.data(), respawnBytes);
+        at += respawnBytes;
+        if (!target.empty())
+            std::memcpy(at, target.data(), target.size());
+    }
+
+    GameSnapshot GameSnapshot::Decode(string_view data)
+    {
+        Header header;
+        if (data.size() < sizeof(header))
+            throw std::runtime_error("saved game is truncated");
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0)
+            throw std::runtime_error("not a saved game");
+        if (header.version != kVersion)
+            throw std::runtime_error("saved game has format version " + std::to_string(header.version) +
+                                     ", expected " + std::to_string(kVersion));
+        uint64_t inventoryBytes = uint64_t(header.inventoryCount) * sizeof(HeldAsset);
+        uint64_t changeBytes = uint64_t(header.changeCount) * sizeof(ObjectChange);
+        uint64_t respawnBytes = uint64_t(header.respawnCount) * sizeof(Respawn);
+        if (data.size() != sizeof(header) + inventoryBytes + changeBytes + respawnBytes + header.targetLength)
+            throw std::runtime_error("saved game is truncated");
+        if (header.state > 2)
+            throw std::runtime_error("saved game has an invalid state");
+
+        GameSnapshot snapshot;
+        snapshot.nodeCount = header.nodeCount;
+        snapshot.placementCount = header.placementCount;
+        snapshot.seed = header.seed;
+        snapshot.position = header.position;
+        snapshot.state = header.state;
+        snapshot.won = header.won != 0;
+        snapshot.turns = header.turns;
+        snapshot.health = header.health;
+        snapshot.fightState = header.fightState;
+        snapshot.respawnDelay = header.respawnDelay;
+        snapshot.monsterAI = header.monsterAI != 0;
+
+        const char *at = data.data() + sizeof(header);
+        snapshot.inventory.resize(header.inventoryCount);
+        if (inventoryBytes)
+            std::memcpy(snapshot.inventory.data(), at, inventoryBytes);
+        at += inventoryBytes;
+        snapshot.changes.resize(header.changeCount);
+        if (changeBytes)
+            std::memcpy(snapshot.changes.data(), at, changeBytes);
+        at += changeBytes;
+        snapshot.respawns.resize(header.respawnCount);
+        if (respawnBytes)
+            std::memcpy(snapshot.respawns.data(), at, respawnBytes);
+        at += respawnBytes;
+        snapshot.target.assign(at, header.targetLength);
+
+        if (snapshot.position >= snapshot.nodeCount)
+            throw std::runtime_error("saved game is at a location that does not exist");
+        for (const HeldAsset &held : snapshot.inventory)
+        {
+            if (held.placement >= snapshot.placementCount)
+                throw std::runtime_error("saved game holds an object that does not exist");
+        }
+        vector<bool> changed(snapshot.placementCount);
+        vector<bool> gone(snapshot.placementCount);
+        for (const ObjectChange &change : snapshot.changes)
+        {
+            if (change.placement >= snapshot.placementCount || changed[change.placement] ||
+                (change.node != kGone && change.node >= snapshot.nodeCount))
+                throw std::runtime_error("saved game has an invalid object change");
+            changed[change.placement] = true;
+            gone[change.placement] = change.node == kGone;
+        }
+        // a monster waiting to respawn was defeated, so it is gone
+        vector<bool> respawning(snapshot.placementCount);
+        for (const Respawn &respawn : snapshot.respawns)
+        {
+            if (respawn.placement >= snapshot.placementCount || respawning[respawn.placement] || !gone[respawn.placement])
+                throw std::runtime_error("saved game has an invalid respawn");
+            respawning[respawn.placement] = true;
+        }
+        return snapshot;
+    }
+
+    void GameSnapshot::Compare(const vector<ObjectChange> &left, const vector<ObjectChange> &start, vector<ObjectChange> &changes)
+    {
+        auto startOf = [&](uint32_t placement) {
+            return std::lower_bound(start.begin(), start.end(), placement,
+                                    [](const ObjectChange &object, uint32_t p) { return object.placement < p; });
+        };
+
+        // a location is touched if it lost an object, gained one, or holds a monster that has fought
+        vector<uint32_t> leftPlacements;
+        leftPlacements.reserve(left.size());
+        vector<uint32_t> touched;
+        for (const ObjectChange &object : left)
+        {
+            leftPlacements.push_back(object.placement);
+            auto from = startOf(object.placement);
+            if (from == start.end() || from->placement != object.placement)
+                continue; // not one of these placements
+            if (object.node != from->node || object.fightState != from->fightState)
+            {
+                touched.push_back(object.node);
+                touched.push_back(from->node);
+            }
+        }
+        std::sort(leftPlacements.begin(), leftPlacements.end());
+        for (const ObjectChange &from : start)
+        {
+            if (!std::binary_search(leftPlacements.begin(), leftPlacements.end(), from.placement))
+            {
+                changes.push_back(ObjectChange{from.placement, kGone, 0});
+                touched.push_back(from.node);
+            }
+        }
+        std::sort(touched.begin(), touched.end());
+        for (const ObjectChange &object : left)
+        {
+            if (std::binary_search(touched.begin(), touched.end(), object.node))
+                changes.push_back(object);
+        }
+    }
+
+    void GameSnapshot::WriteFile(const string &path) const
+    {
+        string data;
+        Encode(data);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw std::runtime_error("cannot write saved game " + path);
+        if (!out.write(data.data(), static_cast<std::streamsize>(data.size())).flush())
+            throw std::runtime_error("failed writing saved game " + path);
+    }
+
+    GameSnapshot GameSnapshot::ReadFile(const string &path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            throw std::runtime_error("cannot open saved game " + path);
+        std::ostringstream data;
+        data << in.rdbuf();
+        return Decode(data.str());
+    }
+}
@@ -0,0 +1,424 @@
+/**
+ * @file HierarchicalRouter.cpp
+ * @brief Implementation of the HierarchicalRouter class, finding routes across huge worlds through their regions.
+ *
+ * Searches record what they reach in a `Scratch`: distance and parent arrays stamped with a generation number, so
+ * starting a new search costs nothing however large the world is, and only the entries a search touches are ever
+ * written. Every thread keeps its own scratches for the start region, the destination region, the cluster graph,
+ * the corridor and the steps inside regions.
+ *
+ * A forward search records for each location the one it was reached from; a backward search (against the paths,
+ * from the destination) records the one to go to next. Either way the route is read off by following parents.
+ *
+ * **Methods**:
+ * - `HierarchicalRouter(const WorldGraph& graph, RegionPartition regions, unsigned threads)`: Finds the borders and builds the cluster graph, one region per task.
+ * - `bool Route(uint32_t from, uint32_t to, vector<uint32_t>& route, RouteStats* stats) const`: Searches the end regions, the corridor's cluster graph, and expands the result.
+ * - `uint32_t BorderCount() const`, `uint64_t ClusterEdgeCount() const`, `const RegionPartition& Regions() const`: Report on the router.
+ * - `void searchRegion(...) const`: Private method running a breadth-first search inside one region.
+ * - `bool searchClusters(...) const`: Private method running Dijkstra over the cluster graph.
+ * - `bool findCorridor(...) const`: Private method running a breadth-first search over the region graph.
+ * - `void widen(Scratch& corridor) const`: Private method adding a ring of regions around the corridor.
+ * - `bool walkRegion(...) const`: Private method expanding a step inside a region into locations.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "HierarchicalRouter.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace chants
+{
+    struct HierarchicalRouter::Scratch
+    {
+        vector<uint32_t> stamp;
+        vector<uint32_t> dist;
+        vector<uint32_t> parent;
+        vector<uint32_t> reached; // in the order they were reached
+        uint32_t generation = 0;
+
+        void begin(size_t size)
+        {
+            if (stamp.size() < size)
+            {
+                stamp.resize(size, 0);
+                dist.resize(size);
+                parent.resize(size);
+            }
+            if (++generation == 0)
+            {
+                std::fill(stamp.begin(), stamp.end(), 0);
+                generation = 1;
+            }
+            reached.clear();
+        }
+
+        bool seen(uint32_t i) const
+        {
+            return stamp[i] == generation;
+        }
+
+        void reach(uint32_t i, uint32_t distance, uint32_t from)
+        {
+            stamp[i] = generation;
+            dist[i] = distance;
+            parent[i] = from;
+            reached.push_back(i);
+        }
+    };
+
+    HierarchicalRouter::HierarchicalRouter(const WorldGraph &graph, RegionPartition regions, unsigned threads)
+        : _graph(graph), _regions(std::move(regions))
+    {
+        uint32_t count = _graph.NodeCount();
+        _reverseOffsets.assign(count + 1, 0);
+        for (uint32_t from = 0; from < count; from++)
+        {
+            for (uint32_t to : _graph.Neighbors(from))
+            {
+                _reverseOffsets[to + 1]++;
+            }
+        }
+        for (uint32_t node = 0; node < count; node++)
+        {
+            _reverseOffsets[node + 1] += _reverseOffsets[node];
+        }
+        _reverseSources.resize(_reverseOffsets[count]);
+        vector<uint32_t> cursor(_reverseOffsets.begin(), _reverseOffsets.end() - 1);
+        for (uint32_t from = 0; from < count; from++)
+        {
+            for (uint32_t to : _graph.Neighbors(from))
+            {
+                _reverseSources[cursor[to]++] = from;
+            }
+        }
+
+        // a border has a path leaving or entering its region; number them region by region
+        vector<bool> isBorder(count, false);
+        for (uint32_t from = 0; from < count; from++)
+        {
+            for (uint32_t to : _graph.Neighbors(from))
+            {
+                if (_regions.RegionOf(from) != _regions.RegionOf(to))
+                {
+                    isBorder[from] = true;
+                    isBorder[to] = true;
+                }
+            }
+        }
+        _borderOf.assign(count, kNone);
+        vector<uint32_t> regionBorders(_regions.RegionCount() + 1, 0);
+        for (uint32_t region = 0; region < _regions.RegionCount(); region++)
+        {
+            regionBorders[region] = static_cast<uint32_t>(_borders.size());
+            for (uint32_t node : _regions.Members(region))
+            {
+                if (isBorder[node])
+                {
+                    _borderOf[node] = static_cast<uint32_t>(_borders.size());
+                    _borders.push_back(node);
+                }
+            }
+        }
+        regionBorders[_regions.RegionCount()] = static_cast<uint32_t>(_borders.size());
+
+        // every region fills in the edges of its own borders: its inner routes and its paths out
+        vector<vector<std::pair<uint32_t, uint32_t>>> edges(_borders.size());
+        ThreadPool pool(threads);
+        vector<Scratch> scratches(pool.Size());
+        pool.ParallelFor(_regions.RegionCount(), [&](uint64_t region, unsigned slot) {
+            Scratch &scratch = scratches[slot];
+            RouteStats ignored;
+            for (uint32_t border = regionBorders[region]; border < regionBorders[region + 1]; border++)
+            {
+                uint32_t node = _borders[border];
+                searchRegion(node, false, kNone, scratch, ignored);
+                for (uint32_t other = regionBorders[region]; other < regionBorders[region + 1]; other++)
+                {
+                    if (other != border && scratch.seen(_borders[other]))
+                        edges[border].emplace_back(other, scratch.dist[_borders[other]]);
+                }
+                for (uint32_t to : _graph.Neighbors(node))
+                {
+                    if (_regions.RegionOf(to) != region)
+                        edges[border].emplace_back(_borderOf[to], 1);
+                }
+            }
+        });
+
+        _edgeOffsets.assign(_borders.size() + 1, 0);
+        for (size_t border = 0; border < _borders.size(); border++)
+        {
+            _edgeOffsets[border + 1] = _edgeOffsets[border] + edges[border].size();
+        }
+        _edgeTargets.reserve(_edgeOffsets.back());
+        _edgeCosts.reserve(_edgeOffsets.back());
+        for (auto &list : edges)
+        {
+            for (const auto &edge : list)
+            {
+                _edgeTargets.push_back(edge.first);
+                _edgeCosts.push_back(edge.second);
+            }
+            vector<std::pair<uint32_t, uint32_t>>().swap(list);
+        }
+
+        // the regions next to each region, whichever way the paths between them go
+        const WorldGraph &adjacency = _regions.Adjacency();
+        uint32_t regionCount = _regions.RegionCount();
+        _linkOffsets.assign(regionCount + 1, 0);
+        for (uint32_t region = 0; region < regionCount; region++)
+        {
+            for (uint32_t next : adjacency.Neighbors(region))
+            {
+                _linkOffsets[region + 1]++;
+                _linkOffsets[next + 1]++;
+            }
+        }
+        for (uint32_t region = 0; region < regionCount; region++)
+        {
+            _linkOffsets[region + 1] += _linkOffsets[region];
+        }
+        _links.resize(_linkOffsets[regionCount]);
+        cursor.assign(_linkOffsets.begin(), _linkOffsets.end() - 1);
+        for (uint32_t region = 0; region < regionCount; region++)
+        {
+            for (uint32_t next : adjacency.Neighbors(region))
+            {
+                _links[cursor[region]++] = next;
+                _links[cursor[next]++] = region;
+            }
+        }
+    }
+
+    bool HierarchicalRouter::Route(uint32_t from, uint32_t to, vector<uint32_t> &route, RouteStats *stats) const
+    {
+        route.clear();
+        RouteStats local;
+        RouteStats &counts = stats ? *stats : local;
+        counts = RouteStats();
+        if (from >= _graph.NodeCount() || to >= _graph.NodeCount())
+            return false;
+        if (from == to)
+            return true;
+
+        thread_local Scratch start, goal, regionSearch, corridor, clusters, walk;
+        thread_local vector<uint32_t> chain;
+
+        // everything reachable from the start inside its region; the destination may be among it
+        searchRegion(from, false, kNone, start, counts);
+        if (start.seen(to))
+        {
+            for (uint32_t at = to; at != from; at = start.parent[at])
+            {
+                route.push_back(at);
+            }
+            std::reverse(route.begin(), route.end());
+            return true;
+        }
+
+        if (!findCorridor(_regions.RegionOf(from), _regions.RegionOf(to), regionSearch, corridor))
+            return false; // no chain of regions leads there, so no path does
+        searchRegion(to, true, kNone, goal, counts);
+
+        uint32_t last;
+        bool found = searchClusters(start, goal, &corridor, clusters, last, counts);
+        for (unsigned widening = 0; !found && widening < kWidenings; widening++)
+        {
+            counts.widenings++;
+            widen(corridor);
+            found = searchClusters(start, goal, &corridor, clusters, last, counts);
+        }
+        if (!found)
+        {
+            counts.widenings++;
+            if (!searchClusters(start, goal, nullptr, clusters, last, counts))
+                return false;
+        }
+
+        // the borders passed, from the first to the last
+        chain.clear();
+        for (uint32_t border = last; border != kNone; border = clusters.parent[border])
+        {
+            chain.push_back(_borders[border]);
+        }
+        std::reverse(chain.begin(), chain.end());
+
+        // into the first border, across the cluster graph, and on from the last border
+        for (uint32_t at = chain.front(); at != from; at = start.parent[at])
+        {
+            route.push_back(at);
+        }
+        std::reverse(route.begin(), route.end());
+        for (size_t i = 1; i < chain.size(); i++)
+        {
+            if (_regions.RegionOf(chain[i - 1]) != _regions.RegionOf(chain[i]))
+                route.push_back(chain[i]);
+            else if (!walkRegion(chain[i - 1], chain[i], walk, route, counts))
+                return false;
+        }
+        for (uint32_t at = chain.back(); at != to;)
+        {
+            at = goal.parent[at];
+            route.push_back(at);
+        }
+        return true;
+    }
+
+    uint32_t HierarchicalRouter::BorderCount() const
+    {
+        return static_cast<uint32_t>(_borders.size());
+    }
+
+    uint64_t HierarchicalRouter::ClusterEdgeCount() const
+    {
+        return _edgeTargets.size();
+    }
+
+    const RegionPartition &HierarchicalRouter::Regions() const
+    {
+        return _regions;
+    }
+
+    void HierarchicalRouter::searchRegion(uint32_t start, bool backwards, uint32_t stopAt, Scratch &scratch, RouteStats &stats) const
+    {
+        uint32_t region = _regions.RegionOf(start);
+        scratch.begin(_graph.NodeCount());
+        scratch.reach(start, 0, kNone);
+        for (size_t head = 0; head < scratch.reached.size(); head++)
+        {
+            uint32_t at = scratch.reached[head];
+            if (at == stopAt)
+                break;
+            const uint32_t *begin = backwards ? _reverseSources.data() + _reverseOffsets[at] : _graph.Neighbors(at).begin();
+            const uint32_t *end = backwards ? _reverseSources.data() + _reverseOffsets[at + 1] : _graph.Neighbors(at).end();
+            for (const uint32_t *next = begin; next != end; next++)
+            {
+                if (!scratch.seen(*next) && _regions.RegionOf(*next) == region)
+                    scratch.reach(*next, scratch.dist[at] + 1, at);
+            }
+        }
+        stats.locationsVisited += static_cast<uint32_t>(scratch.reached.size());
+    }
+
+    bool HierarchicalRouter::searchClusters(const Scratch &start, const Scratch &goal, const Scratch *corridor, Scratch &clusters,
+                                            uint32_t &last, RouteStats &stats) const
+    {
+        using Entry = std::pair<uint32_t, uint32_t>; // distance, border
+        thread_local vector<Entry> heap;
+        heap.clear();
+        clusters.begin(_borders.size());
+
+        for (uint32_t node : start.reached)
+        {
+            uint32_t border = _borderOf[node];
+            if (border != kNone)
+            {
+                clusters.reach(border, start.dist[node], kNone);
+                heap.emplace_back(start.dist[node], border);
+            }
+        }
+        std::make_heap(heap.begin(), heap.end(), std::greater<Entry>());
+
+        uint32_t best = kNone;
+        last = kNone;
+        while (!heap.empty())
+        {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+            Entry entry = heap.back();
+            heap.pop_back();
+            uint32_t border = entry.second;
+            if (entry.first > clusters.dist[border])
+                continue; // already settled closer
+            if (entry.first >= best)
+                break;
+            stats.bordersSettled++;
+
+            uint32_t node = _borders[border];
+            if (goal.seen(node) && entry.first + goal.dist[node] < best)
+            {
+                best = entry.first + goal.dist[node];
+                last = border;
+            }
+            for (uint64_t e = _edgeOffsets[border]; e < _edgeOffsets[border + 1]; e++)
+            {
+                uint32_t target = _edgeTargets[e];
+                if (corridor && !corridor->seen(_regions.RegionOf(_borders[target])))
+                    continue;
+                uint32_t distance = entry.first + _edgeCosts[e];
+                if (!clusters.seen(target))
+                {
+                    clusters.reach(target, distance, border);
+                    heap.emplace_back(distance, target);
+                    std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+                }
+                else if (distance < clusters.dist[target])
+                {
+                    clusters.dist[target] = distance;
+                    clusters.parent[target] = border;
+                    heap.emplace_back(distance, target);
+                    std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+                }
+            }
+        }
+        return last != kNone;
+    }
+
+    bool HierarchicalRouter::findCorridor(uint32_t fromRegion, uint32_t toRegion, Scratch &search, Scratch &corridor) const
+    {
+        const WorldGraph &adjacency = _regions.Adjacency();
+        search.begin(_regions.RegionCount());
+        search.reach(fromRegion, 0, kNone);
+        for (size_t head = 0; head < search.reached.size() && !search.seen(toRegion); head++)
+        {
+            uint32_t region = search.reached[head];
+            for (uint32_t next : adjacency.Neighbors(region))
+            {
+                if (!search.seen(next))
+                    search.reach(next, search.dist[region] + 1, region);
+            }
+        }
+        if (!search.seen(toRegion))
+            return false;
+
+        corridor.begin(_regions.RegionCount());
+        for (uint32_t region = toRegion; region != kNone; region = search.parent[region])
+        {
+            corridor.reach(region, 0, kNone);
+        }
+        return true;
+    }
+
+    void HierarchicalRouter::widen(Scratch &corridor) const
+    {
+        size_t inside = corridor.reached.size();
+        for (size_t i = 0; i < inside; i++)
+        {
+            uint32_t region = corridor.reached[i];
+            for (uint32_t r = _linkOffsets[region]; r < _linkOffsets[region + 1]; r++)
+            {
+                if (!corridor.seen(_links[r]))
+                    corridor.reach(_links[r], 0, kNone);
+            }
+        }
+    }
+
+    bool HierarchicalRouter::walkRegion(uint32_t from, uint32_t to, Scratch &scratch, vector<uint32_t> &route, RouteStats &stats) const
+    {
+        searchRegion(from, false, to, scratch, stats);
+        if (!scratch.seen(to))
+            return false;
+        size_t first = route.size();
+        for (uint32_t at = to; at != from; at = scratch.parent[at])
+        {
+            route.push_back(at);
+        }
+        std::reverse(route.begin() + static_cast<std::ptrdiff_t>(first), route.end());
+        return true;
+    }
+}
@@ -0,0 +1,151 @@
+/**
+ * @file Inventory.cpp
+ * @brief Implementation of the Inventory class, the player's stacked and indexed assets.
+ *
+ * Removing a copy from a stack of several is constant time, and so is removing a stack's last copy: the stack's entry
+ * in its category list is overwritten by the list's last entry, and the stack itself by the newest stack, whose index
+ * and category entries are then pointed at its new position. Nothing else moves, however many assets are held.
+ *
+ * **Methods**:
+ * - `uint32_t Add(const Asset& asset)`: Looks the name up and appends a placement, or starts a stack and files it under its category.
+ * - `bool Remove(Symbol name)`: Drops the newest copy, or the stack with its last copy by moving the last entries into its places.
+ * - `Asset* Find(Symbol name)`, `const Asset* Find(Symbol name) const`, `uint32_t Count(Symbol name) const`: Look the name up in the index.
+ * - `const vector<Stack>& Stacks() const`, `const vector<uint32_t>& InCategory(AssetCategory category) const`: Return the stacks and a category's list.
+ * - `size_t Size() const`, `size_t ItemCount() const`, `bool Empty() const`: Count what is held.
+ * - `void Clear()`: Empties the stacks and indexes.
+ * - `size_t MemoryUsage() const`: Counts the capacity of every vector and one heap node and bucket per index entry.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "Inventory.hpp"
+#include <utility>
+
+namespace chants
+{
+    uint32_t Inventory::Add(const Asset &asset)
+    {
+        _items++;
+        auto inserted = _index.try_emplace(asset.GetSymbol(), static_cast<uint32_t>(_stacks.size())); // no node is built for a name already held
+        if (!inserted.second)
+        {
+            Stack &stack = _stacks[inserted.first->second];
+            stack.copies.push_back(asset.GetPlacement());
+            return stack.Count();
+        }
+        vector<uint32_t> &category = _categories[static_cast<size_t>(asset.GetCategory())];
+        _stacks.push_back(Stack{asset, {}});
+        _categorySlots.push_back(static_cast<uint32_t>(category.size()));
+        category.push_back(inserted.first->second);
+        return 1;
+    }
+
+    bool Inventory::Remove(Symbol name)
+    {
+        auto found = _index.find(name);
+        if (found == _index.end())
+            return false;
+        _items--;
+        uint32_t position = found->second;
+        Stack &stack = _stacks[position];
+        if (!stack.copies.empty())
+        {
+            stack.copies.pop_back();
+            return true;
+        }
+
+        // the category's last entry takes the stack's place in its list
+        vector<uint32_t> &category = _categories[static_cast<size_t>(stack.asset.GetCategory())];
+        uint32_t slot = _categorySlots[position];
+        category[slot] = category.back();
+        _categorySlots[category[slot]] = slot;
+        category.pop_back();
+        _index.erase(found);
+
+        // and the newest stack takes its place in the stacks
+        uint32_t last = static_cast<uint32_t>(_stacks.size() - 1);
+        if (position != last)
+        {
+            _stacks[position] = std::move(_stacks[last]);
+            _categorySlots[position] = _categorySlots[last];
+            _index.find(_stacks[position].asset.GetSymbol())->second = position;
+            _categories[static_cast<size_t>(_stacks[position].asset.GetCategory())][_categorySlots[position]] = position;
+        }
+        _stacks.pop_back();
+        _categorySlots.pop_back();
+        return true;
+    }
+
+    Asset *Inventory::Find(Symbol name)
+    {
+        auto found = _index.find(name);
+        return found == _index.end() ? nullptr : &_stacks[found->second].asset;
+    }
+
+    const Asset *Inventory::Find(Symbol name) const
+    {
+        auto found = _index.find(name);
+        return found == _index.end() ? nullptr : &_stacks[found->second].asset;
+    }
+
+    uint32_t Inventory::Count(Symbol name) const
+    {
+        auto found = _index.find(name);
+        return found == _index.end() ? 0 : _stacks[found->second].Count();
+    }
+
+    const vector<Inventory::Stack> &Inventory::Stacks() const
+    {
+        return _stacks;
+    }
+
+    const vector<uint32_t> &Inventory::InCategory(AssetCategory category) const
+    {
+        return _categories[static_cast<size_t>(category)];
+    }
+
+    size_t Inventory::Size() const
+    {
+        return _stacks.size();
+    }
+
+    size_t Inventory::ItemCount() const
+    {
+        return _items;
+    }
+
+    bool Inventory::Empty() const
+    {
+        return _stacks.empty();
+    }
+
+    void Inventory::Clear()
+    {
+        _stacks.clear();
+        _categorySlots.clear();
+        _index.clear();
+        for (vector<uint32_t> &positions : _categories)
+        {
+            positions.clear();
+        }
+        _items = 0;
+    }
+
+    size_t Inventory::MemoryUsage() const
+    {
+        using Value = std::unordered_map<Symbol, uint32_t>::value_type;
+        size_t bytes = sizeof(*this) + _stacks.capacity() * sizeof(Stack) + _categorySlots.capacity() * sizeof(uint32_t);
+        for (const Stack &stack : _stacks)
+        {
+            bytes += stack.copies.capacity() * sizeof(uint32_t);
+        }
+        for (const vector<uint32_t> &positions : _categories)
+        {
+            bytes += positions.capacity() * sizeof(uint32_t);
+        }
+        return bytes + _index.size() * (sizeof(Value) + sizeof(void *)) + _index.bucket_count() * sizeof(void *);
+    }
+}
@@ -0,0 +1,274 @@
+/**
+ * @file Metrics.cpp
+ * @brief Implementation of the game's metrics: counters and latency histograms kept per thread and exported on demand.
+ *
+ * A shard is written only by its own thread, so its values are atomics updated with a relaxed load and store rather
+ * than a locked add: the writer never waits, and a snapshot taken meanwhile reads every value whole, if a moment
+ * stale. Shards are made under the registry's lock, once per thread, and kept until the process ends. The registry is
+ * never destroyed, so a thread still recording while the process exits has somewhere to record.
+ *
+ * Latencies are exported as one Prometheus histogram, `chants_latency_seconds`, labelled by metric, with bucket
+ * bounds at powers of 4 nanoseconds from 256 ns; these fall on bucket edges of `LatencyHistogram`, so the counts are
+ * exact. Percentiles, which Prometheus cannot work out as closely from so few bounds, go out as the gauge
+ * `chants_latency_quantile_seconds`.
+ *
+ * **Methods**:
+ * - `uint32_t LatencyHistogram::BucketOf(uint64_t nanoseconds)`: Latencies under 32 ns get a bucket each; above, the highest set bit picks the power of two and the next 5 bits the bucket within it.
+ * - `uint64_t LatencyHistogram::BucketLimit(uint32_t bucket)`: Inverts `BucketOf`.
+ * - `void LatencyHistogram::Record(uint64_t nanoseconds)`, `void LatencyHistogram::Add(const LatencyHistogram& other)`, `uint64_t CountAtMost(uint64_t nanoseconds) const`, `uint64_t Percentile(double fraction) const`: Fill and read a histogram.
+ * - `void Metrics::Record(Metric metric, uint64_t nanoseconds)`, `void Metrics::Add(MetricCounter counter, uint64_t count)`: Update the calling thread's shard, making it on first use.
+ * - `MetricsSnapshot Metrics::Snapshot()`: Adds up every shard under the registry's lock.
+ * - `void Metrics::WritePrometheus(const MetricsSnapshot& snapshot, string& text)`: Renders the histograms, percentiles and counters.
+ * - `void Metrics::WriteFile(const string& path)`: Writes a temporary file and renames it over the path, so a reader never sees half a file.
+ * - `const char* Metrics::Name(Metric metric)`, `const char* Metrics::Name(MetricCounter counter)`: Name the metrics.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "Metrics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace chants
+{
+    namespace
+    {
+        struct Shard
+        {
+            std::atomic<uint64_t> buckets[kMetricCount][LatencyHistogram::kBuckets];
+            std::atomic<uint64_t> counts[kMetricCount];
+            std::atomic<uint64_t> sums[kMetricCount];
+            std::atomic<uint64_t> maxima[kMetricCount];
+            std::atomic<uint64_t> counters[kMetricCounterCount];
+        };
+
+        struct Registry
+        {
+            std::mutex mutex;
+            vector<std::unique_ptr<Shard>> shards;
+        };
+
+        Registry &registry()
+        {
+            static Registry *shared = new Registry(); // never destroyed, see above
+            return *shared;
+        }
+
+        Shard &localShard()
+        {
+            thread_local Shard *shard = nullptr;
+            if (!shard)
+            {
+                Registry &shared = registry();
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                shared.shards.push_back(std::make_unique<Shard>());
+                shard = shared.shards.back().get();
+            }
+            return *shard;
+        }
+
+        // only the owning thread writes a shard
+        void bump(std::atomic<uint64_t> &value, uint64_t count)
+        {
+            value.store(value.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+        }
+
+        void appendSeconds(string &text, uint64_t nanoseconds)
+        {
+            char number[32];
+            std::snprintf(number, sizeof(number), "%.9g", static_cast<double>(nanoseconds) / 1e9);
+            text += number;
+        }
+    }
+
+    uint32_t LatencyHistogram::BucketOf(uint64_t nanoseconds)
+    {
+        if (nanoseconds < kSubBuckets)
+            return static_cast<uint32_t>(nanoseconds);
+        uint32_t top = 63 - static_cast<uint32_t>(__builtin_clzll(nanoseconds));
+        if (top >= kMaxBits)
+            return kBuckets - 1;
+        uint32_t shift = top - kSubBucketBits;
+        return (shift + 1) * kSubBuckets + static_cast<uint32_t>((nanoseconds >> shift) - kSubBuckets);
+    }
+
+    uint64_t LatencyHistogram::BucketLimit(uint32_t bucket)
+    {
+        if (bucket < kSubBuckets)
+            return bucket;
+        uint32_t shift = bucket / kSubBuckets - 1;
+        uint64_t low = uint64_t(kSubBuckets + bucket % kSubBuckets) << shift;
+        return low + (uint64_t(1) << shift) - 1;
+    }
+
+    void LatencyHistogram::Record(uint64_t nanoseconds)
+    {
+        buckets[BucketOf(nanoseconds)]++;
+        count++;
+        sum += nanoseconds;
+        max = std::max(max, nanoseconds);
+    }
+
+    void LatencyHistogram::Add(const LatencyHistogram &other)
+    {
+        for (uint32_t bucket = 0; bucket < kBuckets; bucket++)
+        {
+            buckets[bucket] += other.buckets[bucket];
+        }
+        count += other.count;
+        sum += other.sum;
+        max = std::max(max, other.max);
+    }
+
+    uint64_t LatencyHistogram::CountAtMost(uint64_t nanoseconds) const
+    {
+        uint64_t total = 0;
+        for (uint32_t bucket = 0; bucket < kBuckets && BucketLimit(bucket) <= nanoseconds; bucket++)
+        {
+            total += buckets[bucket];
+        }
+        return total;
+    }
+
+    uint64_t LatencyHistogram::Percentile(double fraction) const
+    {
+        if (count == 0)
+            return 0;
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * count)));
+        uint64_t seen = 0;
+        for (uint32_t bucket = 0; bucket < kBuckets; bucket++)
+        {
+            seen += buckets[bucket];
+            if (seen >= rank)
+                return std::min(BucketLimit(bucket), max);
+        }
+        return max;
+    }
+
+    void Metrics::Record(Metric metric, uint64_t nanoseconds)
+    {
+        Shard &shard = localShard();
+        size_t at = static_cast<size_t>(metric);
+        bump(shard.buckets[at][LatencyHistogram::BucketOf(nanoseconds)], 1);
+        bump(shard.counts[at], 1);
+        bump(shard.sums[at], nanoseconds);
+        if (nanoseconds > shard.maxima[at].load(std::memory_order_relaxed))
+            shard.maxima[at].store(nanoseconds, std::memory_order_relaxed);
+    }
+
+    void Metrics::Add(MetricCounter counter, uint64_t count)
+    {
+        bump(localShard().counters[static_cast<size_t>(counter)], count);
+    }
+
+    MetricsSnapshot Metrics::Snapshot()
+    {
+        MetricsSnapshot snapshot;
+        Registry &shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        for (const std::unique_ptr<Shard> &shard : shared.shards)
+        {
+            for (size_t metric = 0; metric < kMetricCount; metric++)
+            {
+                LatencyHistogram &latency = snapshot.latencies[metric];
+                for (uint32_t bucket = 0; bucket < LatencyHistogram::kBuckets; bucket++)
+                {
+                    latency.buckets[bucket] += shard->buckets[metric][bucket].load(std::memory_order_relaxed);
+                }
+                latency.count += shard->counts[metric].load(std::memory_order_relaxed);
+                latency.sum += shard->sums[metric].load(std::memory_order_relaxed);
+                latency.max = std::max(latency.max, shard->maxima[metric].load(std::memory_order_relaxed));
+            }
+            for (size_t counter = 0; counter < kMetricCounterCount; counter++)
+            {
+                snapshot.counters[counter] += shard->counters[counter].load(std::memory_order_relaxed);
+            }
+        }
+        snapshot.threads = shared.shards.size();
+        return snapshot;
+    }
+
+    void Metrics::WritePrometheus(const MetricsSnapshot &snapshot, string &text)
+    {
+        static const double kQuantiles[] = {0.5, 0.9, 0.99, 0.999, 1};
+
+        text += "# HELP chants_latency_seconds Time taken by each part of a turn.\n";
+        text += "# TYPE chants_latency_seconds histogram\n";
+        for (size_t metric = 0; metric < kMetricCount; metric++)
+        {
+            const LatencyHistogram &latency = snapshot.latencies[metric];
+            string labels = string("metric=\"") + Name(static_cast<Metric>(metric)) + "\"";
+            for (uint32_t bits = 8; bits <= LatencyHistogram::kMaxBits; bits += 2)
+            {
+                uint64_t bound = uint64_t(1) << bits;
+                text += "chants_latency_seconds_bucket{" + labels + ",le=\"";
+                appendSeconds(text, bound);
+                text += "\"} " + std::to_string(latency.CountAtMost(bound - 1)) + "\n";
+            }
+            text += "chants_latency_seconds_bucket{" + labels + ",le=\"+Inf\"} " + std::to_string(latency.count) + "\n";
+            text += "chants_latency_seconds_sum{" + labels + "} ";
+            appendSeconds(text, latency.sum);
+            text += "\nchants_latency_seconds_count{" + labels + "} " + std::to_string(latency.count) + "\n";
+        }
+
+        text += "# HELP chants_latency_quantile_seconds Percentiles of chants_latency_seconds, within 1/32 of a power of two.\n";
+        text += "# TYPE chants_latency_quantile_seconds gauge\n";
+        for (size_t metric = 0; metric < kMetricCount; metric++)
+        {
+            const LatencyHistogram &latency = snapshot.latencies[metric];
+            for (double quantile : kQuantiles)
+            {
+                char label[16];
+                std::snprintf(label, sizeof(label), "%g", quantile);
+                text += string("chants_latency_quantile_seconds{metric=\"") + Name(static_cast<Metric>(metric)) + "\",quantile=\"" + label + "\"} ";
+                appendSeconds(text, latency.Percentile(quantile));
+                text += "\n";
+            }
+        }
+
+        for (size_t counter = 0; counter < kMetricCounterCount; counter++)
+        {
+            string name = string("chants_") + Name(static_cast<MetricCounter>(counter)) + "_total";
+            text += "# TYPE " + name + " counter\n" + name + " " + std::to_string(snapshot.counters[counter]) + "\n";
+        }
+        text += "# HELP chants_metric_threads Threads that have recorded metrics.\n";
+        text += "# TYPE chants_metric_threads gauge\n";
+        text += "chants_metric_threads " + std::to_string(snapshot.threads) + "\n";
+    }
+
+    void Metrics::WriteFile(const string &path)
+    {
+        string text;
+        WritePrometheus(Snapshot(), text);
+        string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out.write(text.data(), static_cast<std::streamsize>(text.size()));
+            if (!out)
+                throw std::runtime_error("cannot write metrics to " + temporary);
+        }
+        if (std::rename(temporary.c_str(), path.c_str()) != 0)
+            throw std::runtime_error("cannot write metrics to " + path);
+    }
+
+    const char *Metrics::Name(Metric metric)
+    {
+        static const char *const kNames[kMetricCount] = {"move", "take", "attack", "inventory", "travel", "battle", "render", "input_wait"};
+        return kNames[static_cast<size_t>(metric)];
+    }
+
+    const char *Metrics::Name(MetricCounter counter)
+    {
+        static const char *const kNames[kMetricCounterCount] = {"turns", "battles_won", "battles_lost", "battles_drawn"};
+        return kNames[static_cast<size_t>(counter)];
+    }
+}
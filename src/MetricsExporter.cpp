@@ -0,0 +1,175 @@
+/**
+ * @file MetricsExporter.cpp
+ * @brief Implementation of the MetricsExporter class, serving the game's metrics on a local socket.
+ *
+ * The listening socket is non-blocking and watched with `poll` together with an eventfd, which the destructor writes
+ * to so the thread wakes and returns. An accepted connection is blocking, with a receive timeout of `kRequestWait`
+ * milliseconds: the request is read until its headers end, the client closes or the time is up. After the answer the
+ * write side is shut down before the socket is closed, so the client reads all of it even if it sent more.
+ *
+ * **Methods**:
+ * - `MetricsExporter(const MetricsExporterOptions& options)`: Creates the eventfd, binds the socket and starts the thread.
+ * - `~MetricsExporter()`: Wakes and joins the thread, then closes the descriptors and removes a Unix socket.
+ * - `uint16_t Port() const`: Returns the TCP port.
+ * - `void serve()`: Private method accepting connections until woken.
+ * - `void answer(int fd)`: Private method writing a snapshot, in an HTTP response if the request was one.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "MetricsExporter.hpp"
+#include "Metrics.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace chants
+{
+    static std::runtime_error systemError(const string &what)
+    {
+        return std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    MetricsExporter::MetricsExporter(const MetricsExporterOptions &options) : _options(options), _listener(-1), _wakeup(-1), _port(0)
+    {
+        try
+        {
+            _wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (_wakeup < 0)
+                throw systemError("cannot create eventfd");
+
+            string where;
+            if (_options.unixPath.empty())
+            {
+                sockaddr_in address{};
+                address.sin_family = AF_INET;
+                address.sin_port = htons(_options.port);
+                if (::inet_pton(AF_INET, _options.host.c_str(), &address.sin_addr) != 1)
+                    throw std::runtime_error("not an IPv4 address: " + _options.host);
+                _listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+                if (_listener < 0)
+                    throw systemError("cannot create socket");
+                int on = 1;
+                ::setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+                where = _options.host + ":" + std::to_string(_options.port);
+                if (::bind(_listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+                    throw systemError("cannot serve metrics on " + where);
+                socklen_t length = sizeof(address);
+                if (::getsockname(_listener, reinterpret_cast<sockaddr *>(&address), &length) == 0)
+                    _port = ntohs(address.sin_port);
+            }
+            else
+            {
+                sockaddr_un address{};
+                address.sun_family = AF_UNIX;
+                if (_options.unixPath.size() >= sizeof(address.sun_path))
+                    throw std::runtime_error("socket path too long: " + _options.unixPath);
+                std::memcpy(address.sun_path, _options.unixPath.c_str(), _options.unixPath.size() + 1);
+                _listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+                if (_listener < 0)
+                    throw systemError("cannot create socket");
+                ::unlink(_options.unixPath.c_str()); // left over from a process that did not shut down
+                where = _options.unixPath;
+                if (::bind(_listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+                    throw systemError("cannot serve metrics on " + where);
+            }
+            if (::listen(_listener, SOMAXCONN) < 0)
+                throw systemError("cannot serve metrics on " + where);
+            _thread = std::thread(&MetricsExporter::serve, this);
+        }
+        catch (...)
+        {
+            for (int fd : {_listener, _wakeup})
+            {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+            throw;
+        }
+    }
+
+    MetricsExporter::~MetricsExporter()
+    {
+        uint64_t one = 1;
+        if (::write(_wakeup, &one, sizeof(one)) < 0)
+        {
+            // the counter is already non-zero, so the thread is being woken anyway
+        }
+        _thread.join();
+        ::close(_listener);
+        ::close(_wakeup);
+        if (!_options.unixPath.empty())
+            ::unlink(_options.unixPath.c_str());
+    }
+
+    uint16_t MetricsExporter::Port() const
+    {
+        return _port;
+    }
+
+    void MetricsExporter::serve()
+    {
+        pollfd watched[2] = {{_listener, POLLIN, 0}, {_wakeup, POLLIN, 0}};
+        while (true)
+        {
+            if (::poll(watched, 2, -1) < 0 && errno != EINTR)
+                return;
+            if (watched[1].revents)
+                return;
+            if (!watched[0].revents)
+                continue;
+            int fd;
+            while ((fd = ::accept4(_listener, nullptr, nullptr, SOCK_CLOEXEC)) >= 0)
+            {
+                answer(fd);
+                ::close(fd);
+            }
+        }
+    }
+
+    void MetricsExporter::answer(int fd)
+    {
+        timeval wait{0, kRequestWait * 1000};
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &wait, sizeof(wait));
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &wait, sizeof(wait));
+        string request;
+        char buffer[1024];
+        while (request.size() < 8192 && request.find("\r\n\r\n") == string::npos && request.find("\n\n") == string::npos)
+        {
+            ssize_t got = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (got <= 0)
+                break; // closed, timed out or failed: answer with what there is
+            request.append(buffer, static_cast<size_t>(got));
+        }
+
+        string body;
+        Metrics::WritePrometheus(Metrics::Snapshot(), body);
+        string response;
+        if (request.compare(0, 4, "GET ") == 0)
+        {
+            response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " + std::to_string(body.size()) +
+                       "\r\nConnection: close\r\n\r\n";
+        }
+        response += body;
+
+        size_t sent = 0;
+        while (sent < response.size())
+        {
+            ssize_t wrote = ::send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if (wrote <= 0)
+                break; // the client went away
+            sent += static_cast<size_t>(wrote);
+        }
+        ::shutdown(fd, SHUT_WR);
+    }
+}
@@ -6,10 +6,12 @@
  * It initializes the monster with a name, health, and fight coefficient, inheriting the ability to fight from the `Combatant` class.
  *
  * **Methods**:
- * - `Monster(string name, int health, int fightCoefficient)`: Constructor to initialize the monster with a name, health, and fight coefficient. Inherits from `Combatant`.
+ * - `Monster(string_view name, int health, int fightCoefficient)`: Constructor to initialize the monster with a name, health, and fight coefficient. Inherits from `Combatant`.
+ * - `uint32_t GetPlacement() const`, `void SetPlacement(uint32_t placement)`: Read and record the world file placement of the monster.
  *
  * **Attributes**:
  * - Inherits attributes from `Combatant`: `_name`, `_health`, `_fightCoefficient`.
+ * - `_placement`: The world file placement the monster was created for, `kNoPlacement` if none.
  *
  * @author Evan Aarons Wood
  * @version 1.0
@@ -21,7 +23,17 @@
 
 namespace chants
 {
-    Monster::Monster(string name, int health, int fightCoefficient) : Combatant(name, health, fightCoefficient)
+    Monster::Monster(string_view name, int health, int fightCoefficient) : Combatant(name, health, fightCoefficient), _placement(kNoPlacement)
     {
     }
+
+    uint32_t Monster::GetPlacement() const
+    {
+        return _placement;
+    }
+
+    void Monster::SetPlacement(uint32_t placement)
+    {
+        _placement = placement;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,243 @@
+/**
+ * @file MonsterAI.cpp
+ * @brief Implementation of the MonsterAI class, the per-turn movement of a map's monsters.
+ *
+ * Each tick runs in three steps. A breadth-first search from the player's location, cut off at `kHuntRange` paths,
+ * measures how far the nearby locations are, which is all a hunter needs. It walks the paths backwards, over the
+ * map's graph turned around (see `WorldGraph::Reversed`), so a location that reaches the player only by one-way
+ * paths is measured along them. Then every region decides the moves of its
+ * monsters from the untouched map and claims each target with an atomic minimum of placements; regions only write
+ * their own list of moves and the claims, so they can run on any thread in any order. Last, on the calling thread,
+ * the moves that won their claim are applied in region order and the claims and distances are cleared, touching
+ * only the entries this tick set.
+ *
+ * **Methods**:
+ * - `MonsterAI(AdventureGameMap& map, const WorldFile& world, uint64_t seed, uint64_t turn)`: Sizes the buffers for the world and turns the map's graph around.
+ * - `void SetPool(ThreadPool* pool)`: Sets the pool.
+ * - `void Advance(uint64_t turn)`: Ticks every turn up to `turn`.
+ * - `uint64_t GetTurn() const`, `uint64_t GetMoves() const`: Return the counters.
+ * - `MonsterBehavior BehaviorOf(uint32_t placement) const`: Hashes the placement into one of the behaviors.
+ * - `size_t MemoryUsage() const`: Counts the buffers.
+ * - `void tick(uint64_t turn)`: Turns the graph around again if paths were added, then measures, proposes and applies one turn's moves.
+ * - `void measureHunt(uint32_t focus)`: The cut-off breadth-first search over the turned-around graph.
+ * - `void proposeMoves(uint32_t region, uint64_t turnSeed, uint32_t focus)`: Decides and claims the moves of the monsters in a region's occupied locations, found from the map's `WorldState`.
+ * - `uint32_t pickNeighbor(uint32_t node, uint64_t roll) const`: Picks a neighbour from the roll.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "MonsterAI.hpp"
+#include "AdventureGameMap.hpp"
+#include "Tracer.hpp"
+
+namespace chants
+{
+    namespace
+    {
+        constexpr uint32_t kFar = UINT32_MAX;                 // beyond the hunt range, or no claim
+        constexpr uint64_t kMoveStream = uint64_t(1) << 40; // a stream of the map's seed no placement uses
+    }
+
+    MonsterAI::MonsterAI(AdventureGameMap &map, const WorldFile &world, uint64_t seed, uint64_t turn)
+        : _map(map), _regions(world.Regions()), _seed(MixSeed(seed, kMoveStream)), _turn(turn),
+          _incoming(map.GetGraph().Reversed()), _distance(world.NodeCount(), kFar), _claims(new std::atomic<uint32_t>[world.NodeCount()]),
+          _proposals(_regions.RegionCount())
+    {
+        for (uint32_t node = 0; node < world.NodeCount(); node++)
+        {
+            _claims[node].store(kFar, std::memory_order_relaxed);
+        }
+    }
+
+    void MonsterAI::SetPool(ThreadPool *pool)
+    {
+        _pool = pool;
+    }
+
+    void MonsterAI::Advance(uint64_t turn)
+    {
+        for (; _turn < turn; _turn++)
+        {
+            tick(_turn + 1);
+        }
+    }
+
+    uint64_t MonsterAI::GetTurn() const
+    {
+        return _turn;
+    }
+
+    uint64_t MonsterAI::GetMoves() const
+    {
+        return _moves;
+    }
+
+    MonsterBehavior MonsterAI::BehaviorOf(uint32_t placement) const
+    {
+        return static_cast<MonsterBehavior>(MixSeed(_seed, placement) % 3);
+    }
+
+    size_t MonsterAI::MemoryUsage() const
+    {
+        size_t bytes = sizeof(*this) + _incoming.MemoryUsage() - sizeof(_incoming) + (_distance.capacity() + _reached.capacity()) * sizeof(uint32_t) +
+                       _distance.size() * sizeof(std::atomic<uint32_t>) + _proposals.capacity() * sizeof(vector<Move>);
+        for (const vector<Move> &moves : _proposals)
+        {
+            bytes += moves.capacity() * sizeof(Move);
+        }
+        return bytes;
+    }
+
+    void MonsterAI::tick(uint64_t turn)
+    {
+        CHANTS_TRACE_SCOPE("monster ai");
+        const WorldGraph &graph = _map.GetGraph();
+        if (_incoming.EdgeCount() != graph.EdgeCount())
+            _incoming = graph.Reversed(); // paths were added to the map since
+        uint32_t focus = _map.focus;
+        measureHunt(focus);
+
+        uint64_t turnSeed = MixSeed(_seed, turn);
+        uint32_t regions = _regions.RegionCount();
+        if (_pool && _pool->Size() > 1 && regions >= kParallelRegions)
+        {
+            _pool->ParallelForStealing(regions, [&](uint64_t region, unsigned) {
+                proposeMoves(static_cast<uint32_t>(region), turnSeed, focus);
+            });
+        }
+        else
+        {
+            for (uint32_t region = 0; region < regions; region++)
+            {
+                proposeMoves(region, turnSeed, focus);
+            }
+        }
+
+        // the back buffer becomes the map
+        for (const vector<Move> &moves : _proposals)
+        {
+            for (const Move &move : moves)
+            {
+                if (_claims[move.to].load(std::memory_order_relaxed) != move.placement)
+                    continue;
+                if (_map.locations[move.from].detachMonster(move.monster))
+                {
+                    _map.locations[move.to].AddMonster(move.monster);
+                    _moves++;
+                }
+            }
+        }
+        for (vector<Move> &moves : _proposals)
+        {
+            for (const Move &move : moves)
+            {
+                _claims[move.to].store(kFar, std::memory_order_relaxed);
+            }
+            moves.clear();
+        }
+        for (uint32_t node : _reached)
+        {
+            _distance[node] = kFar;
+        }
+        _reached.clear();
+    }
+
+    void MonsterAI::measureHunt(uint32_t focus)
+    {
+        if (focus >= _distance.size())
+            return;
+        _distance[focus] = 0;
+        _reached.push_back(focus);
+        for (size_t next = 0; next < _reached.size(); next++)
+        {
+            uint32_t node = _reached[next];
+            if (_distance[node] == kHuntRange)
+                continue;
+            // paths lead from the monster to the player, so step to the locations with a path here
+            for (uint32_t from : _incoming.Neighbors(node))
+            {
+                if (_distance[from] == kFar)
+                {
+                    _distance[from] = _distance[node] + 1;
+                    _reached.push_back(from);
+                }
+            }
+        }
+    }
+
+    void MonsterAI::proposeMoves(uint32_t region, uint64_t turnSeed, uint32_t focus)
+    {
+        const WorldGraph &graph = _map.graph;
+        const WorldState &state = _map.worldState;
+        vector<Move> &moves = _proposals[region];
+        for (uint32_t node : _regions.Members(region))
+        {
+            // the counts are packed together, so empty locations are skipped without touching their nodes
+            if (node == focus || state.MonstersAt(node) == 0)
+                continue; // a monster facing the player stands its ground
+
+            for (Monster *monster : _map.locations[node].GetMonsters())
+            {
+                uint32_t placement = monster->GetPlacement();
+                if (placement == Monster::kNoPlacement)
+                    continue; // added by hand, not placed by the world file
+                uint64_t roll = MixSeed(turnSeed, placement);
+                uint32_t to = node;
+                switch (BehaviorOf(placement))
+                {
+                case MonsterBehavior::Hunt:
+                    if (_distance[node] != kFar)
+                    {
+                        for (uint32_t neighbor : graph.Neighbors(node))
+                        {
+                            if (_distance[neighbor] == _distance[node] - 1)
+                            {
+                                to = neighbor;
+                                break;
+                            }
+                        }
+                    }
+                    else if (roll & 1)
+                        to = pickNeighbor(node, roll);
+                    break;
+                case MonsterBehavior::Guard:
+                {
+                    uint32_t home = _map.startingObjects[placement].node;
+                    if (node == home)
+                    {
+                        if ((roll & 3) == 0)
+                            to = pickNeighbor(node, roll);
+                    }
+                    else
+                        to = graph.HasEdge(node, home) ? home : pickNeighbor(node, roll); // lost: wander until home is in sight
+                    break;
+                }
+                case MonsterBehavior::Roam:
+                    if (roll & 1)
+                        to = pickNeighbor(node, roll);
+                    break;
+                }
+                if (to == node || state.MonstersAt(to) >= kCapacity)
+                    continue;
+
+                moves.push_back(Move{monster, placement, node, to});
+                std::atomic<uint32_t> &claim = _claims[to];
+                uint32_t held = claim.load(std::memory_order_relaxed);
+                while (placement < held && !claim.compare_exchange_weak(held, placement, std::memory_order_relaxed))
+                {
+                }
+            }
+        }
+    }
+
+    uint32_t MonsterAI::pickNeighbor(uint32_t node, uint64_t roll) const
+    {
+        uint32_t degree = _map.graph.Degree(node);
+        if (degree == 0)
+            return node;
+        return _map.graph.Neighbors(node)[static_cast<uint32_t>((roll >> 8) % degree)];
+    }
+}
@@ -0,0 +1,49 @@
+/**
+ * @file MonsterPool.cpp
+ * @brief Implementation of the MonsterPool class, which recycles the monsters of a map or region.
+ *
+ * **Methods**:
+ * - `MonsterPool(ObjectArena& arena)`: Starts with nothing to reuse.
+ * - `Monster *Acquire(string_view name, int health, int fightCoefficient)`: Pops the most recently released monster and constructs over it, or creates one in the arena.
+ * - `void Release(Monster* monster)`: Pushes the monster onto the free list.
+ * - `size_t FreeCount() const`, `size_t MemoryUsage() const`: Report on the free list.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "MonsterPool.hpp"
+#include <new>
+
+namespace chants
+{
+    MonsterPool::MonsterPool(ObjectArena &arena) : _arena(arena)
+    {
+    }
+
+    Monster *MonsterPool::Acquire(string_view name, int health, int fightCoefficient)
+    {
+        if (_free.empty())
+            return _arena.Create<Monster>(name, health, fightCoefficient);
+        Monster *slot = _free.back();
+        _free.pop_back();
+        return new (slot) Monster(name, health, fightCoefficient); // a monster has no destructor to run first
+    }
+
+    void MonsterPool::Release(Monster *monster)
+    {
+        _free.push_back(monster);
+    }
+
+    size_t MonsterPool::FreeCount() const
+    {
+        return _free.size();
+    }
+
+    size_t MonsterPool::MemoryUsage() const
+    {
+        return sizeof(*this) + _free.capacity() * sizeof(Monster *);
+    }
+}
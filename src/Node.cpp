@@ -8,27 +8,40 @@
  *
  * **Methods**:
  * - `Node(int id, string name, string description)`: Constructor to initialize a node with an ID, name, and description.
- * - `int GetId()`: Returns the ID of the node.
+ * - `int GetId() const`: Returns the ID of the node.
  * - `void SetId(int id)`: Sets the ID of the node.
- * - `string GetName() const`: Returns the name of the node.
- * - `string GetDescription() const`: Returns the description of the node.
+ * - `const string& GetName() const`: Returns the name of the node.
+ * - `Symbol GetSymbol() const`: Returns the interned symbol of the node's name.
+ * - `const string& GetDescription() const`: Returns the description of the node.
  * - `void SetDescription(const string& description)`: Sets the description of the node.
- * - `void AddConnection(Node *conn)`: Adds a connection to another node.
- * - `vector<Node *> GetConnections() const`: Returns a list of connected nodes.
+ * - `void AddConnection(Node *conn)`: Adds a connection to another node, through the owning map's graph if there is one.
+ * - `vector<Node *> GetConnections() const`: Builds a list of connected nodes.
+ * - `WorldGraph::NeighborRange GetConnectionIds() const`: Returns the IDs of connected nodes straight from the map's graph.
  * - `Node *GetAConnection(int connId)`: Retrieves a specific connected node by its ID.
  * - `void AddAsset(Asset *asset)`: Adds an asset to the node.
- * - `const vector<Asset *> GetAssets() const`: Returns a list of assets at the node.
- * - `void RemoveAsset(const string& assetName)`: Removes an asset from the node.
+ * - `const vector<Asset *>& GetAssets() const`: Returns the node's list of assets.
+ * - `Asset *FindAsset(string_view assetName)`: Resolves a name to its symbol and finds the matching asset.
+ * - `Asset *FindAsset(Symbol assetName)`: Finds an asset through the map's index, or by scanning a standalone node.
+ * - `void RemoveAsset(string_view assetName)`: Resolves a name to its symbol and removes the matching asset.
+ * - `void RemoveAsset(Symbol assetName)`: Removes the assets whose name has the given symbol.
  * - `void AddMonster(Monster *monster)`: Adds a monster to the node.
- * - `vector<Monster *> GetMonsters() const`: Returns a list of monsters at the node.
- * - `void RemoveMonster(const string& monsterName)`: Removes a monster from the node.
+ * - `const vector<Monster *>& GetMonsters() const`: Returns the node's list of monsters.
+ * - `Monster *FindMonster(string_view monsterName)`: Resolves a name to its symbol and finds the matching monster.
+ * - `Monster *FindMonster(Symbol monsterName)`: Finds a monster through the map's index, or by scanning a standalone node.
+ * - `void RemoveMonster(string_view monsterName)`: Resolves a name to its symbol and removes the matching monster.
+ * - `void RemoveMonster(Symbol monsterName)`: Removes the monsters whose name has the given symbol, handing them to a map that respawns them.
+ * - `ObjectIndex *assetIndex() const`, `ObjectIndex *monsterIndex() const`: Private methods returning the map's index, or `nullptr` if this node is not indexed.
+ * - `WorldState *worldState() const`: Private method returning the map's world state, or `nullptr` if this node is not counted.
+ * - `bool detachMonster(Monster *monster)`: Private method taking one monster off the node without defeating it, so the map's monster AI can move it to another node.
  * - `bool operator==(const Node &rhs) const`: Compares two nodes for equality based on their IDs.
+ * - `size_t MemoryUsage() const`: Adds the description and the pointer lists to the node itself.
  *
  * **Attributes**:
  * - `_id`: The unique identifier for the node.
- * - `_name`: The name of the node (location).
+ * - `_name`: The symbol of the node's name (location), interned when the node is created.
  * - `_description`: The description of the node.
- * - `_connections`: A list of other nodes connected to this node.
+ * - `_map`: The map that owns this node and its paths, or `nullptr` for a standalone node.
+ * - `_connections`: A list of other nodes connected to a standalone node.
  * - `_assets`: A list of assets located at this node.
  * - `_monsters`: A list of monsters found at this node.
  *
@@ -39,13 +52,81 @@
 
 
 #include "Node.hpp"
+#include "AdventureGameMap.hpp"
 #include <algorithm>
 
 namespace chants
 {
-    Node::Node(int id, string name, string description) : _id(id), _name(name), _description(description) {}
+    // finds an object by name, through the index when there is one
+    template <typename T>
+    static T *findObject(const vector<T *> &objects, ObjectIndex *index, uint32_t node, Symbol name)
+    {
+        if (index)
+        {
+            uint32_t slot;
+            return index->Find(node, name, slot) ? objects[slot] : nullptr;
+        }
+        for (T *object : objects)
+        {
+            if (object->GetSymbol() == name)
+                return object;
+        }
+        return nullptr;
+    }
+
+    // removes the object in a slot, keeping the others in the order they were added and the index in step
+    template <typename T>
+    static void removeSlot(vector<T *> &objects, ObjectIndex *index, uint32_t node, uint32_t slot)
+    {
+        Symbol name = objects[slot]->GetSymbol();
+        bool lostSlot = index && index->Erase(node, name, slot);
+        objects.erase(objects.begin() + slot);
+        if (!index)
+            return;
+
+        // a node holds a handful of objects, so following the later ones down a slot is cheap
+        for (uint32_t i = slot; i < objects.size(); i++)
+        {
+            index->Move(node, objects[i]->GetSymbol(), i + 1, i);
+        }
+        if (lostSlot)
+        {
+            // another object with the same name is still here, after the removed one; point the index at it
+            for (uint32_t i = slot; i < objects.size(); i++)
+            {
+                if (objects[i]->GetSymbol() == name)
+                {
+                    index->Set(node, name, i);
+                    break;
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    static void removeObjects(vector<T *> &objects, ObjectIndex *index, uint32_t node, Symbol name)
+    {
+        if (index)
+        {
+            uint32_t slot;
+            while (index->Find(node, name, slot))
+            {
+                removeSlot(objects, index, node, slot);
+            }
+            return;
+        }
+        for (uint32_t i = 0; i < objects.size();)
+        {
+            if (objects[i]->GetSymbol() == name)
+                removeSlot(objects, index, node, i);
+            else
+                i++;
+        }
+    }
+
+    Node::Node(int id, string name, string description) : _id(id), _name(SymbolTable::Global().Intern(name)), _description(description), _map(nullptr) {}
 
-    int Node::GetId()
+    int Node::GetId() const
     {
         return _id;
     }
@@ -55,12 +136,17 @@ namespace chants
         _id = id;
     }
 
-    string Node::GetName() const
+    const string &Node::GetName() const
+    {
+        return SymbolTable::Global().Name(_name);
+    }
+
+    Symbol Node::GetSymbol() const
     {
         return _name;
     }
 
-    string Node::GetDescription() const
+    const string &Node::GetDescription() const
     {
         return _description;
     }
@@ -72,16 +158,44 @@ namespace chants
 
     void Node::AddConnection(Node *conn)
     {
+        if (_map)
+        {
+            _map->AddPath(_id, conn->GetId());
+            return;
+        }
         _connections.push_back(conn);
     }
 
     vector<Node *> Node::GetConnections() const
     {
-        return _connections;
+        if (!_map)
+            return _connections;
+
+        vector<Node *> connections;
+        connections.reserve(_map->GetGraph().Degree(_id));
+        for (uint32_t connId : GetConnectionIds())
+        {
+            connections.push_back(_map->GetLocation(connId));
+        }
+        return connections;
+    }
+
+    WorldGraph::NeighborRange Node::GetConnectionIds() const
+    {
+        if (!_map)
+            return WorldGraph::NeighborRange(nullptr, nullptr); // standalone nodes only know their Node pointers
+        return _map->GetGraph().Neighbors(_id);
     }
 
     Node *Node::GetAConnection(int connId)
     {
+        if (_map)
+        {
+            if (connId < 0 || !_map->GetGraph().HasEdge(_id, connId))
+                return nullptr;
+            return _map->GetLocation(connId);
+        }
+
         for (auto conn : _connections)
         {
             if (conn->GetId() == connId)
@@ -95,39 +209,130 @@ namespace chants
     void Node::AddAsset(Asset *asset)
     {
         _assets.push_back(asset);
+        if (ObjectIndex *index = assetIndex())
+            index->Insert(_id, asset->GetSymbol(), static_cast<uint32_t>(_assets.size() - 1));
+        if (WorldState *state = worldState())
+            state->AddAssets(_id);
     }
 
-    const vector<Asset *> Node::GetAssets() const // Updated to match header
+    const vector<Asset *> &Node::GetAssets() const
     {
         return _assets;
     }
 
-    void Node::RemoveAsset(const string& assetName)
+    Asset *Node::FindAsset(string_view assetName)
+    {
+        Symbol symbol = SymbolTable::Global().Find(assetName);
+        return symbol == kNoSymbol ? nullptr : FindAsset(symbol);
+    }
+
+    Asset *Node::FindAsset(Symbol assetName)
+    {
+        return findObject(_assets, assetIndex(), _id, assetName);
+    }
+
+    void Node::RemoveAsset(string_view assetName)
+    {
+        Symbol symbol = SymbolTable::Global().Find(assetName);
+        if (symbol != kNoSymbol)
+            RemoveAsset(symbol);
+    }
+
+    void Node::RemoveAsset(Symbol assetName)
     {
-        _assets.erase(std::remove_if(_assets.begin(), _assets.end(),
-            [&assetName](Asset* asset) { return asset->GetName() == assetName; }),
-            _assets.end());
+        size_t before = _assets.size();
+        removeObjects(_assets, assetIndex(), _id, assetName);
+        if (WorldState *state = worldState())
+            state->RemoveAssets(_id, static_cast<uint32_t>(before - _assets.size()));
     }
 
     void Node::AddMonster(Monster *monster)
     {
         _monsters.push_back(monster);
+        if (ObjectIndex *index = monsterIndex())
+            index->Insert(_id, monster->GetSymbol(), static_cast<uint32_t>(_monsters.size() - 1));
+        if (WorldState *state = worldState())
+            state->AddMonsters(_id);
     }
 
-    vector<Monster *> Node::GetMonsters() const
+    const vector<Monster *> &Node::GetMonsters() const
     {
         return _monsters;
     }
 
-    void Node::RemoveMonster(const string& monsterName)
+    Monster *Node::FindMonster(string_view monsterName)
+    {
+        Symbol symbol = SymbolTable::Global().Find(monsterName);
+        return symbol == kNoSymbol ? nullptr : FindMonster(symbol);
+    }
+
+    Monster *Node::FindMonster(Symbol monsterName)
+    {
+        return findObject(_monsters, monsterIndex(), _id, monsterName);
+    }
+
+    void Node::RemoveMonster(string_view monsterName)
+    {
+        Symbol symbol = SymbolTable::Global().Find(monsterName);
+        if (symbol != kNoSymbol)
+            RemoveMonster(symbol);
+    }
+
+    void Node::RemoveMonster(Symbol monsterName)
+    {
+        size_t before = _monsters.size();
+        vector<Monster *> defeated; // handed back to a map that respawns them
+        if (_map && _map->respawnsMonsters(this))
+        {
+            for (Monster *monster : _monsters)
+            {
+                if (monster->GetSymbol() == monsterName)
+                    defeated.push_back(monster);
+            }
+        }
+        removeObjects(_monsters, monsterIndex(), _id, monsterName);
+        if (WorldState *state = worldState())
+            state->RemoveMonsters(_id, static_cast<uint32_t>(before - _monsters.size()));
+        for (Monster *monster : defeated)
+        {
+            _map->retireMonster(monster, static_cast<uint32_t>(_id));
+        }
+    }
+
+    bool Node::detachMonster(Monster *monster)
+    {
+        auto found = std::find(_monsters.begin(), _monsters.end(), monster);
+        if (found == _monsters.end())
+            return false;
+        removeSlot(_monsters, monsterIndex(), _id, static_cast<uint32_t>(found - _monsters.begin()));
+        if (WorldState *state = worldState())
+            state->RemoveMonsters(_id);
+        return true;
+    }
+
+    ObjectIndex *Node::assetIndex() const
+    {
+        return _map ? _map->assetIndexOf(this) : nullptr;
+    }
+
+    ObjectIndex *Node::monsterIndex() const
+    {
+        return _map ? _map->monsterIndexOf(this) : nullptr;
+    }
+
+    WorldState *Node::worldState() const
     {
-        _monsters.erase(std::remove_if(_monsters.begin(), _monsters.end(),
-            [&monsterName](Monster* monster) { return monster->GetName() == monsterName; }),
-            _monsters.end());
+        return _map ? _map->worldStateOf(this) : nullptr;
     }
 
     bool Node::operator==(const Node &rhs) const
     {
         return _id == rhs._id;
     }
+
+    size_t Node::MemoryUsage() const
+    {
+        return sizeof(*this) + _description.capacity() +
+               (_connections.capacity() + _assets.capacity() + _monsters.capacity()) * sizeof(void *);
+    }
 }
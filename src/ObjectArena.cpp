@@ -0,0 +1,104 @@
+/**
+ * @file ObjectArena.cpp
+ * @brief Implementation of the ObjectArena class, the memory a map's assets and monsters are created in.
+ *
+ * Blocks come from `new[]`, which aligns them for any fundamental type, and every allocation is rounded to
+ * `kAlignment`, so objects packed one after another stay aligned. A block is never reallocated, which is what keeps
+ * the objects in it where they are; when the current one is full the rest of it is left unused and a new one
+ * started.
+ *
+ * **Methods**:
+ * - `ObjectArena(size_t blockBytes)`: Starts without a block; the first object allocates one.
+ * - `~ObjectArena()`: Frees the blocks.
+ * - `ObjectArena(ObjectArena&& other)`, `ObjectArena& operator=(ObjectArena&& other)`: Take over another arena's blocks, leaving it empty.
+ * - `void Reserve(size_t bytes)`: Starts a block of `bytes` unless the current one has room.
+ * - `void Release()`: Frees every block.
+ * - `size_t Used() const`, `size_t Capacity() const`: Report the bytes handed out and allocated.
+ * - `void *allocate(size_t bytes)`: Private method that bumps the free pointer.
+ * - `void grow(size_t bytes)`: Private method that starts a new block.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "ObjectArena.hpp"
+#include <algorithm>
+
+namespace chants
+{
+    ObjectArena::ObjectArena(size_t blockBytes)
+        : _next(nullptr), _end(nullptr), _blockBytes(blockBytes), _used(0), _capacity(0)
+    {
+    }
+
+    ObjectArena::~ObjectArena() = default;
+
+    ObjectArena::ObjectArena(ObjectArena &&other) noexcept
+        : _blocks(std::move(other._blocks)), _next(other._next), _end(other._end), _blockBytes(other._blockBytes),
+          _used(other._used), _capacity(other._capacity)
+    {
+        other._blocks.clear();
+        other._next = other._end = nullptr;
+        other._used = other._capacity = 0;
+    }
+
+    ObjectArena &ObjectArena::operator=(ObjectArena &&other) noexcept
+    {
+        if (this != &other)
+        {
+            _blocks = std::move(other._blocks);
+            _next = other._next;
+            _end = other._end;
+            _blockBytes = other._blockBytes;
+            _used = other._used;
+            _capacity = other._capacity;
+            other._blocks.clear();
+            other._next = other._end = nullptr;
+            other._used = other._capacity = 0;
+        }
+        return *this;
+    }
+
+    void ObjectArena::Reserve(size_t bytes)
+    {
+        if (static_cast<size_t>(_end - _next) < bytes)
+            grow(bytes);
+    }
+
+    void ObjectArena::Release()
+    {
+        _blocks.clear();
+        _next = _end = nullptr;
+        _used = _capacity = 0;
+    }
+
+    size_t ObjectArena::Used() const
+    {
+        return _used;
+    }
+
+    size_t ObjectArena::Capacity() const
+    {
+        return _capacity;
+    }
+
+    void *ObjectArena::allocate(size_t bytes)
+    {
+        if (static_cast<size_t>(_end - _next) < bytes)
+            grow(std::max(bytes, _blockBytes));
+        void *at = _next;
+        _next += bytes;
+        _used += bytes;
+        return at;
+    }
+
+    void ObjectArena::grow(size_t bytes)
+    {
+        _blocks.emplace_back(new unsigned char[bytes]); // left uninitialized, every object is constructed in place
+        _next = _blocks.back().get();
+        _end = _next + bytes;
+        _capacity += bytes;
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ * @file ObjectIndex.cpp
+ * @brief Implementation of the ObjectIndex class, the per-map index of objects by node and name.
+ *
+ * **Methods**:
+ * - `bool Find(uint32_t node, Symbol name, uint32_t &slot) const`: Hashes the (node, name) pair and returns its slot.
+ * - `void Insert(uint32_t node, Symbol name, uint32_t slot)`: Adds an entry, or counts another object with the name.
+ * - `bool Erase(uint32_t node, Symbol name, uint32_t slot)`: Uncounts an object and reports whether the entry lost its slot.
+ * - `void Move(uint32_t node, Symbol name, uint32_t from, uint32_t to)`: Repoints an entry whose object moved.
+ * - `void Set(uint32_t node, Symbol name, uint32_t slot)`: Repoints an entry.
+ * - `void Clear(uint32_t node, Symbol name)`: Drops an entry.
+ * - `size_t Size() const`: Returns the number of entries.
+ * - `size_t MemoryUsage() const`: Counts one heap node per entry (the entry and a next pointer) and one pointer per bucket.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "ObjectIndex.hpp"
+
+namespace chants
+{
+    uint64_t ObjectIndex::key(uint32_t node, Symbol name)
+    {
+        return (static_cast<uint64_t>(node) << 32) | name;
+    }
+
+    bool ObjectIndex::Find(uint32_t node, Symbol name, uint32_t &slot) const
+    {
+        auto found = _entries.find(key(node, name));
+        if (found == _entries.end())
+            return false;
+        slot = found->second.slot;
+        return true;
+    }
+
+    void ObjectIndex::Insert(uint32_t node, Symbol name, uint32_t slot)
+    {
+        auto inserted = _entries.emplace(key(node, name), Entry{slot, 1});
+        if (!inserted.second)
+            inserted.first->second.count++;
+    }
+
+    bool ObjectIndex::Erase(uint32_t node, Symbol name, uint32_t slot)
+    {
+        auto found = _entries.find(key(node, name));
+        if (found == _entries.end())
+            return false;
+        if (--found->second.count == 0)
+        {
+            _entries.erase(found);
+            return false;
+        }
+        return found->second.slot == slot;
+    }
+
+    void ObjectIndex::Move(uint32_t node, Symbol name, uint32_t from, uint32_t to)
+    {
+        auto found = _entries.find(key(node, name));
+        if (found != _entries.end() && found->second.slot == from)
+            found->second.slot = to;
+    }
+
+    void ObjectIndex::Set(uint32_t node, Symbol name, uint32_t slot)
+    {
+        auto found = _entries.find(key(node, name));
+        if (found != _entries.end())
+            found->second.slot = slot;
+    }
+
+    void ObjectIndex::Clear(uint32_t node, Symbol name)
+    {
+        _entries.erase(key(node, name));
+    }
+
+    size_t ObjectIndex::Size() const
+    {
+        return _entries.size();
+    }
+
+    size_t ObjectIndex::MemoryUsage() const
+    {
+        using Value = std::unordered_map<uint64_t, Entry>::value_type;
+        return sizeof(*this) + _entries.size() * (sizeof(Value) + sizeof(void *)) + _entries.bucket_count() * sizeof(void *);
+    }
+}
@@ -8,16 +8,25 @@
  *
  * **Methods**:
  * - `Player(string name, int health, int fightCoefficient)`: Constructor to initialize the player with a name, health, and fight coefficient.
- * - `void AddAsset(Asset asset)`: Adds an asset to the player's inventory, ensuring no duplicates.
- * - `void ViewInventory()`: Displays the player's current inventory.
- * - `void RemoveAsset(const string& assetName)`: Removes an asset from the player's inventory by name.
- * - `void UseAsset(const string& assetName)`: Marks an asset as used by the player.
+ * - `Player(const PlayerProfile& profile)`: Delegates to the constructor above.
+ * - `void AddAsset(Asset asset)`: Adds an asset to the player's inventory, stacking it with any held under the same name.
+ * - `void ViewInventory()`: Displays the player's current inventory on standard output.
+ * - `void ViewInventory(OutputSink& out) const`: Writes the player's current inventory to a sink, with the size of each stack of more than one.
+ * - `void RemoveAsset(const string& assetName)`: Removes one copy of an asset from the player's inventory by name, in any case.
+ * - `void RemoveAsset(Symbol assetName)`: Removes one copy of an asset from the player's inventory by the symbol of its name.
+ * - `void UseAsset(const string& assetName)`: Marks an asset as used by the player, matching its name in any case.
+ * - `void UseAsset(Symbol assetName)`: Marks the asset with the given name symbol as used.
  * - `void CollectItems(Node& node)`: Collects assets from a given node and adds them to the player's inventory.
- * - `void AttackMonster(Monster& monster, Node& node)`: Attacks a specified monster using the available assets.
- * - `const vector<Asset>& GetAssets() const`: Returns the player's list of assets.
+ * - `void ListWeapons(OutputSink& out) const`: Writes the names of the offensive assets the player can attack with, from the inventory's offensive list.
+ * - `const Asset* FindWeapon(const string& weaponName) const`: Finds an offensive asset in the inventory by name, in any case, through its index.
+ * - `BattleOutcome AttackMonster(Monster& monster, Node& node, const string& weaponName, OutputSink& out)`: Fights a monster with the named weapon (or none), reports the battle and removes the monster from the node if it is defeated.
+ * - `const Inventory& GetInventory() const`: Returns the player's inventory.
+ * - `size_t MemoryUsage() const`: Adds the inventory's stacks and indexes to the player itself.
+ * - `void Save(GameSnapshot& snapshot) const`: Records health, the fight state and the placement of every held asset, stack by stack.
+ * - `void Restore(const GameSnapshot& snapshot, const WorldFile& world)`: Recreates the held assets, which stack up again as they were.
  *
  * **Attributes**:
- * - `_assets`: A vector that stores the assets (items) the player has collected.
+ * - `_inventory`: The assets (items) the player has collected, stacked by name.
  *
  * @author Evan Aarons Wood
  * @version 1.0
@@ -25,108 +34,180 @@
  */
 
 
-#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 #include "Player.hpp"
+#include "Tracer.hpp"
 
 namespace chants
 {
     Player::Player(string name, int health, int fightCoefficient)
         : Combatant(name, health, fightCoefficient) {}
 
+    Player::Player(const PlayerProfile& profile)
+        : Player(profile.name, profile.health, profile.fightCoefficient) {}
+
     void Player::AddAsset(Asset asset)
     {
-        // Check for duplicates before adding
-        auto it = std::find_if(_assets.begin(), _assets.end(),
-            [&asset](const Asset& a) { return a.GetName() == asset.GetName(); });
-
-        if (it == _assets.end()) {
-            _assets.push_back(asset);
-        }
+        _inventory.Add(asset);
     }
 
     void Player::ViewInventory()
     {
-        std::cout << "Inventory:" << std::endl;
-        for (const auto& asset : _assets)
+        StreamOutput out(std::cout, false);
+        ViewInventory(out);
+    }
+
+    void Player::ViewInventory(OutputSink& out) const
+    {
+        out << "Inventory:\n";
+        for (const auto& stack : _inventory.Stacks())
         {
-            std::cout << "- " << asset.GetName() << ": " << asset.GetMessage() << std::endl;
+            out << "- " << stack.asset.GetName();
+            if (stack.Count() > 1)
+            {
+                out << " x" << stack.Count();
+            }
+            out << ": " << stack.asset.GetMessage() << "\n";
         }
     }
 
     
     void Player::RemoveAsset(const std::string& assetName)
     {
-        _assets.erase(std::remove_if(_assets.begin(), _assets.end(),
-            [&assetName](const Asset& asset) { return asset.GetName() == assetName; }),
-            _assets.end());
+        Symbol symbol = SymbolTable::Global().Find(assetName);
+        if (symbol != kNoSymbol)
+            RemoveAsset(symbol);
+    }
+
+    void Player::RemoveAsset(Symbol assetName)
+    {
+        _inventory.Remove(assetName);
     }
 
     void Player::UseAsset(const std::string& assetName)
     {
-        auto it = std::find_if(_assets.begin(), _assets.end(),
-            [&assetName](const Asset& asset) { return asset.GetName() == assetName; });
+        Symbol symbol = SymbolTable::Global().Find(assetName);
+        if (symbol != kNoSymbol)
+            UseAsset(symbol);
+    }
 
-        if (it != _assets.end())
+    void Player::UseAsset(Symbol assetName)
+    {
+        Asset* asset = _inventory.Find(assetName);
+        if (asset)
         {
             // Use the asset
-            it->hasBeenUsed = true;
-            std::cout << "Used asset: " << it->GetName() << std::endl;
+            asset->hasBeenUsed = true;
+            std::cout << "Used asset: " << asset->GetName() << std::endl;
         }
     }
 
     void Player::CollectItems(Node& node)
     {
-        auto items = node.GetAssets();
+        CHANTS_TRACE_SCOPE("collect items");
+        vector<Asset *> items = node.GetAssets(); // a copy, since collecting empties the node's list
         for (auto& item : items)
         {
-            AddAsset(*item); // Use AddAsset to prevent duplicates
-            node.RemoveAsset(item->GetName()); // Remove item from node after collection
+            AddAsset(*item); // stacks with any copy already held
+            node.RemoveAsset(item->GetSymbol()); // Remove item from node after collection
         }
     }
 
-    void Player::AttackMonster(Monster& monster, Node& node)
+    void Player::ListWeapons(OutputSink& out) const
     {
-        // Display available weapons
-        std::cout << "Available weapons: ";
-        for (const auto& asset : _assets)
+        out << "Available weapons: ";
+        for (uint32_t position : _inventory.InCategory(AssetCategory::Offensive))
         {
-            if (asset.isOffensive())
-            {
-                std::cout << asset.GetName() << " ";
-            }
+            out << _inventory.Stacks()[position].asset.GetName() << " ";
         }
-        std::cout << std::endl;
+        out << "\n";
+    }
 
-        std::cout << "Specify weapon or ability to use (or press enter to skip): ";
-        std::string weaponName;
-        std::getline(std::cin, weaponName);
+    const Asset* Player::FindWeapon(const std::string& weaponName) const
+    {
+        Symbol weaponSymbol = weaponName.empty() ? kNoSymbol : SymbolTable::Global().Find(weaponName);
+        if (weaponSymbol == kNoSymbol)
+            return nullptr;
+        const Asset* asset = _inventory.Find(weaponSymbol);
+        return asset && asset->isOffensive() ? asset : nullptr;
+    }
 
-        chants::Asset* weapon = nullptr;
-        if (!weaponName.empty())
+    BattleOutcome Player::AttackMonster(Monster& monster, Node& node, const std::string& weaponName, OutputSink& out)
+    {
+        const Asset* weapon = FindWeapon(weaponName);
+        BattleReport report = ResolveBattle(*this, monster, weapon);
+        if (weapon)
         {
-            for (auto& asset : _assets)
-            {
-                if (asset.GetName() == weaponName && asset.isOffensive())
-                {
-                    weapon = &asset;
-                    break;
-                }
-            }
+            out << out.Color(TextColor::Red) << "Using " << weapon->GetName() << " to attack!" << out.Reset() << "\n";
         }
 
-        // Implement attack logic here
-        bool playerWins = true; // Placeholder for actual combat logic
+        out << "Player attacks " << monster.GetName() << " with value: " << report.playerAttack << "\n";
+        out << monster.GetName() << " attacks back with value: " << report.monsterAttack << "\n";
 
-        if (playerWins)
+        if (report.outcome == BattleOutcome::PlayerWins)
         {
-            std::cout << "Player wins the fight against " << monster.GetName() << "!" << std::endl;
-            node.RemoveMonster(monster.GetName()); // Remove monster from node after defeat
+            out << "Player wins the fight!\n";
+            node.RemoveMonster(monster.GetSymbol()); // Remove monster from node after defeat
         }
+        else if (report.outcome == BattleOutcome::MonsterWins)
+        {
+            out << "Player loses the fight!\n";
+        }
+        else
+        {
+            out << "It's a draw!\n";
+        }
+        return report.outcome;
     }
 
-    const vector<Asset>& Player::GetAssets() const
+    const Inventory& Player::GetInventory() const
     {
-        return _assets;
+        return _inventory;
+    }
+
+    size_t Player::MemoryUsage() const
+    {
+        return sizeof(*this) - sizeof(Inventory) + _inventory.MemoryUsage();
+    }
+
+    void Player::Save(GameSnapshot& snapshot) const
+    {
+        snapshot.health = GetHealth();
+        snapshot.fightState = GetFightState();
+        snapshot.inventory.clear();
+        for (const auto& stack : _inventory.Stacks())
+        {
+            uint32_t used = stack.asset.hasBeenUsed;
+            snapshot.inventory.push_back(GameSnapshot::HeldAsset{stack.asset.GetPlacement(), used});
+            for (uint32_t placement : stack.copies)
+            {
+                snapshot.inventory.push_back(GameSnapshot::HeldAsset{placement, used});
+            }
+        }
+        for (const auto& held : snapshot.inventory)
+        {
+            if (held.placement == Asset::kNoPlacement)
+                throw std::logic_error("only assets placed by a world file can be saved");
+        }
+    }
+
+    void Player::Restore(const GameSnapshot& snapshot, const WorldFile& world)
+    {
+        snapshot.Check(world);
+        SetHealth(snapshot.health);
+        Seed(snapshot.fightState);
+        _inventory.Clear();
+        for (const auto& held : snapshot.inventory)
+        {
+            WorldFile::Placement placement = world.GetPlacement(held.placement);
+            if (placement.kind != WorldFile::PlacementKind::Asset)
+                throw std::runtime_error("the saved game holds a monster");
+            WorldFile::AssetDef def = world.GetAsset(placement.object);
+            Asset asset(def.name, def.message, def.value, def.category);
+            asset.SetPlacement(held.placement);
+            asset.hasBeenUsed = held.used != 0;
+            _inventory.Add(asset);
+        }
     }
 }
@@ -0,0 +1,513 @@
+/**
+ * @file RegionPager.cpp
+ * @brief Implementation of the RegionPager class, streaming regions of a large world in and out of memory.
+ *
+ * Regions move through three hands. The loader thread (or the map's thread, for a region needed right away)
+ * builds a region from the world file and any saved state, with its nodes still unbound. The map's thread adopts
+ * it, binding its nodes to the map, and later evicts it, saving which objects are left before handing the region
+ * back to the loader thread to be destroyed. Only building and destroying happen off the map's thread.
+ *
+ * **Methods**:
+ * - `RegionPager(...)`: Resolves where every placed object starts, groups placements by region, saves the regions a restored game changed and starts the loader.
+ * - `Node *Find(uint32_t id)`: Looks a node up in its resident region, acquiring the region first if needed.
+ * - `void SetFocus(uint32_t id)`: Acquires the focus region and the regions of the focus node's neighbors, queues the bordering regions and evicts everything else.
+ * - `Node *ResidentLocation(uint32_t id) const`: Looks a node up only if its region is resident.
+ * - `size_t MemoryUsage() const`: Adds up the resident regions, the regions held by the loader thread and the saved objects.
+ * - `void Save(GameSnapshot& snapshot) const`: Compares the saved regions and the resident ones with their placements.
+ * - `void Release(Monster* monster, uint32_t node)`: Returns the monster to the pool of the node's region.
+ * - `void Respawn(uint32_t placement, uint64_t due)`: Adds the monster to its node if the region is resident, or else to the region's saved objects, retiring a prefetched copy built without it.
+ * - `static size_t regionBytes(const Region& region)`: Private method estimating the bytes held by one region.
+ * - `std::unique_ptr<Region> build(uint32_t region) const`: Private method that creates a region's nodes and objects.
+ * - `void acquire(uint32_t region)`: Private method that takes a prefetched region, waits for one in progress, or builds it.
+ * - `void adopt(std::unique_ptr<Region> region)`: Private method that binds a built region to the map and indexes it.
+ * - `void evict(uint32_t region)`: Private method that unindexes a region, saves its objects and retires it.
+ * - `static vector<SavedObject> record(const Region& region)`: Private method listing a region's objects and fight states as its nodes list them.
+ * - `void compare(uint32_t region, const vector<SavedObject>& objects, vector<GameSnapshot::ObjectChange>& changes) const`: Private method comparing a region's objects with where its placements started.
+ * - `uint64_t startingFightState(uint32_t placement) const`: Private method returning the fight state a placed monster starts with.
+ * - `void loaderLoop()`: Private method run by the loader thread.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "RegionPager.hpp"
+#include "AdventureGameMap.hpp"
+#include "Tracer.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace chants
+{
+    RegionPager::RegionPager(const WorldFile &world, AdventureGameMap *map, unsigned seed, const StreamingOptions &options,
+                             const vector<GameSnapshot::ObjectChange> &changes)
+        : _world(world), _map(map), _options(options), _seed(seed), _regions(world.Regions()), _clock(0), _loading(kNone), _stop(false)
+    {
+        // resolve every placement once and group them by region, so a region can be built without scanning the world
+        _placementNode = world.ResolvePlacements(seed);
+        _placementOffsets.assign(_regions.RegionCount() + 1, 0);
+        for (uint32_t node : _placementNode)
+        {
+            _placementOffsets[_regions.RegionOf(node) + 1]++;
+        }
+        for (uint32_t region = 0; region < _regions.RegionCount(); region++)
+        {
+            _placementOffsets[region + 1] += _placementOffsets[region];
+        }
+        _placementsByRegion.resize(_placementNode.size());
+        vector<uint32_t> cursor(_placementOffsets.begin(), _placementOffsets.end() - 1);
+        for (uint32_t placement = 0; placement < _placementNode.size(); placement++)
+        {
+            _placementsByRegion[cursor[_regions.RegionOf(_placementNode[placement])]++] = placement;
+        }
+
+        // a restored game starts the regions it changed from saved objects, as if the player had left them: first
+        // the unchanged objects, then the changed ones in the order their locations listed them
+        vector<uint32_t> current = _placementNode;
+        vector<bool> changed(_placementNode.size());
+        for (const GameSnapshot::ObjectChange &change : changes)
+        {
+            if (change.node != GameSnapshot::kGone && _regions.RegionOf(change.node) != _regions.RegionOf(_placementNode[change.placement]))
+                throw std::runtime_error("the saved game moved an object out of its region");
+            current[change.placement] = change.node;
+            changed[change.placement] = true;
+        }
+        for (const GameSnapshot::ObjectChange &change : changes)
+        {
+            uint32_t regionId = _regions.RegionOf(_placementNode[change.placement]);
+            if (_saved.count(regionId))
+                continue;
+            vector<SavedObject> &objects = _saved[regionId];
+            for (uint32_t i = _placementOffsets[regionId]; i < _placementOffsets[regionId + 1]; i++)
+            {
+                uint32_t placement = _placementsByRegion[i];
+                if (!changed[placement])
+                    objects.push_back(SavedObject{placement, _placementNode[placement], startingFightState(placement)});
+            }
+        }
+        for (const GameSnapshot::ObjectChange &change : changes)
+        {
+            if (change.node != GameSnapshot::kGone)
+                _saved[_regions.RegionOf(change.node)].push_back(SavedObject{change.placement, change.node, change.fightState});
+        }
+
+        // the map's counts cover the whole world from the start; regions paged in later are not counted again
+        for (uint32_t placement = 0; placement < _placementNode.size(); placement++)
+        {
+            uint32_t node = current[placement];
+            if (node == GameSnapshot::kGone)
+                continue;
+            if (world.GetPlacement(placement).kind == WorldFile::PlacementKind::Asset)
+                _map->worldState.AddAssets(node);
+            else
+                _map->worldState.AddMonsters(node);
+        }
+
+        _resident.resize(_regions.RegionCount());
+        _lastFocus.assign(_regions.RegionCount(), 0);
+        if (_options.prefetch)
+            _loader = std::thread(&RegionPager::loaderLoop, this);
+    }
+
+    RegionPager::~RegionPager()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        if (_loader.joinable())
+            _loader.join();
+    }
+
+    Node *RegionPager::Find(uint32_t id)
+    {
+        if (id >= _regions.NodeCount())
+            return nullptr;
+
+        uint32_t region = _regions.RegionOf(id);
+        if (!_resident[region])
+            acquire(region);
+        return &_resident[region]->nodes[_regions.LocalIndex(id)];
+    }
+
+    void RegionPager::SetFocus(uint32_t id)
+    {
+        if (id >= _regions.NodeCount())
+            return;
+
+        uint32_t focus = _regions.RegionOf(id);
+        _lastFocus[focus] = ++_clock;
+        if (!_resident[focus])
+            acquire(focus);
+
+        // adopt whatever the loader has finished, then queue the neighbors that are still missing
+        vector<std::unique_ptr<Region>> ready;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto &entry : _ready)
+            {
+                ready.push_back(std::move(entry.second));
+            }
+            _ready.clear();
+        }
+        for (auto &region : ready)
+        {
+            adopt(std::move(region));
+        }
+
+        // locations one step away must be resident so the player can name them
+        for (uint32_t neighbor : _map->GetGraph().Neighbors(id))
+        {
+            if (!_resident[_regions.RegionOf(neighbor)])
+                acquire(_regions.RegionOf(neighbor));
+        }
+        if (_options.prefetch)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _queue.clear();
+                for (uint32_t neighbor : _regions.Adjacency().Neighbors(focus))
+                {
+                    if (!_resident[neighbor] && _loading != neighbor)
+                        _queue.push_back(neighbor);
+                }
+            }
+            _wake.notify_one();
+        }
+        else
+        {
+            for (uint32_t neighbor : _regions.Adjacency().Neighbors(focus))
+            {
+                if (!_resident[neighbor])
+                    acquire(neighbor);
+            }
+        }
+
+        // evict everything outside the focus region and its neighbors, except the most recently left spares
+        vector<uint32_t> leaving;
+        WorldGraph::NeighborRange neighbors = _regions.Adjacency().Neighbors(focus);
+        for (uint32_t region : _residentList)
+        {
+            if (region != focus && std::find(neighbors.begin(), neighbors.end(), region) == neighbors.end())
+                leaving.push_back(region);
+        }
+        std::sort(leaving.begin(), leaving.end(),
+                  [this](uint32_t a, uint32_t b) { return _lastFocus[a] > _lastFocus[b]; });
+        for (size_t i = _options.spareRegions; i < leaving.size(); i++)
+        {
+            evict(leaving[i]);
+        }
+    }
+
+    Node *RegionPager::ResidentLocation(uint32_t id) const
+    {
+        if (id >= _regions.NodeCount())
+            return nullptr;
+
+        const std::unique_ptr<Region> &region = _resident[_regions.RegionOf(id)];
+        return region ? &region->nodes[_regions.LocalIndex(id)] : nullptr;
+    }
+
+    uint32_t RegionPager::ResidentRegionCount() const
+    {
+        return static_cast<uint32_t>(_residentList.size());
+    }
+
+    vector<Node> RegionPager::ResidentLocations() const
+    {
+        vector<Node> locations;
+        ForEachResident([&](const Node &node) { locations.push_back(node); });
+        return locations;
+    }
+
+    size_t RegionPager::MemoryUsage() const
+    {
+        size_t bytes = sizeof(*this) +
+                       (_placementNode.capacity() + _placementOffsets.capacity() + _placementsByRegion.capacity() +
+                        _residentList.capacity()) * sizeof(uint32_t) +
+                       _lastFocus.capacity() * sizeof(uint64_t) + _resident.capacity() * sizeof(void *);
+        for (uint32_t region : _residentList)
+        {
+            bytes += regionBytes(*_resident[region]);
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const auto &ready : _ready)
+        {
+            bytes += regionBytes(*ready.second);
+        }
+        for (const auto &retired : _retired)
+        {
+            bytes += regionBytes(*retired);
+        }
+        for (const auto &saved : _saved)
+        {
+            bytes += sizeof(saved) + saved.second.capacity() * sizeof(SavedObject);
+        }
+        return bytes;
+    }
+
+    size_t RegionPager::regionBytes(const Region &region)
+    {
+        size_t bytes = sizeof(region) + region.nodes.capacity() * sizeof(Node) +
+                       region.objects.Capacity() + region.monsters.MemoryUsage() - sizeof(region.monsters);
+        for (const Node &node : region.nodes)
+        {
+            bytes += node.MemoryUsage() - sizeof(Node);
+        }
+        return bytes;
+    }
+
+    std::unique_ptr<RegionPager::Region> RegionPager::build(uint32_t regionId) const
+    {
+        CHANTS_TRACE_SCOPE("build region");
+        auto region = std::make_unique<Region>();
+        region->id = regionId;
+        WorldGraph::NeighborRange members = _regions.Members(regionId);
+        region->nodes.reserve(members.size());
+        for (uint32_t id : members)
+        {
+            region->nodes.emplace_back(id, string(_world.NodeName(id)), string(_world.NodeDescription(id)));
+        }
+
+        // a region comes back as it was left; one never visited starts from the world file's placements
+        vector<SavedObject> objects;
+        bool saved = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto found = _saved.find(regionId);
+            if (found != _saved.end())
+            {
+                objects = found->second;
+                saved = true;
+            }
+        }
+        if (!saved)
+        {
+            for (uint32_t i = _placementOffsets[regionId]; i < _placementOffsets[regionId + 1]; i++)
+            {
+                uint32_t placement = _placementsByRegion[i];
+                objects.push_back(SavedObject{placement, _placementNode[placement], startingFightState(placement)});
+            }
+        }
+
+        size_t monsterCount = 0;
+        for (const SavedObject &object : objects)
+        {
+            monsterCount += _world.GetPlacement(object.placement).kind == WorldFile::PlacementKind::Monster;
+        }
+        region->objects.Reserve(ObjectArena::Footprint<Asset>(objects.size() - monsterCount) + ObjectArena::Footprint<Monster>(monsterCount));
+        for (const SavedObject &object : objects)
+        {
+            Node &node = region->nodes[_regions.LocalIndex(object.node)];
+            WorldFile::Placement placement = _world.GetPlacement(object.placement);
+            if (placement.kind == WorldFile::PlacementKind::Asset)
+            {
+                WorldFile::AssetDef def = _world.GetAsset(placement.object);
+                Asset *asset = region->objects.Create<Asset>(def.name, def.message, def.value, def.category);
+                asset->SetPlacement(object.placement);
+                node.AddAsset(asset);
+            }
+            else
+            {
+                WorldFile::MonsterDef def = _world.GetMonster(placement.object);
+                Monster *monster = region->monsters.Acquire(def.name, def.health, def.fightCoefficient);
+                monster->Seed(object.fightState);
+                monster->SetPlacement(object.placement);
+                node.AddMonster(monster);
+            }
+        }
+        return region;
+    }
+
+    void RegionPager::acquire(uint32_t regionId)
+    {
+        std::unique_ptr<Region> region;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _loaded.wait(lock, [&] { return _loading != regionId; });
+            auto found = _ready.find(regionId);
+            if (found != _ready.end())
+            {
+                region = std::move(found->second);
+                _ready.erase(found);
+            }
+            else
+            {
+                _queue.erase(std::remove(_queue.begin(), _queue.end(), regionId), _queue.end());
+            }
+        }
+        if (!region)
+            region = build(regionId);
+        adopt(std::move(region));
+    }
+
+    void RegionPager::adopt(std::unique_ptr<Region> region)
+    {
+        uint32_t id = region->id;
+        if (_resident[id])
+            return; // already adopted; the duplicate is simply dropped
+        for (Node &node : region->nodes)
+        {
+            node._map = _map;
+        }
+        _resident[id] = std::move(region);
+        _residentList.push_back(id);
+        for (const Node &node : _resident[id]->nodes)
+        {
+            _map->indexLocation(node);
+        }
+    }
+
+    void RegionPager::evict(uint32_t regionId)
+    {
+        for (const Node &node : _resident[regionId]->nodes)
+        {
+            _map->unindexLocation(node);
+        }
+        std::unique_ptr<Region> region = std::move(_resident[regionId]);
+        _residentList.erase(std::find(_residentList.begin(), _residentList.end(), regionId));
+
+        vector<SavedObject> objects = record(*region);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _saved[regionId] = std::move(objects);
+            if (_options.prefetch)
+                _retired.push_back(std::move(region));
+        }
+        _wake.notify_one();
+    }
+
+    vector<RegionPager::SavedObject> RegionPager::record(const Region &region)
+    {
+        // in the order each node lists them, so a rebuilt node lists them alike
+        vector<SavedObject> objects;
+        for (const Node &node : region.nodes)
+        {
+            uint32_t id = static_cast<uint32_t>(node.GetId());
+            for (Asset *asset : node.GetAssets())
+            {
+                objects.push_back(SavedObject{asset->GetPlacement(), id, 0});
+            }
+            for (Monster *monster : node.GetMonsters())
+            {
+                objects.push_back(SavedObject{monster->GetPlacement(), id, monster->GetFightState()});
+            }
+        }
+        return objects;
+    }
+
+    void RegionPager::compare(uint32_t regionId, const vector<SavedObject> &objects, vector<GameSnapshot::ObjectChange> &changes) const
+    {
+        // the region's placements are grouped in placement order
+        vector<GameSnapshot::ObjectChange> start;
+        for (uint32_t i = _placementOffsets[regionId]; i < _placementOffsets[regionId + 1]; i++)
+        {
+            uint32_t placement = _placementsByRegion[i];
+            start.push_back(GameSnapshot::ObjectChange{placement, _placementNode[placement], startingFightState(placement)});
+        }
+        vector<GameSnapshot::ObjectChange> left;
+        left.reserve(objects.size());
+        for (const SavedObject &object : objects)
+        {
+            left.push_back(GameSnapshot::ObjectChange{object.placement, object.node, object.fightState});
+        }
+        GameSnapshot::Compare(left, start, changes);
+    }
+
+    uint64_t RegionPager::startingFightState(uint32_t placement) const
+    {
+        // the same seed as a full map gives the monster of this placement
+        return _world.GetPlacement(placement).kind == WorldFile::PlacementKind::Monster ? MixSeed(_seed, placement) : 0;
+    }
+
+    void RegionPager::Save(GameSnapshot &snapshot) const
+    {
+        snapshot.placementCount = static_cast<uint32_t>(_placementNode.size());
+        snapshot.changes.clear();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const auto &saved : _saved)
+            {
+                if (!_resident[saved.first])
+                    compare(saved.first, saved.second, snapshot.changes);
+            }
+        }
+        for (uint32_t region : _residentList)
+        {
+            compare(region, record(*_resident[region]), snapshot.changes);
+        }
+    }
+
+    void RegionPager::Release(Monster *monster, uint32_t node)
+    {
+        _resident[_regions.RegionOf(node)]->monsters.Release(monster);
+    }
+
+    void RegionPager::Respawn(uint32_t placement, uint64_t due)
+    {
+        uint32_t node = _placementNode[placement];
+        uint32_t regionId = _regions.RegionOf(node);
+        uint64_t fightState = MixSeed(startingFightState(placement), due); // as a full map respawns it
+        if (_resident[regionId])
+        {
+            WorldFile::MonsterDef def = _world.GetMonster(_world.GetPlacement(placement).object);
+            Monster *monster = _resident[regionId]->monsters.Acquire(def.name, def.health, def.fightCoefficient);
+            monster->Seed(fightState);
+            monster->SetPlacement(placement);
+            _resident[regionId]->nodes[_regions.LocalIndex(node)].AddMonster(monster);
+            return;
+        }
+
+        // the monster was defeated while the region was resident, so the region has been evicted and saved since;
+        // a copy the loader built from the saved objects before now would come back without it
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _loaded.wait(lock, [&] { return _loading != regionId; });
+            auto found = _ready.find(regionId);
+            if (found != _ready.end())
+            {
+                _retired.push_back(std::move(found->second));
+                _ready.erase(found);
+            }
+            _saved.at(regionId).push_back(SavedObject{placement, node, fightState});
+        }
+        _wake.notify_one();
+        _map->worldState.AddMonsters(node);
+    }
+
+    void RegionPager::loaderLoop()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true)
+        {
+            _wake.wait(lock, [this] { return _stop || !_queue.empty() || !_retired.empty(); });
+            if (_stop)
+                return;
+
+            if (!_retired.empty())
+            {
+                vector<std::unique_ptr<Region>> retired;
+                retired.swap(_retired);
+                lock.unlock();
+                retired.clear(); // free evicted regions off the map's thread
+                lock.lock();
+                continue;
+            }
+
+            uint32_t regionId = _queue.front();
+            _queue.pop_front();
+            if (_ready.count(regionId))
+                continue;
+            _loading = regionId;
+            lock.unlock();
+            std::unique_ptr<Region> region = build(regionId);
+            lock.lock();
+            _ready[regionId] = std::move(region);
+            _loading = kNone;
+            _loaded.notify_all();
+        }
+    }
+}
@@ -0,0 +1,162 @@
+/**
+ * @file RegionPartition.cpp
+ * @brief Implementation of the RegionPartition class, grouping game locations into regions.
+ *
+ * `Build` walks the nodes in id order; each node not yet in a region seeds a new one, which is grown breadth-first
+ * along outgoing paths until it holds `targetSize` nodes or runs out of unassigned neighbors. The member lists are
+ * then packed region by region with a counting sort, which leaves each list in ascending id order, and every path
+ * crossing a region border becomes one edge of the region graph.
+ *
+ * **Methods**:
+ * - `static RegionPartition Build(const WorldGraph& graph, uint32_t targetSize)`: Grows and packs the regions.
+ * - `static RegionPartition View(...)`: Wraps existing arrays.
+ * - `uint32_t RegionOf(uint32_t node) const`: Looks up the region of a node.
+ * - `WorldGraph::NeighborRange Members(uint32_t region) const`: Returns a region's sorted member ids.
+ * - `uint32_t LocalIndex(uint32_t node) const`: Binary searches a node in its region's member list.
+ * - `const WorldGraph& Adjacency() const`: Returns the region graph.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "RegionPartition.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace chants
+{
+    RegionPartition::RegionPartition()
+        : _nodeCount(0), _regionCount(0), _regionOf(nullptr), _memberOffsets(nullptr), _members(nullptr)
+    {
+        _offsetStore.assign(1, 0);
+        _memberOffsets = _offsetStore.data();
+    }
+
+    RegionPartition RegionPartition::Build(const WorldGraph &graph, uint32_t targetSize)
+    {
+        const uint32_t unassigned = UINT32_MAX;
+        uint32_t nodeCount = graph.NodeCount();
+        if (targetSize == 0)
+            targetSize = 1;
+
+        RegionPartition partition;
+        partition._nodeCount = nodeCount;
+        partition._regionOfStore.assign(nodeCount, unassigned);
+        vector<uint32_t> &regionOf = partition._regionOfStore;
+
+        // grow regions breadth-first from the lowest unassigned node
+        uint32_t regionCount = 0;
+        vector<uint32_t> frontier;
+        for (uint32_t seed = 0; seed < nodeCount; seed++)
+        {
+            if (regionOf[seed] != unassigned)
+                continue;
+
+            uint32_t region = regionCount++;
+            uint32_t size = 1;
+            regionOf[seed] = region;
+            frontier.assign(1, seed);
+            for (size_t head = 0; head < frontier.size() && size < targetSize; head++)
+            {
+                for (uint32_t neighbor : graph.Neighbors(frontier[head]))
+                {
+                    if (regionOf[neighbor] != unassigned)
+                        continue;
+                    regionOf[neighbor] = region;
+                    frontier.push_back(neighbor);
+                    if (++size == targetSize)
+                        break;
+                }
+            }
+        }
+        partition._regionCount = regionCount;
+
+        // pack the members of each region; scanning nodes in id order keeps every list sorted
+        partition._offsetStore.assign(regionCount + 1, 0);
+        vector<uint32_t> &offsets = partition._offsetStore;
+        for (uint32_t node = 0; node < nodeCount; node++)
+        {
+            offsets[regionOf[node] + 1]++;
+        }
+        for (uint32_t region = 0; region < regionCount; region++)
+        {
+            offsets[region + 1] += offsets[region];
+        }
+        partition._memberStore.resize(nodeCount);
+        vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (uint32_t node = 0; node < nodeCount; node++)
+        {
+            partition._memberStore[cursor[regionOf[node]]++] = node;
+        }
+
+        // one region edge for every pair of regions joined by a path
+        vector<std::pair<uint32_t, uint32_t>> borders;
+        for (uint32_t node = 0; node < nodeCount; node++)
+        {
+            for (uint32_t neighbor : graph.Neighbors(node))
+            {
+                if (regionOf[node] != regionOf[neighbor])
+                    borders.emplace_back(regionOf[node], regionOf[neighbor]);
+            }
+        }
+        std::sort(borders.begin(), borders.end());
+        borders.erase(std::unique(borders.begin(), borders.end()), borders.end());
+        partition._adjacency = WorldGraph(regionCount);
+        for (const auto &border : borders)
+        {
+            partition._adjacency.AddEdge(border.first, border.second);
+        }
+        partition._adjacency.Finalize();
+
+        partition._regionOf = partition._regionOfStore.data();
+        partition._memberOffsets = partition._offsetStore.data();
+        partition._members = partition._memberStore.data();
+        return partition;
+    }
+
+    RegionPartition RegionPartition::View(uint32_t nodeCount, uint32_t regionCount, const uint32_t *regionOf,
+                                          const uint32_t *memberOffsets, const uint32_t *members, WorldGraph adjacency)
+    {
+        RegionPartition partition;
+        partition._nodeCount = nodeCount;
+        partition._regionCount = regionCount;
+        partition._regionOf = regionOf;
+        partition._memberOffsets = memberOffsets;
+        partition._members = members;
+        partition._adjacency = std::move(adjacency);
+        return partition;
+    }
+
+    uint32_t RegionPartition::NodeCount() const
+    {
+        return _nodeCount;
+    }
+
+    uint32_t RegionPartition::RegionCount() const
+    {
+        return _regionCount;
+    }
+
+    uint32_t RegionPartition::RegionOf(uint32_t node) const
+    {
+        return _regionOf[node];
+    }
+
+    WorldGraph::NeighborRange RegionPartition::Members(uint32_t region) const
+    {
+        return WorldGraph::NeighborRange(_members + _memberOffsets[region], _members + _memberOffsets[region + 1]);
+    }
+
+    uint32_t RegionPartition::LocalIndex(uint32_t node) const
+    {
+        WorldGraph::NeighborRange members = Members(RegionOf(node));
+        return static_cast<uint32_t>(std::lower_bound(members.begin(), members.end(), node) - members.begin());
+    }
+
+    const WorldGraph &RegionPartition::Adjacency() const
+    {
+        return _adjacency;
+    }
+}
@@ -0,0 +1,245 @@
+/**
+ * @file RoutePlanner.cpp
+ * @brief Implementation of the RoutePlanner class, answering "how do I get from here to there" on a world's paths.
+ *
+ * A search from a destination marks each location it reaches with the position, in that location's neighbor list,
+ * of the path it was reached through; the destination itself is marked 0 so it is never entered twice. Searches on
+ * demand store positions in 32 bits; the precomputed table stores them in 16 bits, so it is only built when every
+ * position fits below `kNoTableStep`.
+ *
+ * **Methods**:
+ * - `RoutePlanner(const WorldGraph& graph, const RoutePlannerOptions& options)`: Prepares a planner without regions.
+ * - `RoutePlanner(const WorldGraph& graph, RegionPartition regions, const RoutePlannerOptions& options)`: Prepares a planner that may route through regions.
+ * - `~RoutePlanner()`: Frees the region router.
+ * - `void prepare(RegionPartition* regions)`: Private method that fills the table for small worlds, builds the region router for large ones with regions, and otherwise reverses the paths for searches on demand.
+ * - `uint32_t NextStep(uint32_t from, uint32_t to) const`: Reads one next step from the table or the cached search.
+ * - `bool Route(uint32_t from, uint32_t to, vector<uint32_t>& route) const`: Follows next steps from `from` to `to`.
+ * - `uint32_t Distance(uint32_t from, uint32_t to) const`: Counts the next steps from `from` to `to`.
+ * - `bool IsPrecomputed() const`, `bool IsHierarchical() const`, `size_t CachedDestinations() const`, `uint32_t LocationCount() const`: Report on the planner.
+ * - `void search(uint32_t to, Step* steps, vector<uint32_t>& queue) const`: Private method running the breadth-first search from one destination, into table or cached steps.
+ * - `bool walk(uint32_t from, uint32_t to, const Step* steps, vector<uint32_t>& route) const`: Private method following one destination's next steps.
+ * - `shared_ptr<const Steps> stepsTo(uint32_t to) const`: Private method returning a destination's search from the cache, searching it first if it is not there.
+ * - `uint32_t follow(uint32_t from, uint32_t step) const`: Private method resolving a next step to a location id.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "RoutePlanner.hpp"
+#include "HierarchicalRouter.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace chants
+{
+    RoutePlanner::RoutePlanner(const WorldGraph &graph, const RoutePlannerOptions &options)
+        : _graph(graph), _options(options)
+    {
+        prepare(nullptr);
+    }
+
+    RoutePlanner::RoutePlanner(const WorldGraph &graph, RegionPartition regions, const RoutePlannerOptions &options)
+        : _graph(graph), _options(options)
+    {
+        prepare(&regions);
+    }
+
+    RoutePlanner::~RoutePlanner() = default;
+
+    void RoutePlanner::prepare(RegionPartition *regions)
+    {
+        uint32_t count = _graph.NodeCount();
+        if (regions && count > _options.tableLimit && regions->NodeCount() == count)
+        {
+            _hierarchy = std::make_unique<HierarchicalRouter>(_graph, std::move(*regions), _options.threads);
+            return;
+        }
+
+        // reverse every path, remembering where it sits among its source's neighbors
+        _reverseOffsets.assign(count + 1, 0);
+        for (uint32_t from = 0; from < count; from++)
+        {
+            for (uint32_t to : _graph.Neighbors(from))
+            {
+                _reverseOffsets[to + 1]++;
+            }
+        }
+        for (uint32_t node = 0; node < count; node++)
+        {
+            _reverseOffsets[node + 1] += _reverseOffsets[node];
+        }
+        _reverseSources.resize(_reverseOffsets[count]);
+        _reverseSlots.resize(_reverseOffsets[count]);
+        vector<uint32_t> cursor(_reverseOffsets.begin(), _reverseOffsets.end() - 1);
+        uint32_t widest = 0;
+        for (uint32_t from = 0; from < count; from++)
+        {
+            WorldGraph::NeighborRange neighbors = _graph.Neighbors(from);
+            widest = std::max(widest, neighbors.size());
+            for (uint32_t slot = 0; slot < neighbors.size(); slot++)
+            {
+                uint32_t at = cursor[neighbors[slot]]++;
+                _reverseSources[at] = from;
+                _reverseSlots[at] = slot;
+            }
+        }
+
+        // a hub whose positions do not fit the 16-bit table is searched on demand instead
+        if (count == 0 || count > _options.tableLimit || widest >= kNoTableStep)
+            return;
+
+        // small enough to search from every destination now; each worker slot reuses one queue
+        _table.resize(static_cast<size_t>(count) * count);
+        ThreadPool pool(_options.threads);
+        vector<vector<uint32_t>> queues(pool.Size());
+        pool.ParallelFor(count, [&](uint64_t to, unsigned slot) {
+            search(static_cast<uint32_t>(to), &_table[to * count], queues[slot]);
+        });
+    }
+
+    uint32_t RoutePlanner::NextStep(uint32_t from, uint32_t to) const
+    {
+        uint32_t count = _graph.NodeCount();
+        if (from >= count || to >= count)
+            return kNone;
+        if (from == to)
+            return to;
+        if (_hierarchy)
+        {
+            thread_local vector<uint32_t> route;
+            return _hierarchy->Route(from, to, route) ? route.front() : kNone;
+        }
+        if (IsPrecomputed())
+        {
+            uint16_t step = _table[static_cast<size_t>(to) * count + from];
+            return step == kNoTableStep ? kNone : follow(from, step);
+        }
+        uint32_t step = (*stepsTo(to))[from];
+        return step == kNoStep ? kNone : follow(from, step);
+    }
+
+    bool RoutePlanner::Route(uint32_t from, uint32_t to, vector<uint32_t> &route) const
+    {
+        route.clear();
+        uint32_t count = _graph.NodeCount();
+        if (from >= count || to >= count)
+            return false;
+        if (_hierarchy)
+            return _hierarchy->Route(from, to, route);
+
+        if (IsPrecomputed())
+            return walk(from, to, &_table[static_cast<size_t>(to) * count], route);
+
+        // hold on to the search for the whole walk, however busy the cache is
+        std::shared_ptr<const Steps> cached = stepsTo(to);
+        return walk(from, to, cached->data(), route);
+    }
+
+    uint32_t RoutePlanner::Distance(uint32_t from, uint32_t to) const
+    {
+        vector<uint32_t> route;
+        return Route(from, to, route) ? static_cast<uint32_t>(route.size()) : kNone;
+    }
+
+    bool RoutePlanner::IsPrecomputed() const
+    {
+        return !_table.empty();
+    }
+
+    bool RoutePlanner::IsHierarchical() const
+    {
+        return _hierarchy != nullptr;
+    }
+
+    size_t RoutePlanner::CachedDestinations() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _cache.size();
+    }
+
+    uint32_t RoutePlanner::LocationCount() const
+    {
+        return _graph.NodeCount();
+    }
+
+    template <typename Step>
+    void RoutePlanner::search(uint32_t to, Step *steps, vector<uint32_t> &queue) const
+    {
+        const Step none = std::numeric_limits<Step>::max(); // kNoTableStep or kNoStep
+        uint32_t count = _graph.NodeCount();
+        std::fill(steps, steps + count, none);
+        steps[to] = 0;
+        queue.clear();
+        queue.push_back(to);
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            uint32_t at = queue[head];
+            for (uint32_t r = _reverseOffsets[at]; r < _reverseOffsets[at + 1]; r++)
+            {
+                uint32_t from = _reverseSources[r];
+                if (steps[from] == none)
+                {
+                    steps[from] = static_cast<Step>(_reverseSlots[r]); // fits, or there would be no table
+                    queue.push_back(from);
+                }
+            }
+        }
+    }
+
+    template <typename Step>
+    bool RoutePlanner::walk(uint32_t from, uint32_t to, const Step *steps, vector<uint32_t> &route) const
+    {
+        const Step none = std::numeric_limits<Step>::max();
+        for (uint32_t at = from; at != to;)
+        {
+            if (steps[at] == none)
+            {
+                route.clear();
+                return false;
+            }
+            at = follow(at, steps[at]);
+            route.push_back(at);
+        }
+        return true;
+    }
+
+    std::shared_ptr<const RoutePlanner::Steps> RoutePlanner::stepsTo(uint32_t to) const
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto found = _cache.find(to);
+            if (found != _cache.end())
+            {
+                _cacheOrder.splice(_cacheOrder.begin(), _cacheOrder, found->second.second);
+                return found->second.first;
+            }
+        }
+
+        // search without the lock, so other destinations can be served meanwhile
+        auto steps = std::make_shared<Steps>(_graph.NodeCount());
+        vector<uint32_t> queue;
+        queue.reserve(_graph.NodeCount());
+        search(to, steps->data(), queue);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = _cache.find(to);
+        if (found != _cache.end())
+            return found->second.first; // another thread searched it first
+        _cacheOrder.push_front(to);
+        _cache.emplace(to, std::make_pair(steps, _cacheOrder.begin()));
+        while (_cache.size() > std::max<uint32_t>(_options.cacheSize, 1))
+        {
+            _cache.erase(_cacheOrder.back());
+            _cacheOrder.pop_back();
+        }
+        return steps;
+    }
+
+    uint32_t RoutePlanner::follow(uint32_t from, uint32_t step) const
+    {
+        return _graph.Neighbors(from)[step];
+    }
+}
@@ -0,0 +1,114 @@
+/**
+ * @file SymbolTable.cpp
+ * @brief Implementation of the SymbolTable class, the global name interner.
+ *
+ * Names are keyed by their lowercase form, or as they are in a table that does not fold case. The names themselves live in chunks of `kChunkSize` strings that are
+ * allocated as the table grows and never moved, so `Name` can index them without taking the lock; only finding or
+ * adding a name goes through the mutex.
+ *
+ * **Methods**:
+ * - `static SymbolTable& Global()`, `static SymbolTable& Text()`: Return the program-wide tables of names and of text.
+ * - `Symbol Intern(string_view name)`: Finds or adds a name.
+ * - `Symbol Find(string_view name) const`: Finds a name without adding it, folding it into a per-thread buffer.
+ * - `const string& Name(Symbol symbol) const`: Indexes the chunk holding a symbol's name.
+ * - `uint32_t Size() const`: Returns the number of names.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "SymbolTable.hpp"
+#include <cctype>
+#include <mutex>
+#include <stdexcept>
+
+namespace chants
+{
+    SymbolTable::SymbolTable(bool foldCase) : _foldCase(foldCase), _chunks(new std::atomic<string *>[kMaxChunks]), _size(0)
+    {
+        for (uint32_t i = 0; i < kMaxChunks; i++)
+        {
+            _chunks[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    SymbolTable &SymbolTable::Global()
+    {
+        // never destroyed, so objects torn down at exit can still look up their names
+        static SymbolTable *table = new SymbolTable();
+        return *table;
+    }
+
+    SymbolTable &SymbolTable::Text()
+    {
+        static SymbolTable *table = new SymbolTable(false);
+        return *table;
+    }
+
+    void SymbolTable::fold(string_view name, string &folded) const
+    {
+        folded.assign(name);
+        if (!_foldCase)
+            return;
+        for (char &c : folded)
+        {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+    }
+
+    Symbol SymbolTable::Intern(string_view name)
+    {
+        string key;
+        fold(name, key);
+        {
+            std::shared_lock<std::shared_mutex> lock(_mutex);
+            auto found = _symbols.find(key);
+            if (found != _symbols.end())
+                return found->second;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        auto found = _symbols.find(key);
+        if (found != _symbols.end())
+            return found->second;
+
+        Symbol symbol = _size.load(std::memory_order_relaxed);
+        uint32_t chunk = symbol >> kChunkBits;
+        if (chunk >= kMaxChunks)
+            throw std::length_error("symbol table is full");
+        string *names = _chunks[chunk].load(std::memory_order_relaxed);
+        if (!names)
+        {
+            names = new string[kChunkSize];
+            _chunks[chunk].store(names, std::memory_order_release);
+        }
+        names[symbol & (kChunkSize - 1)] = string(name);
+        _symbols.emplace(std::move(key), symbol);
+        _size.store(symbol + 1, std::memory_order_release);
+        return symbol;
+    }
+
+    Symbol SymbolTable::Find(string_view name) const
+    {
+        thread_local string key; // kept between lookups, so resolving a typed name does not allocate
+        fold(name, key);
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        auto found = _symbols.find(key);
+        return found == _symbols.end() ? kNoSymbol : found->second;
+    }
+
+    const string &SymbolTable::Name(Symbol symbol) const
+    {
+        static const string unknown;
+        if (symbol >= _size.load(std::memory_order_acquire))
+            return unknown;
+        return _chunks[symbol >> kChunkBits].load(std::memory_order_acquire)[symbol & (kChunkSize - 1)];
+    }
+
+    uint32_t SymbolTable::Size() const
+    {
+        return _size.load(std::memory_order_relaxed);
+    }
+}
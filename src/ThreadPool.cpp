@@ -0,0 +1,201 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementation of the ThreadPool class.
+ *
+ * `ParallelFor` submits one task per worker; the tasks claim items from a shared atomic counter until the range is
+ * used up, so uneven items balance out, and the caller waits on a count of tasks still running rather than on the
+ * whole pool, so other submitted work does not hold it up.
+ *
+ * `ParallelForStealing` gives every task a share of its own instead, a range of items packed into one atomic word:
+ * the owner takes items from the front of its share, and a task whose share runs out steals the back half of the
+ * largest share left. Both sides claim with a compare-and-swap on the victim's word, so an item is run exactly once,
+ * and while every task has work of its own no cache line is shared between them.
+ *
+ * **Methods**:
+ * - `ThreadPool(unsigned threads)`: Starts the workers.
+ * - `~ThreadPool()`: Sets the stop flag once the queue is empty and joins the workers.
+ * - `unsigned Size() const`: Returns the number of workers.
+ * - `void Submit(std::function<void()> task)`: Queues a task and wakes a worker.
+ * - `void Wait()`: Waits for an empty queue and no running tasks.
+ * - `void ParallelFor(uint64_t count, const std::function<void(uint64_t, unsigned)>& body)`: Spreads items over one task per worker.
+ * - `void ParallelForStealing(uint32_t count, const std::function<void(uint64_t, unsigned)>& body)`: Splits the items into one share per task and lets idle tasks steal.
+ * - `void workerLoop()`: Private method run by every worker.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace chants
+{
+    ThreadPool::ThreadPool(unsigned threads) : _active(0), _stop(false)
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        _workers.reserve(threads);
+        for (unsigned i = 0; i < threads; i++)
+        {
+            _workers.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        Wait();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (std::thread &worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    unsigned ThreadPool::Size() const
+    {
+        return static_cast<unsigned>(_workers.size());
+    }
+
+    void ThreadPool::Submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push_back(std::move(task));
+        }
+        _wake.notify_one();
+    }
+
+    void ThreadPool::Wait()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this] { return _tasks.empty() && _active == 0; });
+    }
+
+    void ThreadPool::ParallelFor(uint64_t count, const std::function<void(uint64_t item, unsigned slot)> &body)
+    {
+        if (count == 0)
+            return;
+
+        std::atomic<uint64_t> next(0);
+        std::mutex doneMutex;
+        std::condition_variable doneSignal;
+        unsigned slots = static_cast<unsigned>(std::min<uint64_t>(Size(), count));
+        unsigned running = slots;
+
+        for (unsigned slot = 0; slot < slots; slot++)
+        {
+            Submit([&, slot] {
+                for (uint64_t item = next.fetch_add(1); item < count; item = next.fetch_add(1))
+                {
+                    body(item, slot);
+                }
+                std::lock_guard<std::mutex> lock(doneMutex);
+                if (--running == 0)
+                    doneSignal.notify_one();
+            });
+        }
+
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneSignal.wait(lock, [&] { return running == 0; });
+    }
+
+    void ThreadPool::ParallelForStealing(uint32_t count, const std::function<void(uint64_t item, unsigned slot)> &body)
+    {
+        if (count == 0)
+            return;
+
+        // a share is the items [begin, end), with begin in the low and end in the high 32 bits
+        struct alignas(64) Share
+        {
+            std::atomic<uint64_t> range;
+        };
+        auto pack = [](uint64_t begin, uint64_t end) { return (end << 32) | begin; };
+
+        unsigned slots = static_cast<unsigned>(std::min<uint64_t>(Size(), count));
+        std::vector<Share> shares(slots);
+        for (unsigned slot = 0; slot < slots; slot++)
+        {
+            shares[slot].range.store(pack(uint64_t(count) * slot / slots, uint64_t(count) * (slot + 1) / slots), std::memory_order_relaxed);
+        }
+
+        std::mutex doneMutex;
+        std::condition_variable doneSignal;
+        unsigned running = slots;
+        for (unsigned slot = 0; slot < slots; slot++)
+        {
+            Submit([&, slot] {
+                std::atomic<uint64_t> &own = shares[slot].range;
+                while (true)
+                {
+                    uint64_t range = own.load(std::memory_order_acquire);
+                    uint64_t begin = range & 0xFFFFFFFFu;
+                    uint64_t end = range >> 32;
+                    if (begin < end)
+                    {
+                        if (own.compare_exchange_weak(range, pack(begin + 1, end), std::memory_order_acq_rel))
+                            body(begin, slot);
+                        continue;
+                    }
+
+                    // out of work: take the back half of the largest share left
+                    unsigned victim = slots;
+                    uint64_t largest = 0;
+                    for (unsigned other = 0; other < slots; other++)
+                    {
+                        uint64_t theirs = shares[other].range.load(std::memory_order_relaxed);
+                        uint64_t left = (theirs >> 32) - (theirs & 0xFFFFFFFFu);
+                        if ((theirs >> 32) > (theirs & 0xFFFFFFFFu) && left > largest)
+                        {
+                            largest = left;
+                            victim = other;
+                        }
+                    }
+                    if (victim == slots)
+                        break;
+                    uint64_t theirs = shares[victim].range.load(std::memory_order_acquire);
+                    uint64_t theirBegin = theirs & 0xFFFFFFFFu;
+                    uint64_t theirEnd = theirs >> 32;
+                    if (theirBegin >= theirEnd)
+                        continue;
+                    uint64_t middle = theirBegin + (theirEnd - theirBegin) / 2;
+                    if (shares[victim].range.compare_exchange_strong(theirs, pack(theirBegin, middle), std::memory_order_acq_rel))
+                        own.store(pack(middle, theirEnd), std::memory_order_release); // others may steal it in turn
+                }
+                std::lock_guard<std::mutex> lock(doneMutex);
+                if (--running == 0)
+                    doneSignal.notify_one();
+            });
+        }
+
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneSignal.wait(lock, [&] { return running == 0; });
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true)
+        {
+            _wake.wait(lock, [this] { return _stop || !_tasks.empty(); });
+            if (_tasks.empty())
+                return; // stopping, and nothing left to run
+
+            std::function<void()> task = std::move(_tasks.front());
+            _tasks.pop_front();
+            _active++;
+            lock.unlock();
+            task();
+            lock.lock();
+            _active--;
+            if (_tasks.empty() && _active == 0)
+                _idle.notify_all();
+        }
+    }
+}
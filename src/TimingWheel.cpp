@@ -0,0 +1,186 @@
+/**
+ * @file TimingWheel.cpp
+ * @brief Implementation of the TimingWheel class, a hierarchical timing wheel for events due at a later tick.
+ *
+ * A timer sits at the level of the highest group of 6 bits in which its due tick differs from the clock, in the slot
+ * given by that group of the due tick. The slot comes round when the clock reaches the due tick with the bits below
+ * the group cleared, which is after the timer was placed and no later than it is due; the timer then drops to a
+ * lower level. Cascading runs top level first at each tick, before the level 0 slot of the tick fires, so a timer
+ * cascaded onto the current tick still fires on it. Only `Schedule` can see a timer due already, and chains it onto
+ * a late list that the next `Advance` fires first.
+ *
+ * Timers live in one vector and are chained through indices, and fired timers go back on a free list, so a wheel
+ * whose timers come and go at a steady rate stops allocating once it has grown to the most it ever held. Slots are
+ * unordered; the timers fired by one `Advance` are sorted by due tick and scheduling order before they are returned.
+ *
+ * **Methods**:
+ * - `TimingWheel(uint64_t now)`, `void Reset(uint64_t now)`: Empty every slot and set the clock.
+ * - `void Schedule(uint32_t id, uint64_t due)`: Takes a free entry and places it, or chains it onto the late list if it is due already.
+ * - `void Advance(uint64_t now, vector<Timer>& fired)`: Fires late timers, then ticks the clock forward, cascading and firing slots.
+ * - `void Pending(vector<Timer>& timers) const`: Collects every chained timer and sorts them.
+ * - `uint64_t Now() const`, `size_t Size() const`, `size_t MemoryUsage() const`: Report on the wheel.
+ * - `void place(uint32_t entry)`: Private method that picks the level from the highest bit in which the due tick and the clock differ.
+ * - `void push(uint32_t& head, uint32_t entry)`, `void drain(uint32_t& head, vector<Timer>& fired)`, `void cascade(uint32_t& head)`: Private methods that manage the chained lists.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "TimingWheel.hpp"
+#include <algorithm>
+
+namespace chants
+{
+    static bool firesBefore(const TimingWheel::Timer &left, const TimingWheel::Timer &right)
+    {
+        return left.due != right.due ? left.due < right.due : left.sequence < right.sequence;
+    }
+
+    TimingWheel::TimingWheel(uint64_t now)
+    {
+        Reset(now);
+    }
+
+    void TimingWheel::Reset(uint64_t now)
+    {
+        _now = now;
+        _sequence = 0;
+        _entries.clear();
+        _free = kEnd;
+        for (auto &level : _slots)
+        {
+            std::fill(std::begin(level), std::end(level), kEnd);
+        }
+        _overflow = kEnd;
+        _late = kEnd;
+        _size = 0;
+    }
+
+    void TimingWheel::Schedule(uint32_t id, uint64_t due)
+    {
+        uint32_t entry = _free;
+        if (entry != kEnd)
+            _free = _entries[entry].next;
+        else
+        {
+            entry = static_cast<uint32_t>(_entries.size());
+            _entries.push_back(Entry());
+        }
+        _entries[entry].timer = Timer{id, due, _sequence++};
+        _size++;
+        if (due <= _now)
+            push(_late, entry); // the slot for this tick has fired already
+        else
+            place(entry);
+    }
+
+    void TimingWheel::Advance(uint64_t now, vector<Timer> &fired)
+    {
+        fired.clear();
+        drain(_late, fired);
+        while (_now < now)
+        {
+            _now++;
+            if (_size == fired.size())
+            {
+                _now = now; // nothing left to fire, so the slots in between are all empty
+                break;
+            }
+
+            // levels whose slot comes round on this tick, top down
+            uint32_t top = 0;
+            while (top + 1 < kLevels && (_now & ((uint64_t(1) << (kSlotBits * (top + 1))) - 1)) == 0)
+            {
+                top++;
+            }
+            if (top == kLevels - 1 && (_now & ((uint64_t(1) << (kSlotBits * kLevels)) - 1)) == 0)
+                cascade(_overflow);
+            for (uint32_t level = top; level > 0; level--)
+            {
+                cascade(_slots[level][(_now >> (kSlotBits * level)) & (kSlots - 1)]);
+            }
+            drain(_slots[0][_now & (kSlots - 1)], fired);
+        }
+        _size -= fired.size();
+        std::sort(fired.begin(), fired.end(), firesBefore);
+    }
+
+    void TimingWheel::Pending(vector<Timer> &timers) const
+    {
+        timers.clear();
+        vector<bool> free(_entries.size());
+        for (uint32_t entry = _free; entry != kEnd; entry = _entries[entry].next)
+        {
+            free[entry] = true;
+        }
+        for (uint32_t entry = 0; entry < _entries.size(); entry++)
+        {
+            if (!free[entry])
+                timers.push_back(_entries[entry].timer);
+        }
+        std::sort(timers.begin(), timers.end(), firesBefore);
+    }
+
+    uint64_t TimingWheel::Now() const
+    {
+        return _now;
+    }
+
+    size_t TimingWheel::Size() const
+    {
+        return _size;
+    }
+
+    size_t TimingWheel::MemoryUsage() const
+    {
+        return sizeof(*this) + _entries.capacity() * sizeof(Entry);
+    }
+
+    void TimingWheel::place(uint32_t entry)
+    {
+        uint64_t due = _entries[entry].timer.due;
+        // the highest group of bits in which the due tick differs from the clock picks the level; a timer cascaded onto
+        // the current tick lands in its level 0 slot, which fires next
+        uint64_t differ = due ^ _now;
+        for (uint32_t level = 0; level < kLevels; level++)
+        {
+            if ((differ >> (kSlotBits * (level + 1))) == 0)
+            {
+                push(_slots[level][(due >> (kSlotBits * level)) & (kSlots - 1)], entry);
+                return;
+            }
+        }
+        push(_overflow, entry);
+    }
+
+    void TimingWheel::push(uint32_t &head, uint32_t entry)
+    {
+        _entries[entry].next = head;
+        head = entry;
+    }
+
+    void TimingWheel::drain(uint32_t &head, vector<Timer> &fired)
+    {
+        while (head != kEnd)
+        {
+            uint32_t entry = head;
+            head = _entries[entry].next;
+            fired.push_back(_entries[entry].timer);
+            push(_free, entry);
+        }
+    }
+
+    void TimingWheel::cascade(uint32_t &head)
+    {
+        uint32_t entry = head;
+        head = kEnd;
+        while (entry != kEnd)
+        {
+            uint32_t next = _entries[entry].next;
+            place(entry);
+            entry = next;
+        }
+    }
+}
@@ -0,0 +1,251 @@
+/**
+ * @file Tracer.cpp
+ * @brief Implementation of the Tracer class, recording scoped spans into a Chrome trace-event timeline.
+ *
+ * A ring's owner publishes a span by storing it and then advancing the head with release order; the drain thread
+ * reads the head with acquire order, copies the spans up to it and advances the tail, which the owner reads with
+ * acquire order before it reuses a slot. Neither side ever waits for the other.
+ *
+ * Rings are made under the tracer's lock the first time a thread records a span, and kept for the life of the
+ * process, so the drain thread can read a list of them copied under the lock and drain them without it. Spans left
+ * in a ring when a trace stops are thrown away when the next one starts.
+ *
+ * The file is JSON in the trace-event format: complete (`"ph":"X"`) events with times in microseconds, one thread
+ * per ring, named when its ring is first drained, and a counter of dropped spans per thread at the end.
+ *
+ * **Methods**:
+ * - `TraceRing(uint32_t size)`: Rounds the size up to a power of two.
+ * - `bool TraceRing::Push(const TraceEvent& event)`, `size_t TraceRing::Drain(vector<TraceEvent>& events)`, `uint64_t TraceRing::Dropped() const`: The two ends of the ring.
+ * - `void Tracer::Start(const string& path, uint32_t ringSize)`: Opens the file, empties the rings, sets the clock and starts the drain thread.
+ * - `void Tracer::Stop()`: Stops recording and the drain thread, drains once more and closes the file.
+ * - `uint64_t Tracer::Now()`: Reads the steady clock against the start of the trace.
+ * - `void Tracer::Record(const char* name, uint64_t start, uint64_t end)`: Pushes a span into the calling thread's ring, making it on first use.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "Tracer.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace chants
+{
+    namespace
+    {
+        struct TraceState
+        {
+            std::mutex mutex;
+            vector<std::unique_ptr<TraceRing>> rings;
+            uint32_t ringSize = Tracer::kRingSize;
+            std::atomic<int64_t> origin{0}; // steady clock nanoseconds at the start of the trace
+            std::FILE *file = nullptr;
+            size_t named = 0;              // rings whose thread has been named in the file
+            vector<uint64_t> droppedBefore; // spans each ring had dropped when the trace started
+            bool stopping = false;
+            std::condition_variable wake;
+            std::thread drainer;
+        };
+
+        TraceState &state()
+        {
+            static TraceState *shared = new TraceState(); // never destroyed, threads may record while the process exits
+            return *shared;
+        }
+
+        int64_t steadyNanoseconds()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        void appendMicroseconds(string &text, uint64_t nanoseconds)
+        {
+            char number[32];
+            std::snprintf(number, sizeof(number), "%llu.%03llu", static_cast<unsigned long long>(nanoseconds / 1000),
+                          static_cast<unsigned long long>(nanoseconds % 1000));
+            text += number;
+        }
+
+        // drains every ring into the file; only the drain thread, or Stop once it has joined it, calls this
+        void drainAll(TraceState &shared, vector<TraceEvent> &events, string &text)
+        {
+            vector<TraceRing *> rings;
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                for (const std::unique_ptr<TraceRing> &ring : shared.rings)
+                {
+                    rings.push_back(ring.get());
+                }
+            }
+            text.clear();
+            for (; shared.named < rings.size(); shared.named++)
+            {
+                string thread = std::to_string(shared.named + 1);
+                text += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + thread + ",\"args\":{\"name\":\"thread " + thread + "\"}}";
+            }
+            for (size_t at = 0; at < rings.size(); at++)
+            {
+                events.clear();
+                rings[at]->Drain(events);
+                string thread = std::to_string(at + 1);
+                for (const TraceEvent &event : events)
+                {
+                    text += ",\n{\"name\":\"";
+                    text += event.name;
+                    text += "\",\"cat\":\"chants\",\"ph\":\"X\",\"pid\":1,\"tid\":" + thread + ",\"ts\":";
+                    appendMicroseconds(text, event.start);
+                    text += ",\"dur\":";
+                    appendMicroseconds(text, event.end - event.start);
+                    text += "}";
+                }
+            }
+            std::fwrite(text.data(), 1, text.size(), shared.file);
+        }
+    }
+
+    TraceRing::TraceRing(uint32_t size) : _head(0), _dropped(0), _tail(0)
+    {
+        uint64_t capacity = 1;
+        while (capacity < size)
+        {
+            capacity <<= 1;
+        }
+        _events.resize(capacity);
+        _mask = capacity - 1;
+    }
+
+    bool TraceRing::Push(const TraceEvent &event)
+    {
+        uint64_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) > _mask)
+        {
+            _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        _events[head & _mask] = event;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t TraceRing::Drain(vector<TraceEvent> &events)
+    {
+        uint64_t tail = _tail.load(std::memory_order_relaxed);
+        uint64_t head = _head.load(std::memory_order_acquire);
+        for (uint64_t at = tail; at != head; at++)
+        {
+            events.push_back(_events[at & _mask]);
+        }
+        _tail.store(head, std::memory_order_release);
+        return static_cast<size_t>(head - tail);
+    }
+
+    uint64_t TraceRing::Dropped() const
+    {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+    void Tracer::Start(const string &path, uint32_t ringSize)
+    {
+        TraceState &shared = state();
+        if (shared.file)
+            throw std::runtime_error("a trace is already running");
+        shared.file = std::fopen(path.c_str(), "wb");
+        if (!shared.file)
+            throw std::runtime_error("cannot write trace to " + path);
+        std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                   "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"chants\"}}",
+                   shared.file);
+
+        vector<TraceEvent> stale;
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.ringSize = ringSize;
+            shared.named = 0;
+            shared.stopping = false;
+            shared.droppedBefore.clear();
+            for (const std::unique_ptr<TraceRing> &ring : shared.rings)
+            {
+                ring->Drain(stale); // left from an earlier trace
+                shared.droppedBefore.push_back(ring->Dropped());
+            }
+        }
+        shared.origin.store(steadyNanoseconds(), std::memory_order_relaxed);
+        _enabled.store(true, std::memory_order_release);
+
+        shared.drainer = std::thread([&shared] {
+            vector<TraceEvent> events;
+            string text;
+            std::unique_lock<std::mutex> lock(shared.mutex);
+            while (!shared.stopping)
+            {
+                shared.wake.wait_for(lock, std::chrono::milliseconds(kDrainInterval));
+                lock.unlock();
+                drainAll(shared, events, text);
+                lock.lock();
+            }
+        });
+    }
+
+    void Tracer::Stop()
+    {
+        TraceState &shared = state();
+        if (!shared.file)
+            return;
+        _enabled.store(false, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.stopping = true;
+        }
+        shared.wake.notify_one();
+        shared.drainer.join();
+
+        vector<TraceEvent> events;
+        string text;
+        drainAll(shared, events, text);
+        uint64_t end = Now();
+        text.clear();
+        std::lock_guard<std::mutex> lock(shared.mutex); // a thread may still be making its ring
+        for (size_t at = 0; at < shared.rings.size(); at++)
+        {
+            uint64_t before = at < shared.droppedBefore.size() ? shared.droppedBefore[at] : 0;
+            if (uint64_t dropped = shared.rings[at]->Dropped() - before)
+            {
+                text += ",\n{\"name\":\"dropped spans\",\"ph\":\"C\",\"pid\":1,\"tid\":" + std::to_string(at + 1) + ",\"ts\":";
+                appendMicroseconds(text, end);
+                text += ",\"args\":{\"spans\":" + std::to_string(dropped) + "}}";
+            }
+        }
+        text += "\n]}\n";
+        std::fwrite(text.data(), 1, text.size(), shared.file);
+        bool written = std::ferror(shared.file) == 0;
+        written = std::fclose(shared.file) == 0 && written;
+        shared.file = nullptr;
+        if (!written)
+            throw std::runtime_error("cannot finish the trace file");
+    }
+
+    uint64_t Tracer::Now()
+    {
+        return static_cast<uint64_t>(steadyNanoseconds() - state().origin.load(std::memory_order_relaxed));
+    }
+
+    void Tracer::Record(const char *name, uint64_t start, uint64_t end)
+    {
+        thread_local TraceRing *ring = nullptr;
+        if (!ring)
+        {
+            TraceState &shared = state();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.rings.push_back(std::make_unique<TraceRing>(shared.ringSize));
+            ring = shared.rings.back().get();
+        }
+        ring->Push(TraceEvent{name, start, end});
+    }
+}
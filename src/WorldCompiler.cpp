@@ -0,0 +1,418 @@
+/**
+ * @file WorldCompiler.cpp
+ * @brief Implementation of the world compiler, parsing text worlds and writing binary world files.
+ *
+ * Parsing is line based. Node, asset and monster definitions are collected first; paths and placements may
+ * refer to them by id or by name, so those references are resolved once the whole file has been read. Writing
+ * lays the sections out back to back, 8-byte aligned, behind a `WorldFile::Header`, with identical strings
+ * stored once in the string blob, and partitions the map into regions with `RegionPartition::Build`.
+ *
+ * **Functions**:
+ * - `WorldSource ParseWorldText(istream& in, const string& sourceName)`: Parses a text world.
+ * - `void WriteWorldFile(const WorldSource& world, const string& path)`: Writes a binary world file.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "WorldCompiler.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace chants
+{
+    namespace
+    {
+        struct Token
+        {
+            string text;
+            bool quoted;
+        };
+
+        const std::unordered_map<string, AssetCategory> kAssetCategories = {
+            {"passive", AssetCategory::Passive},
+            {"offensive", AssetCategory::Offensive},
+            {"healing", AssetCategory::Healing},
+            {"navigation", AssetCategory::Navigation},
+        };
+
+        // a path or placement whose targets are resolved after every definition has been read
+        struct Reference
+        {
+            int line;
+            vector<Token> tokens;
+        };
+
+        [[noreturn]] void fail(const string &sourceName, int line, const string &message)
+        {
+            throw std::runtime_error(sourceName + ":" + std::to_string(line) + ": " + message);
+        }
+
+        vector<Token> tokenize(const string &text, const string &sourceName, int line)
+        {
+            vector<Token> tokens;
+            size_t i = 0;
+            while (i < text.size())
+            {
+                char c = text[i];
+                if (std::isspace(static_cast<unsigned char>(c)))
+                {
+                    i++;
+                }
+                else if (c == '#')
+                {
+                    break;
+                }
+                else if (c == '"')
+                {
+                    Token token{"", true};
+                    for (i++; i < text.size() && text[i] != '"'; i++)
+                    {
+                        if (text[i] == '\\' && i + 1 < text.size())
+                        {
+                            char escaped = text[++i];
+                            token.text += escaped == 'n' ? '\n' : escaped;
+                        }
+                        else
+                        {
+                            token.text += text[i];
+                        }
+                    }
+                    if (i >= text.size())
+                        fail(sourceName, line, "unterminated quoted text");
+                    i++;
+                    tokens.push_back(token);
+                }
+                else
+                {
+                    size_t end = i;
+                    while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end])) && text[end] != '#')
+                        end++;
+                    tokens.push_back(Token{text.substr(i, end - i), false});
+                    i = end;
+                }
+            }
+            return tokens;
+        }
+
+        int parseInt(const Token &token, const string &sourceName, int line)
+        {
+            if (token.quoted || token.text.empty() ||
+                !std::all_of(token.text.begin() + (token.text[0] == '-' ? 1 : 0), token.text.end(), ::isdigit))
+                fail(sourceName, line, "expected a number, found '" + token.text + "'");
+            try
+            {
+                return std::stoi(token.text);
+            }
+            catch (const std::out_of_range &)
+            {
+                fail(sourceName, line, "number out of range: " + token.text);
+            }
+        }
+
+        class StringBlob
+        {
+        public:
+            WorldFile::StringRef Add(const string &text)
+            {
+                auto found = _offsets.find(text);
+                if (found != _offsets.end())
+                    return found->second;
+                if (_data.size() + text.size() > UINT32_MAX)
+                    throw std::runtime_error("world text does not fit in a world file");
+                WorldFile::StringRef ref{static_cast<uint32_t>(_data.size()), static_cast<uint32_t>(text.size())};
+                _data += text;
+                _offsets.emplace(text, ref);
+                return ref;
+            }
+
+            const string &Data() const { return _data; }
+
+        private:
+            string _data;
+            std::unordered_map<string, WorldFile::StringRef> _offsets;
+        };
+
+        uint64_t align8(uint64_t offset)
+        {
+            return (offset + 7) & ~uint64_t(7);
+        }
+    }
+
+    WorldSource ParseWorldText(istream &in, const string &sourceName)
+    {
+        WorldSource world;
+        vector<bool> defined;
+        vector<Reference> paths;
+        vector<Reference> placements;
+        std::unordered_map<string, uint32_t> nodeIds, assetIds, monsterIds;
+
+        string text;
+        int line = 0;
+        while (std::getline(in, text))
+        {
+            line++;
+            vector<Token> tokens = tokenize(text, sourceName, line);
+            if (tokens.empty())
+                continue;
+
+            const string &keyword = tokens[0].text;
+            if (keyword == "node")
+            {
+                if (tokens.size() < 3 || tokens.size() > 4)
+                    fail(sourceName, line, "expected: node <id> \"<name>\" [\"<description>\"]");
+                int id = parseInt(tokens[1], sourceName, line);
+                if (id < 0)
+                    fail(sourceName, line, "node ids cannot be negative");
+                if (static_cast<size_t>(id) >= world.nodes.size())
+                {
+                    world.nodes.resize(id + 1);
+                    defined.resize(id + 1, false);
+                }
+                if (defined[id])
+                    fail(sourceName, line, "node " + std::to_string(id) + " is defined twice");
+                defined[id] = true;
+                world.nodes[id].name = tokens[2].text;
+                world.nodes[id].description = tokens.size() == 4 ? tokens[3].text : "";
+                nodeIds.emplace(tokens[2].text, id);
+            }
+            else if (keyword == "path")
+            {
+                if (tokens.size() < 3)
+                    fail(sourceName, line, "expected: path <from> <to> [<to> ...]");
+                paths.push_back(Reference{line, tokens});
+            }
+            else if (keyword == "asset")
+            {
+                auto category = tokens.size() == 5 ? kAssetCategories.find(tokens[3].text) : kAssetCategories.end();
+                if (category == kAssetCategories.end())
+                    fail(sourceName, line, "expected: asset \"<name>\" <value> offensive|healing|navigation|passive \"<message>\"");
+                if (assetIds.count(tokens[1].text))
+                    fail(sourceName, line, "asset '" + tokens[1].text + "' is defined twice");
+                assetIds.emplace(tokens[1].text, static_cast<uint32_t>(world.assets.size()));
+                world.assets.push_back(WorldSource::AssetDef{tokens[1].text, tokens[4].text,
+                                                             parseInt(tokens[2], sourceName, line),
+                                                             category->second});
+            }
+            else if (keyword == "monster")
+            {
+                if (tokens.size() != 4)
+                    fail(sourceName, line, "expected: monster \"<name>\" <health> <fight coefficient>");
+                if (monsterIds.count(tokens[1].text))
+                    fail(sourceName, line, "monster '" + tokens[1].text + "' is defined twice");
+                int coefficient = parseInt(tokens[3], sourceName, line);
+                if (coefficient <= 0)
+                    fail(sourceName, line, "fight coefficient must be positive");
+                monsterIds.emplace(tokens[1].text, static_cast<uint32_t>(world.monsters.size()));
+                world.monsters.push_back(WorldSource::MonsterDef{tokens[1].text, parseInt(tokens[2], sourceName, line),
+                                                                 coefficient});
+            }
+            else if (keyword == "regions")
+            {
+                if (tokens.size() != 2)
+                    fail(sourceName, line, "expected: regions <locations per region>");
+                int size = parseInt(tokens[1], sourceName, line);
+                if (size <= 0)
+                    fail(sourceName, line, "region size must be positive");
+                world.regionSize = static_cast<uint32_t>(size);
+            }
+            else if (keyword == "place")
+            {
+                if (tokens.size() < 4 || tokens.size() > 5 || (tokens[1].text != "asset" && tokens[1].text != "monster"))
+                    fail(sourceName, line, "expected: place asset|monster \"<name>\" <node>|random [<count>]");
+                placements.push_back(Reference{line, tokens});
+            }
+            else
+            {
+                fail(sourceName, line, "unknown keyword '" + keyword + "'");
+            }
+        }
+
+        for (size_t id = 0; id < defined.size(); id++)
+        {
+            if (!defined[id])
+                throw std::runtime_error(sourceName + ": node " + std::to_string(id) + " is missing; node ids must run from 0 without gaps");
+        }
+
+        auto resolveNode = [&](const Token &token, int refLine) -> uint32_t {
+            if (!token.quoted)
+            {
+                int id = parseInt(token, sourceName, refLine);
+                if (id < 0 || static_cast<size_t>(id) >= world.nodes.size())
+                    fail(sourceName, refLine, "node " + token.text + " does not exist");
+                return static_cast<uint32_t>(id);
+            }
+            auto found = nodeIds.find(token.text);
+            if (found == nodeIds.end())
+                fail(sourceName, refLine, "node '" + token.text + "' does not exist");
+            return found->second;
+        };
+
+        world.graph = WorldGraph(static_cast<uint32_t>(world.nodes.size()));
+        for (const auto &path : paths)
+        {
+            uint32_t from = resolveNode(path.tokens[1], path.line);
+            for (size_t i = 2; i < path.tokens.size(); i++)
+            {
+                world.graph.AddEdge(from, resolveNode(path.tokens[i], path.line));
+            }
+        }
+        world.graph.Finalize();
+
+        for (const auto &place : placements)
+        {
+            bool isAsset = place.tokens[1].text == "asset";
+            const auto &ids = isAsset ? assetIds : monsterIds;
+            auto object = ids.find(place.tokens[2].text);
+            if (object == ids.end())
+                fail(sourceName, place.line, place.tokens[1].text + " '" + place.tokens[2].text + "' is not defined");
+
+            const Token &where = place.tokens[3];
+            uint32_t node = !where.quoted && where.text == "random" ? WorldFile::kRandomNode : resolveNode(where, place.line);
+            int count = place.tokens.size() == 5 ? parseInt(place.tokens[4], sourceName, place.line) : 1;
+            for (int i = 0; i < count; i++)
+            {
+                world.placements.push_back(WorldFile::Placement{
+                    isAsset ? WorldFile::PlacementKind::Asset : WorldFile::PlacementKind::Monster, object->second, node});
+            }
+        }
+        return world;
+    }
+
+    void WriteWorldFile(const WorldSource &world, const string &path)
+    {
+        StringBlob strings;
+        vector<WorldFile::NodeRecord> nodes;
+        nodes.reserve(world.nodes.size());
+        for (const auto &node : world.nodes)
+        {
+            nodes.push_back(WorldFile::NodeRecord{strings.Add(node.name), strings.Add(node.description)});
+        }
+
+        vector<WorldFile::AssetRecord> assets;
+        for (const auto &asset : world.assets)
+        {
+            assets.push_back(WorldFile::AssetRecord{strings.Add(asset.name), strings.Add(asset.message), asset.value,
+                                                    WorldFile::CategoryFlags(asset.category)});
+        }
+
+        vector<WorldFile::MonsterRecord> monsters;
+        for (const auto &monster : world.monsters)
+        {
+            monsters.push_back(WorldFile::MonsterRecord{strings.Add(monster.name), monster.health, monster.fightCoefficient});
+        }
+
+        vector<WorldFile::PlacementRecord> placements;
+        for (const auto &placement : world.placements)
+        {
+            placements.push_back(WorldFile::PlacementRecord{static_cast<uint32_t>(placement.kind), placement.object,
+                                                            placement.node, 0});
+        }
+
+        // the graph may still have staged edges, so pack a copy the way the file stores it
+        WorldGraph graph = world.graph;
+        graph.Finalize();
+        uint32_t nodeCount = static_cast<uint32_t>(world.nodes.size());
+        if (graph.NodeCount() > nodeCount)
+            throw std::runtime_error("world has paths to nodes that are not defined");
+        vector<uint32_t> offsets(nodeCount + 1, 0);
+        vector<uint32_t> targets;
+        targets.reserve(graph.EdgeCount());
+        for (uint32_t node = 0; node < nodeCount; node++)
+        {
+            for (uint32_t neighbor : graph.Neighbors(node))
+            {
+                targets.push_back(neighbor);
+            }
+            offsets[node + 1] = static_cast<uint32_t>(targets.size());
+        }
+
+        RegionPartition regions = RegionPartition::Build(graph, world.regionSize);
+        vector<uint32_t> regionOf(nodeCount), memberOffsets(regions.RegionCount() + 1, 0), members;
+        vector<uint32_t> regionPathOffsets(regions.RegionCount() + 1, 0), regionPaths;
+        members.reserve(nodeCount);
+        for (uint32_t node = 0; node < nodeCount; node++)
+        {
+            regionOf[node] = regions.RegionOf(node);
+        }
+        for (uint32_t region = 0; region < regions.RegionCount(); region++)
+        {
+            for (uint32_t member : regions.Members(region))
+            {
+                members.push_back(member);
+            }
+            memberOffsets[region + 1] = static_cast<uint32_t>(members.size());
+            for (uint32_t neighbor : regions.Adjacency().Neighbors(region))
+            {
+                regionPaths.push_back(neighbor);
+            }
+            regionPathOffsets[region + 1] = static_cast<uint32_t>(regionPaths.size());
+        }
+
+        WorldFile::Header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, WorldFile::kMagic, sizeof(header.magic));
+        header.version = WorldFile::kVersion;
+        header.nodeCount = nodeCount;
+        header.edgeCount = static_cast<uint32_t>(targets.size());
+        header.assetCount = static_cast<uint32_t>(assets.size());
+        header.monsterCount = static_cast<uint32_t>(monsters.size());
+        header.placementCount = static_cast<uint32_t>(placements.size());
+        header.regionCount = regions.RegionCount();
+        header.regionEdgeCount = static_cast<uint32_t>(regionPaths.size());
+
+        uint64_t offset = align8(sizeof(header));
+        auto place = [&offset](uint64_t bytes) {
+            uint64_t start = offset;
+            offset = align8(offset + bytes);
+            return start;
+        };
+        header.nodesOffset = place(nodes.size() * sizeof(WorldFile::NodeRecord));
+        header.offsetsOffset = place(offsets.size() * sizeof(uint32_t));
+        header.targetsOffset = place(targets.size() * sizeof(uint32_t));
+        header.assetsOffset = place(assets.size() * sizeof(WorldFile::AssetRecord));
+        header.monstersOffset = place(monsters.size() * sizeof(WorldFile::MonsterRecord));
+        header.placementsOffset = place(placements.size() * sizeof(WorldFile::PlacementRecord));
+        header.regionOfOffset = place(regionOf.size() * sizeof(uint32_t));
+        header.regionMemberOffsetsOffset = place(memberOffsets.size() * sizeof(uint32_t));
+        header.regionMembersOffset = place(members.size() * sizeof(uint32_t));
+        header.regionPathOffsetsOffset = place(regionPathOffsets.size() * sizeof(uint32_t));
+        header.regionPathsOffset = place(regionPaths.size() * sizeof(uint32_t));
+        header.stringsSize = strings.Data().size();
+        header.stringsOffset = place(header.stringsSize);
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw std::runtime_error("cannot write world file " + path);
+
+        uint64_t written = 0;
+        auto write = [&](uint64_t at, const void *data, uint64_t bytes) {
+            static const char padding[8] = {};
+            out.write(padding, at - written);
+            out.write(static_cast<const char *>(data), bytes);
+            written = at + bytes;
+        };
+        write(0, &header, sizeof(header));
+        write(header.nodesOffset, nodes.data(), nodes.size() * sizeof(WorldFile::NodeRecord));
+        write(header.offsetsOffset, offsets.data(), offsets.size() * sizeof(uint32_t));
+        write(header.targetsOffset, targets.data(), targets.size() * sizeof(uint32_t));
+        write(header.assetsOffset, assets.data(), assets.size() * sizeof(WorldFile::AssetRecord));
+        write(header.monstersOffset, monsters.data(), monsters.size() * sizeof(WorldFile::MonsterRecord));
+        write(header.placementsOffset, placements.data(), placements.size() * sizeof(WorldFile::PlacementRecord));
+        write(header.regionOfOffset, regionOf.data(), regionOf.size() * sizeof(uint32_t));
+        write(header.regionMemberOffsetsOffset, memberOffsets.data(), memberOffsets.size() * sizeof(uint32_t));
+        write(header.regionMembersOffset, members.data(), members.size() * sizeof(uint32_t));
+        write(header.regionPathOffsetsOffset, regionPathOffsets.data(), regionPathOffsets.size() * sizeof(uint32_t));
+        write(header.regionPathsOffset, regionPaths.data(), regionPaths.size() * sizeof(uint32_t));
+        write(header.stringsOffset, strings.Data().data(), header.stringsSize);
+
+        if (!out.flush())
+            throw std::runtime_error("failed writing world file " + path);
+    }
+}
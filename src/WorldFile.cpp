@@ -0,0 +1,272 @@
+/**
+ * @file WorldFile.cpp
+ * @brief Implementation of the WorldFile class, mapping compiled worlds into memory.
+ *
+ * The file is mapped read-only and private; every accessor reads the mapping directly. Opening a file checks
+ * the header and that every section, string reference, path target and placement lies inside the mapping, so
+ * the accessors themselves never need to bounds-check.
+ *
+ * **Methods**:
+ * - `WorldFile(const string& path)`: Opens, maps and validates a world file.
+ * - `~WorldFile()`: Unmaps the file.
+ * - `uint32_t NodeCount() const`: Returns the number of nodes.
+ * - `string_view NodeName(uint32_t id) const` / `NodeDescription(uint32_t id) const`: Return node text from the string blob.
+ * - `WorldGraph Graph() const`: Wraps the mapped CSR arrays in a `WorldGraph` view.
+ * - `RegionPartition Regions() const`: Wraps the mapped region arrays in a `RegionPartition` view.
+ * - `AssetDef GetAsset(uint32_t index) const`, `MonsterDef GetMonster(uint32_t index) const`, `Placement GetPlacement(uint32_t index) const`: Decode one record.
+ * - `vector<uint32_t> ResolvePlacements(unsigned seed) const`: Draws a node for every random placement, in file order, so a seed always gives the same world.
+ * - `uint32_t CategoryFlags(AssetCategory category)`, `AssetCategory CategoryOf(uint32_t flags)`: One flag per category but passive, so files written before there were categories read as they did.
+ * - `void validate(const string& path) const`: Private method that rejects truncated or inconsistent files.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "WorldFile.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <random>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace chants
+{
+    WorldFile::WorldFile(const string &path) : _data(nullptr), _size(0), _header(nullptr)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("cannot open world file " + path + ": " + std::strerror(errno));
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header))
+        {
+            ::close(fd);
+            throw std::runtime_error(path + " is too small to be a world file");
+        }
+
+        _size = static_cast<size_t>(info.st_size);
+        void *mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping keeps the file alive
+        if (mapping == MAP_FAILED)
+            throw std::runtime_error("cannot map world file " + path + ": " + std::strerror(errno));
+
+        _data = static_cast<const uint8_t *>(mapping);
+        _header = reinterpret_cast<const Header *>(_data);
+        try
+        {
+            validate(path);
+        }
+        catch (...)
+        {
+            ::munmap(const_cast<uint8_t *>(_data), _size);
+            throw;
+        }
+    }
+
+    WorldFile::~WorldFile()
+    {
+        ::munmap(const_cast<uint8_t *>(_data), _size);
+    }
+
+    void WorldFile::validate(const string &path) const
+    {
+        const Header &h = *_header;
+        if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0)
+            throw std::runtime_error(path + " is not a world file");
+        if (h.version != kVersion)
+            throw std::runtime_error(path + " has world format version " + std::to_string(h.version) +
+                                     ", expected " + std::to_string(kVersion));
+
+        auto checkSection = [&](uint64_t offset, uint64_t count, size_t size, const char *name) {
+            if (offset % 8 != 0 || offset > _size || count > (_size - offset) / size)
+                throw std::runtime_error(path + " has a truncated " + name + " section");
+        };
+        checkSection(h.nodesOffset, h.nodeCount, sizeof(NodeRecord), "node");
+        checkSection(h.offsetsOffset, uint64_t(h.nodeCount) + 1, sizeof(uint32_t), "path offset");
+        checkSection(h.targetsOffset, h.edgeCount, sizeof(uint32_t), "path");
+        checkSection(h.assetsOffset, h.assetCount, sizeof(AssetRecord), "asset");
+        checkSection(h.monstersOffset, h.monsterCount, sizeof(MonsterRecord), "monster");
+        checkSection(h.placementsOffset, h.placementCount, sizeof(PlacementRecord), "placement");
+        checkSection(h.regionOfOffset, h.nodeCount, sizeof(uint32_t), "region");
+        checkSection(h.regionMemberOffsetsOffset, uint64_t(h.regionCount) + 1, sizeof(uint32_t), "region offset");
+        checkSection(h.regionMembersOffset, h.nodeCount, sizeof(uint32_t), "region member");
+        checkSection(h.regionPathOffsetsOffset, uint64_t(h.regionCount) + 1, sizeof(uint32_t), "region path offset");
+        checkSection(h.regionPathsOffset, h.regionEdgeCount, sizeof(uint32_t), "region path");
+        checkSection(h.stringsOffset, h.stringsSize, 1, "string");
+
+        auto checkText = [&](StringRef ref) {
+            if (uint64_t(ref.offset) + ref.length > h.stringsSize)
+                throw std::runtime_error(path + " refers to text outside its string table");
+        };
+        const NodeRecord *nodes = section<NodeRecord>(h.nodesOffset);
+        for (uint32_t i = 0; i < h.nodeCount; i++)
+        {
+            checkText(nodes[i].name);
+            checkText(nodes[i].description);
+        }
+
+        auto checkCsr = [&](uint64_t offsetsAt, uint64_t targetsAt, uint32_t rows, uint32_t count, uint32_t limit,
+                            const char *name) {
+            const uint32_t *offsets = section<uint32_t>(offsetsAt);
+            const uint32_t *targets = section<uint32_t>(targetsAt);
+            if (offsets[0] != 0 || offsets[rows] != count)
+                throw std::runtime_error(path + " has inconsistent " + name + " offsets");
+            for (uint32_t i = 0; i < rows; i++)
+            {
+                if (offsets[i] > offsets[i + 1])
+                    throw std::runtime_error(path + " has inconsistent " + name + " offsets");
+            }
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (targets[i] >= limit)
+                    throw std::runtime_error(path + " has a " + name + " entry that is out of range");
+            }
+        };
+        checkCsr(h.offsetsOffset, h.targetsOffset, h.nodeCount, h.edgeCount, h.nodeCount, "path");
+        checkCsr(h.regionMemberOffsetsOffset, h.regionMembersOffset, h.regionCount, h.nodeCount, h.nodeCount, "region member");
+        checkCsr(h.regionPathOffsetsOffset, h.regionPathsOffset, h.regionCount, h.regionEdgeCount, h.regionCount, "region path");
+        const uint32_t *regionOf = section<uint32_t>(h.regionOfOffset);
+        for (uint32_t i = 0; i < h.nodeCount; i++)
+        {
+            if (regionOf[i] >= h.regionCount)
+                throw std::runtime_error(path + " puts a node in a region that does not exist");
+        }
+
+        const AssetRecord *assets = section<AssetRecord>(h.assetsOffset);
+        for (uint32_t i = 0; i < h.assetCount; i++)
+        {
+            checkText(assets[i].name);
+            checkText(assets[i].message);
+        }
+        const MonsterRecord *monsters = section<MonsterRecord>(h.monstersOffset);
+        for (uint32_t i = 0; i < h.monsterCount; i++)
+        {
+            checkText(monsters[i].name);
+        }
+
+        const PlacementRecord *placements = section<PlacementRecord>(h.placementsOffset);
+        for (uint32_t i = 0; i < h.placementCount; i++)
+        {
+            const PlacementRecord &p = placements[i];
+            uint32_t objectCount = p.kind == uint32_t(PlacementKind::Asset) ? h.assetCount : h.monsterCount;
+            if (p.kind > uint32_t(PlacementKind::Monster) || p.object >= objectCount ||
+                (p.node != kRandomNode && p.node >= h.nodeCount))
+                throw std::runtime_error(path + " has an invalid placement");
+        }
+    }
+
+    string_view WorldFile::text(StringRef ref) const
+    {
+        return string_view(reinterpret_cast<const char *>(_data + _header->stringsOffset + ref.offset), ref.length);
+    }
+
+    uint32_t WorldFile::NodeCount() const
+    {
+        return _header->nodeCount;
+    }
+
+    string_view WorldFile::NodeName(uint32_t id) const
+    {
+        return text(section<NodeRecord>(_header->nodesOffset)[id].name);
+    }
+
+    string_view WorldFile::NodeDescription(uint32_t id) const
+    {
+        return text(section<NodeRecord>(_header->nodesOffset)[id].description);
+    }
+
+    WorldGraph WorldFile::Graph() const
+    {
+        return WorldGraph::View(_header->nodeCount, section<uint32_t>(_header->offsetsOffset),
+                                section<uint32_t>(_header->targetsOffset));
+    }
+
+    RegionPartition WorldFile::Regions() const
+    {
+        WorldGraph adjacency = WorldGraph::View(_header->regionCount, section<uint32_t>(_header->regionPathOffsetsOffset),
+                                                section<uint32_t>(_header->regionPathsOffset));
+        return RegionPartition::View(_header->nodeCount, _header->regionCount, section<uint32_t>(_header->regionOfOffset),
+                                     section<uint32_t>(_header->regionMemberOffsetsOffset),
+                                     section<uint32_t>(_header->regionMembersOffset), std::move(adjacency));
+    }
+
+    uint32_t WorldFile::AssetCount() const
+    {
+        return _header->assetCount;
+    }
+
+    WorldFile::AssetDef WorldFile::GetAsset(uint32_t index) const
+    {
+        const AssetRecord &record = section<AssetRecord>(_header->assetsOffset)[index];
+        return AssetDef{text(record.name), text(record.message), record.value, CategoryOf(record.flags)};
+    }
+
+    uint32_t WorldFile::MonsterCount() const
+    {
+        return _header->monsterCount;
+    }
+
+    uint32_t WorldFile::CategoryFlags(AssetCategory category)
+    {
+        switch (category)
+        {
+        case AssetCategory::Offensive:
+            return kOffensiveFlag;
+        case AssetCategory::Healing:
+            return kHealingFlag;
+        case AssetCategory::Navigation:
+            return kNavigationFlag;
+        default:
+            return 0;
+        }
+    }
+
+    AssetCategory WorldFile::CategoryOf(uint32_t flags)
+    {
+        if (flags & kOffensiveFlag)
+            return AssetCategory::Offensive;
+        if (flags & kHealingFlag)
+            return AssetCategory::Healing;
+        if (flags & kNavigationFlag)
+            return AssetCategory::Navigation;
+        return AssetCategory::Passive;
+    }
+
+    WorldFile::MonsterDef WorldFile::GetMonster(uint32_t index) const
+    {
+        const MonsterRecord &record = section<MonsterRecord>(_header->monstersOffset)[index];
+        return MonsterDef{text(record.name), record.health, record.fightCoefficient};
+    }
+
+    uint32_t WorldFile::PlacementCount() const
+    {
+        return _header->placementCount;
+    }
+
+    WorldFile::Placement WorldFile::GetPlacement(uint32_t index) const
+    {
+        const PlacementRecord &record = section<PlacementRecord>(_header->placementsOffset)[index];
+        return Placement{static_cast<PlacementKind>(record.kind), record.object, record.node};
+    }
+
+    vector<uint32_t> WorldFile::ResolvePlacements(unsigned seed) const
+    {
+        vector<uint32_t> nodes(PlacementCount());
+        if (NodeCount() == 0)
+            return vector<uint32_t>();
+
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<uint32_t> randomNode(0, NodeCount() - 1);
+        for (uint32_t i = 0; i < nodes.size(); i++)
+        {
+            uint32_t node = GetPlacement(i).node;
+            nodes[i] = node == kRandomNode ? randomNode(rng) : node;
+        }
+        return nodes;
+    }
+}
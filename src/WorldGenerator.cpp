@@ -0,0 +1,207 @@
+/**
+ * @file WorldGenerator.cpp
+ * @brief Implementation of the world generator, building large random worlds for scale testing.
+ *
+ * A path is opened by the location with the higher id, toward a lower one, and a location never opens the same
+ * path twice, so every path exists once and both of its directions are added when the graph is packed. Each row of
+ * the packed graph lists the paths its location opened, in the order they were drawn, then the paths opened to it,
+ * by ascending id. Drawing paths and names is the costly part and runs on the pool; packing them is one pass over
+ * the paths on the calling thread.
+ *
+ * **Functions**:
+ * - `WorldSource GenerateWorld(const GeneratorOptions& options)`: Generates the locations and their paths block by block, packs the graph, then places the objects block by block.
+ * - `uint32_t below(FightEngine& rng, uint32_t bound)`, `double unit(FightEngine& rng)`: Local helpers drawing from the high bits of a stream.
+ * - `uint32_t drawLinks(const GeneratorOptions& options, FightEngine& rng)`: Local helper drawing how many paths a location opens.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "WorldGenerator.hpp"
+#include "Combatant.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace chants
+{
+    namespace
+    {
+        // the objects of the default world (data/world.txt)
+        const WorldSource::AssetDef kAssets[] = {
+            {"Yoru", "A legendary black blade wielded by the greatest swordsman.", 500, AssetCategory::Offensive},
+            {"Gomu Gomu no Mi", "A mysterious fruit that grants rubber-like abilities.", 300, AssetCategory::Offensive},
+            {"Grand Line Map", "A map showing the way to the Grand Line.", 100, AssetCategory::Navigation},
+            {"Log Pose", "A navigational tool essential for Grand Line travel.", 150, AssetCategory::Navigation},
+            {"Meat", "A delicious piece of meat to restore energy.", 50, AssetCategory::Healing},
+            {"Healing Potion", "A potion that restores health.", 200, AssetCategory::Healing},
+            {"Slingshot", "A simple weapon for ranged attacks.", 100, AssetCategory::Offensive},
+            {"Pistol", "A firearm for ranged combat.", 250, AssetCategory::Offensive},
+            {"Giant Hammer", "A massive hammer for powerful attacks.", 300, AssetCategory::Offensive},
+            {"Mera Mera no Mi", "A fruit that grants fire-based abilities.", 350, AssetCategory::Offensive},
+        };
+
+        const WorldSource::MonsterDef kMonsters[] = {
+            {"Buggy the Clown", 3000, 100}, {"Arlong", 4000, 150}, {"Captain Kuro", 3500, 120}, {"Don Krieg", 4500, 130},
+            {"Alvida", 2500, 90},           {"Smoker", 5000, 160}, {"Marine", 2000, 80},
+        };
+
+        const char *const kPlaces[] = {"Harbor", "Cove", "Reef", "Isle", "Village", "Town", "Port", "Bay", "Cape", "Atoll", "Sandbar", "Fort"};
+
+        const char *const kDescriptions[] = {
+            "A quiet harbor where fishing boats rock at anchor.\n",
+            "A windswept island with a lighthouse on its highest rock.\n",
+            "A market town loud with merchants and sailors.\n",
+            "A marine outpost watching the sea lanes.\n",
+            "A hidden cove said to hide a pirate's treasure.\n",
+            "A reef of sharp coral, treacherous at low tide.\n",
+            "A village of fishermen who fear the open sea.\n",
+            "A ruined fort overgrown with jungle vines.\n",
+        };
+
+        // placements draw from streams past every possible location id
+        constexpr uint64_t kPlacementStreams = uint64_t(1) << 32;
+
+        // the high bits of the engine are the well-mixed ones
+        uint32_t below(FightEngine &rng, uint32_t bound)
+        {
+            return static_cast<uint32_t>(((rng() >> 32) * bound) >> 32);
+        }
+
+        double unit(FightEngine &rng)
+        {
+            return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        uint32_t drawLinks(const GeneratorOptions &options, FightEngine &rng)
+        {
+            // every path is counted at both its ends, so a location opens half the mean degree
+            double half = std::max(options.meanDegree / 2, 1.0);
+            double links = 1;
+            switch (options.degrees)
+            {
+            case DegreeDistribution::Uniform:
+                links = std::floor(half) + (unit(rng) < half - std::floor(half) ? 1 : 0);
+                break;
+            case DegreeDistribution::Geometric:
+                if (half > 1)
+                    links = 1 + std::floor(std::log(1 - unit(rng)) / std::log(1 - 1 / half));
+                break;
+            case DegreeDistribution::PowerLaw:
+                links = std::round(half / 3 * std::pow(1 - unit(rng), -1 / 1.5)); // a Pareto mean is 3 times its minimum
+                break;
+            }
+            return static_cast<uint32_t>(std::min(std::max(links, 1.0), static_cast<double>(std::max(options.maxDegree, 1u))));
+        }
+    }
+
+    WorldSource GenerateWorld(const GeneratorOptions &options)
+    {
+        if (options.nodes == 0)
+            throw std::invalid_argument("a world needs at least one location");
+        uint32_t nodeCount = options.nodes;
+        uint32_t locality = std::max(options.locality, 1u);
+
+        WorldSource world;
+        world.regionSize = options.regionSize;
+        world.nodes.resize(nodeCount);
+        world.assets.assign(std::begin(kAssets), std::end(kAssets));
+        world.monsters.assign(std::begin(kMonsters), std::end(kMonsters));
+
+        // every block draws its locations' names and paths on its own
+        uint64_t blocks = (uint64_t(nodeCount) + GeneratorOptions::kBlockSize - 1) / GeneratorOptions::kBlockSize;
+        vector<vector<uint32_t>> blockLinks(blocks);
+        vector<uint32_t> opened(nodeCount);
+        ThreadPool pool(options.threads);
+        pool.ParallelFor(blocks, [&](uint64_t block, unsigned) {
+            uint32_t first = static_cast<uint32_t>(block * GeneratorOptions::kBlockSize);
+            uint32_t last = static_cast<uint32_t>(std::min<uint64_t>(first + uint64_t(GeneratorOptions::kBlockSize), nodeCount));
+            vector<uint32_t> &links = blockLinks[block];
+            for (uint32_t node = first; node < last; node++)
+            {
+                FightEngine rng(MixSeed(options.seed, node));
+                WorldSource::NodeDef &def = world.nodes[node];
+                def.name = string(kPlaces[below(rng, std::size(kPlaces))]) + " " + std::to_string(node);
+                def.description = kDescriptions[below(rng, std::size(kDescriptions))];
+                if (node == 0)
+                    continue;
+
+                // the first path leads close by, which keeps the world connected
+                size_t start = links.size();
+                uint32_t wanted = std::min(drawLinks(options, rng), node);
+                uint32_t reach = std::min(node, locality);
+                links.push_back(node - 1 - below(rng, reach));
+                for (uint32_t attempt = 0; links.size() - start < wanted && attempt < 4 * wanted; attempt++)
+                {
+                    uint32_t to = unit(rng) < options.longRange ? below(rng, node) : node - 1 - below(rng, reach);
+                    if (std::find(links.begin() + start, links.end(), to) == links.end())
+                        links.push_back(to);
+                }
+                opened[node] = static_cast<uint32_t>(links.size() - start);
+            }
+        });
+
+        // pack both directions of every path: a row holds the paths its location opened, then those opened to it
+        vector<uint32_t> offsets(uint64_t(nodeCount) + 1, 0);
+        uint64_t edgeCount = 0;
+        for (const vector<uint32_t> &links : blockLinks)
+        {
+            for (uint32_t to : links)
+            {
+                offsets[to + 1]++;
+            }
+            edgeCount += 2 * links.size();
+        }
+        if (edgeCount > UINT32_MAX)
+            throw std::runtime_error("the generated world has too many paths for a world file");
+        for (uint32_t node = 0; node < nodeCount; node++)
+        {
+            offsets[node + 1] += offsets[node] + opened[node];
+        }
+        vector<uint32_t> targets(edgeCount);
+        vector<uint32_t> incoming(nodeCount);
+        for (uint32_t node = 0; node < nodeCount; node++)
+        {
+            incoming[node] = offsets[node] + opened[node];
+        }
+        uint32_t node = 0;
+        for (vector<uint32_t> &links : blockLinks)
+        {
+            size_t at = 0;
+            while (at < links.size())
+            {
+                for (uint32_t i = 0; i < opened[node]; i++, at++)
+                {
+                    targets[offsets[node] + i] = links[at];
+                    targets[incoming[links[at]]++] = node;
+                }
+                node++;
+            }
+            vector<uint32_t>().swap(links);
+        }
+        world.graph = WorldGraph::Packed(std::move(offsets), std::move(targets));
+
+        // objects, each from its own stream
+        uint32_t assetCount = static_cast<uint32_t>(std::llround(nodeCount * std::max(options.assetDensity, 0.0)));
+        uint32_t monsterCount = static_cast<uint32_t>(std::llround(nodeCount * std::max(options.monsterDensity, 0.0)));
+        world.placements.resize(uint64_t(assetCount) + monsterCount);
+        uint64_t placementBlocks = (world.placements.size() + GeneratorOptions::kBlockSize - 1) / GeneratorOptions::kBlockSize;
+        pool.ParallelFor(placementBlocks, [&](uint64_t block, unsigned) {
+            uint64_t first = block * GeneratorOptions::kBlockSize;
+            uint64_t last = std::min<uint64_t>(first + GeneratorOptions::kBlockSize, world.placements.size());
+            for (uint64_t placement = first; placement < last; placement++)
+            {
+                FightEngine rng(MixSeed(options.seed, kPlacementStreams + placement));
+                WorldFile::Placement &object = world.placements[placement];
+                bool monster = placement >= assetCount;
+                object.kind = monster ? WorldFile::PlacementKind::Monster : WorldFile::PlacementKind::Asset;
+                object.object = below(rng, monster ? std::size(kMonsters) : std::size(kAssets));
+                object.node = unit(rng) < options.randomPlacements ? WorldFile::kRandomNode : below(rng, nodeCount);
+            }
+        });
+        return world;
+    }
+}
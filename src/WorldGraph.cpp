@@ -0,0 +1,205 @@
+/**
+ * @file WorldGraph.cpp
+ * @brief Implementation of the WorldGraph class, the CSR adjacency store for the game map.
+ *
+ * Edges are collected in a staging list and packed with a counting sort on the source node, which keeps the
+ * neighbors of each node in insertion order. Finalizing again after more edges were added merges the new edges
+ * behind the ones already packed. Accessors read through `_offsetData`/`_targetData`, which point either at the
+ * owned vectors or at borrowed memory for a view.
+ *
+ * **Methods**:
+ * - `WorldGraph(uint32_t nodeCount)`: Constructor that creates a graph with `nodeCount` nodes and no edges.
+ * - `WorldGraph(const WorldGraph &other)`: Copies a graph; a copy of a view stays a view of the same memory.
+ * - `static WorldGraph View(...)`: Creates a graph that reads borrowed CSR arrays in place.
+ * - `static WorldGraph Packed(...)`: Creates a graph that owns the CSR arrays it is given.
+ * - `void AddEdge(uint32_t from, uint32_t to)`: Stages an edge until the next `Finalize`.
+ * - `void Finalize()`: Rebuilds `_offsets` and `_targets` from the packed and staged edges.
+ * - `WorldGraph Reversed() const`: Counting-sorts the packed edges on their target, so each row lists its sources in id order.
+ * - `uint32_t NodeCount() const`: Returns the number of nodes.
+ * - `uint32_t EdgeCount() const`: Returns the number of packed edges.
+ * - `uint32_t Degree(uint32_t node) const`: Returns the number of neighbors of a node.
+ * - `NeighborRange Neighbors(uint32_t node) const`: Returns the neighbor ids of a node.
+ * - `bool HasEdge(uint32_t from, uint32_t to) const`: Scans the neighbors of `from` for `to`.
+ * - `size_t MemoryUsage() const`: Adds up the capacity of the owned vectors.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "WorldGraph.hpp"
+
+namespace chants
+{
+    WorldGraph::WorldGraph(uint32_t nodeCount) : _nodeCount(nodeCount), _offsets(nodeCount + 1, 0)
+    {
+        usePackedVectors();
+    }
+
+    WorldGraph::WorldGraph(const WorldGraph &other)
+        : _nodeCount(other._nodeCount), _offsets(other._offsets), _targets(other._targets), _pending(other._pending),
+          _offsetData(other._offsetData), _targetData(other._targetData), _packedNodes(other._packedNodes),
+          _edgeCount(other._edgeCount)
+    {
+        if (!other.isView())
+            usePackedVectors();
+    }
+
+    WorldGraph &WorldGraph::operator=(const WorldGraph &other)
+    {
+        if (this != &other)
+        {
+            WorldGraph copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    WorldGraph WorldGraph::View(uint32_t nodeCount, const uint32_t *offsets, const uint32_t *targets)
+    {
+        WorldGraph graph;
+        graph._nodeCount = nodeCount;
+        graph._offsets.clear();
+        graph._offsetData = offsets;
+        graph._targetData = targets;
+        graph._packedNodes = nodeCount;
+        graph._edgeCount = offsets[nodeCount];
+        return graph;
+    }
+
+    WorldGraph WorldGraph::Packed(vector<uint32_t> offsets, vector<uint32_t> targets)
+    {
+        WorldGraph graph;
+        graph._nodeCount = static_cast<uint32_t>(offsets.size()) - 1;
+        graph._offsets = std::move(offsets);
+        graph._targets = std::move(targets);
+        graph.usePackedVectors();
+        return graph;
+    }
+
+    bool WorldGraph::isView() const
+    {
+        return _offsetData != _offsets.data();
+    }
+
+    void WorldGraph::usePackedVectors()
+    {
+        _offsetData = _offsets.data();
+        _targetData = _targets.data();
+        _packedNodes = static_cast<uint32_t>(_offsets.size()) - 1;
+        _edgeCount = static_cast<uint32_t>(_targets.size());
+    }
+
+    void WorldGraph::AddEdge(uint32_t from, uint32_t to)
+    {
+        if (from >= _nodeCount)
+            _nodeCount = from + 1;
+        if (to >= _nodeCount)
+            _nodeCount = to + 1;
+        _pending.emplace_back(from, to);
+    }
+
+    void WorldGraph::Finalize()
+    {
+        // count the edges leaving every node, old and new
+        vector<uint32_t> offsets(_nodeCount + 1, 0);
+        for (uint32_t node = 0; node < _packedNodes; node++)
+        {
+            offsets[node + 1] += _offsetData[node + 1] - _offsetData[node];
+        }
+        for (const auto &edge : _pending)
+        {
+            offsets[edge.first + 1]++;
+        }
+        for (uint32_t node = 0; node < _nodeCount; node++)
+        {
+            offsets[node + 1] += offsets[node];
+        }
+
+        // scatter packed edges first, then staged ones, so each row stays in insertion order
+        vector<uint32_t> targets(offsets[_nodeCount]);
+        vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (uint32_t node = 0; node < _packedNodes; node++)
+        {
+            for (uint32_t i = _offsetData[node]; i < _offsetData[node + 1]; i++)
+            {
+                targets[cursor[node]++] = _targetData[i];
+            }
+        }
+        for (const auto &edge : _pending)
+        {
+            targets[cursor[edge.first]++] = edge.second;
+        }
+
+        _offsets.swap(offsets);
+        _targets.swap(targets);
+        _pending.clear();
+        _pending.shrink_to_fit();
+        usePackedVectors();
+    }
+
+    WorldGraph WorldGraph::Reversed() const
+    {
+        vector<uint32_t> offsets(_nodeCount + 1, 0);
+        for (uint32_t i = 0; i < _edgeCount; i++)
+        {
+            offsets[_targetData[i] + 1]++;
+        }
+        for (uint32_t node = 0; node < _nodeCount; node++)
+        {
+            offsets[node + 1] += offsets[node];
+        }
+
+        vector<uint32_t> sources(_edgeCount);
+        vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (uint32_t node = 0; node < _packedNodes; node++)
+        {
+            for (uint32_t i = _offsetData[node]; i < _offsetData[node + 1]; i++)
+            {
+                sources[cursor[_targetData[i]]++] = node;
+            }
+        }
+        return Packed(std::move(offsets), std::move(sources));
+    }
+
+    uint32_t WorldGraph::NodeCount() const
+    {
+        return _nodeCount;
+    }
+
+    uint32_t WorldGraph::EdgeCount() const
+    {
+        return _edgeCount;
+    }
+
+    uint32_t WorldGraph::Degree(uint32_t node) const
+    {
+        if (node >= _packedNodes)
+            return 0;
+        return _offsetData[node + 1] - _offsetData[node];
+    }
+
+    WorldGraph::NeighborRange WorldGraph::Neighbors(uint32_t node) const
+    {
+        if (node >= _packedNodes)
+            return NeighborRange(nullptr, nullptr);
+        return NeighborRange(_targetData + _offsetData[node], _targetData + _offsetData[node + 1]);
+    }
+
+    bool WorldGraph::HasEdge(uint32_t from, uint32_t to) const
+    {
+        for (uint32_t neighbor : Neighbors(from))
+        {
+            if (neighbor == to)
+                return true;
+        }
+        return false;
+    }
+
+    size_t WorldGraph::MemoryUsage() const
+    {
+        return sizeof(*this) + (_offsets.capacity() + _targets.capacity()) * sizeof(uint32_t) +
+               _pending.capacity() * sizeof(_pending[0]);
+    }
+}
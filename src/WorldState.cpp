@@ -0,0 +1,161 @@
+/**
+ * @file WorldState.cpp
+ * @brief Implementation of the WorldState class, live counts of the assets and monsters left in the world.
+ *
+ * A location's occupancy bit flips only when its count moves between zero and non-zero, so adding and removing
+ * objects is constant time, and finding the next occupied location skips 64 empty ones per word.
+ *
+ * **Methods**:
+ * - `void Reset(uint32_t locationCount)`: Sizes and zeroes both tallies.
+ * - `AddAssets`, `RemoveAssets`, `AddMonsters`, `RemoveMonsters`: Update a location's count, its occupancy bit and the total.
+ * - `AssetsRemaining`, `MonstersRemaining`, `AssetsAt`, `MonstersAt`, `LocationsWithAssets`, `LocationsWithMonsters`: Read the counts.
+ * - `NextLocationWithAssets`, `NextLocationWithMonsters`: Scan the occupancy bits from a location onwards.
+ * - `const vector<uint64_t>& MonsterOccupancy() const`: Returns the monster occupancy bits.
+ * - `bool AllMonstersDefeated() const`: Checks the monster total.
+ * - `size_t MemoryUsage() const`: Adds up the capacity of both tallies.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-16
+ */
+
+
+#include "WorldState.hpp"
+
+namespace chants
+{
+    void WorldState::Tally::reset(uint32_t locationCount)
+    {
+        count.assign(locationCount, 0);
+        occupied.assign((static_cast<size_t>(locationCount) + 63) / 64, 0);
+        total = 0;
+        locations = 0;
+    }
+
+    void WorldState::Tally::add(uint32_t node, uint32_t n)
+    {
+        if (n == 0)
+            return;
+        if (count[node] == 0)
+        {
+            occupied[node / 64] |= uint64_t(1) << (node % 64);
+            locations++;
+        }
+        count[node] += n;
+        total += n;
+    }
+
+    void WorldState::Tally::remove(uint32_t node, uint32_t n)
+    {
+        if (n == 0)
+            return;
+        count[node] -= n;
+        total -= n;
+        if (count[node] == 0)
+        {
+            occupied[node / 64] &= ~(uint64_t(1) << (node % 64));
+            locations--;
+        }
+    }
+
+    uint32_t WorldState::Tally::next(uint32_t from) const
+    {
+        size_t word = from / 64;
+        if (word >= occupied.size())
+            return kNone;
+        uint64_t bits = occupied[word] & (~uint64_t(0) << (from % 64));
+        while (bits == 0)
+        {
+            if (++word == occupied.size())
+                return kNone;
+            bits = occupied[word];
+        }
+        return static_cast<uint32_t>(word * 64 + __builtin_ctzll(bits));
+    }
+
+    void WorldState::Reset(uint32_t locationCount)
+    {
+        _assets.reset(locationCount);
+        _monsters.reset(locationCount);
+    }
+
+    void WorldState::AddAssets(uint32_t node, uint32_t count)
+    {
+        _assets.add(node, count);
+    }
+
+    void WorldState::RemoveAssets(uint32_t node, uint32_t count)
+    {
+        _assets.remove(node, count);
+    }
+
+    void WorldState::AddMonsters(uint32_t node, uint32_t count)
+    {
+        _monsters.add(node, count);
+    }
+
+    void WorldState::RemoveMonsters(uint32_t node, uint32_t count)
+    {
+        _monsters.remove(node, count);
+    }
+
+    uint64_t WorldState::AssetsRemaining() const
+    {
+        return _assets.total;
+    }
+
+    uint64_t WorldState::MonstersRemaining() const
+    {
+        return _monsters.total;
+    }
+
+    uint32_t WorldState::AssetsAt(uint32_t node) const
+    {
+        return node < _assets.count.size() ? _assets.count[node] : 0;
+    }
+
+    uint32_t WorldState::MonstersAt(uint32_t node) const
+    {
+        return node < _monsters.count.size() ? _monsters.count[node] : 0;
+    }
+
+    uint32_t WorldState::LocationsWithAssets() const
+    {
+        return _assets.locations;
+    }
+
+    uint32_t WorldState::LocationsWithMonsters() const
+    {
+        return _monsters.locations;
+    }
+
+    uint32_t WorldState::NextLocationWithAssets(uint32_t from) const
+    {
+        return _assets.next(from);
+    }
+
+    uint32_t WorldState::NextLocationWithMonsters(uint32_t from) const
+    {
+        return _monsters.next(from);
+    }
+
+    const vector<uint64_t> &WorldState::MonsterOccupancy() const
+    {
+        return _monsters.occupied;
+    }
+
+    bool WorldState::AllMonstersDefeated() const
+    {
+        return _monsters.total == 0;
+    }
+
+    size_t WorldState::MemoryUsage() const
+    {
+        size_t bytes = sizeof(*this);
+        for (const Tally *tally : {&_assets, &_monsters})
+        {
+            bytes += tally->count.capacity() * sizeof(uint32_t) + tally->occupied.capacity() * sizeof(uint64_t);
+        }
+        return bytes;
+    }
+}
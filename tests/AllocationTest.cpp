@@ -0,0 +1,176 @@
+/**
+ * @file AllocationTest.cpp
+ * @brief Tests that the turns of a game under way allocate nothing.
+ *
+ * The global `operator new` is replaced by one that counts its calls. Each test builds a small world, plays a few
+ * turns of a kind to warm up the buffers the engine, renderer, inventory and route planner reuse, then plays more of
+ * them and checks that not a single allocation was made. A change that copies a node's lists, builds a string per
+ * turn or lets a scratch buffer go is caught here rather than in a profile.
+ *
+ * **Tests**:
+ * - `InspectTurn`: Viewing the inventory.
+ * - `MoveTurn`: Stepping back and forth between two locations.
+ * - `TakeTurn`: Taking further copies of an asset already held, one location after another.
+ * - `TravelTurn`: Travelling the length of the world and back.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "AdventureGameMap.hpp"
+#include "FrameRenderer.hpp"
+#include "GameEngine.hpp"
+#include "Player.hpp"
+#include "RoutePlanner.hpp"
+#include "WorldCompiler.hpp"
+#include "WorldFile.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <fcntl.h>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+    std::atomic<uint64_t> allocations{0};
+}
+
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *block = std::malloc(size ? size : 1))
+        return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *block) noexcept
+{
+    std::free(block);
+}
+
+void operator delete(void *block, std::size_t) noexcept
+{
+    std::free(block);
+}
+
+using namespace chants;
+
+namespace
+{
+    // ten locations in a row, a Meat at each of the middle eight and a monster at the far end so the game goes on
+    const char *kWorld = R"(
+node 0 "Dock"      "A dock.\n"
+node 1 "Market"    "A market.\n"
+node 2 "Harbor"    "A harbor.\n"
+node 3 "Square"    "A square.\n"
+node 4 "Mill"      "A mill.\n"
+node 5 "Farm"      "A farm.\n"
+node 6 "Bridge"    "A bridge.\n"
+node 7 "Ford"      "A ford.\n"
+node 8 "Camp"      "A camp.\n"
+node 9 "Tower"     "A tower.\n"
+path 0 1
+path 1 0 2
+path 2 1 3
+path 3 2 4
+path 4 3 5
+path 5 4 6
+path 6 5 7
+path 7 6 8
+path 8 7 9
+path 9 8
+asset "Meat" 50 healing "A delicious piece of meat to restore energy."
+monster "Marine" 2000 80
+place asset "Meat" 1
+place asset "Meat" 2
+place asset "Meat" 3
+place asset "Meat" 4
+place asset "Meat" 5
+place asset "Meat" 6
+place asset "Meat" 7
+place asset "Meat" 8
+place monster "Marine" 9
+)";
+
+    const WorldFile &testWorld()
+    {
+        static std::unique_ptr<WorldFile> world = [] {
+            std::istringstream text(kWorld);
+            string path = ::testing::TempDir() + "allocation_world.chw";
+            WriteWorldFile(ParseWorldText(text, "allocation test"), path);
+            return std::make_unique<WorldFile>(path);
+        }();
+        return *world;
+    }
+
+    // a game as the interactive one plays it, rendering to /dev/null
+    class AllocationTest : public ::testing::Test
+    {
+    protected:
+        AllocationTest()
+            : _fd(::open("/dev/null", O_WRONLY)), _map(testWorld(), 1), _player("Luffy", 10000, 200),
+              _planner(testWorld().Graph(), testWorld().Regions()), _out(_fd, false),
+              _engine(_map, _player, _out, 0, &_planner)
+        {
+            _engine.Start();
+        }
+
+        ~AllocationTest() override
+        {
+            ::close(_fd);
+        }
+
+        // plays the lines and returns the allocations they made
+        uint64_t play(std::initializer_list<const char *> lines)
+        {
+            uint64_t before = allocations.load(std::memory_order_relaxed);
+            for (const char *line : lines)
+            {
+                _line = line;
+                EXPECT_TRUE(_engine.HandleLine(_line)) << line;
+            }
+            return allocations.load(std::memory_order_relaxed) - before;
+        }
+
+        int _fd;
+        AdventureGameMap _map;
+        Player _player;
+        RoutePlanner _planner;
+        FrameRenderer _out;
+        GameEngine _engine;
+        string _line = string(64, ' '); // the line buffer, kept like the game's input buffer
+    };
+}
+
+TEST_F(AllocationTest, InspectTurn)
+{
+    play({"v", "v"});
+    EXPECT_EQ(play({"v", "v", "v", "v"}), 0u);
+}
+
+TEST_F(AllocationTest, MoveTurn)
+{
+    play({"1", "0", "Market", "Dock"});
+    EXPECT_EQ(play({"1", "0", "1", "0", "Market", "Dock"}), 0u);
+}
+
+TEST_F(AllocationTest, TakeTurn)
+{
+    // the first take starts the stack and the next five grow its list of copies to room for eight
+    play({"1", "t Meat", "2", "t Meat", "3", "t Meat", "4", "t Meat", "5", "t Meat", "6", "t Meat"});
+    EXPECT_EQ(play({"7", "t Meat", "8", "t Meat"}), 0u);
+    EXPECT_EQ(_player.GetInventory().ItemCount(), 8u);
+}
+
+TEST_F(AllocationTest, TravelTurn)
+{
+    play({"travel Camp", "travel Dock"});
+    EXPECT_EQ(play({"travel Camp", "travel Dock", "travel Camp", "travel Dock"}), 0u);
+    EXPECT_EQ(_engine.GetPosition(), 0u);
+}
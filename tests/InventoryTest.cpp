@@ -0,0 +1,106 @@
+/**
+ * @file InventoryTest.cpp
+ * @brief Tests the order the inventory lists its stacks in, before and after a stack is removed.
+ *
+ * New stacks are listed in the order they were started. Removing a stack's last copy moves the last stack into its
+ * position, in `Stacks()` and in its category's list, so the inventory shown to the player changes exactly that way.
+ *
+ * **Tests**:
+ * - `StacksInCollectionOrder`: Stacks are listed in the order their first copy was taken; further copies do not move them.
+ * - `RemovalMovesLastStack`: Removing a stack puts the last stack in its place and keeps the index and categories pointing at it.
+ * - `RemovingLastStackMovesNothing`: Removing the newest stack leaves the others where they were.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "Asset.hpp"
+#include "Inventory.hpp"
+#include "SymbolTable.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using chants::AssetCategory;
+
+    std::vector<std::string> names(const chants::Inventory &inventory)
+    {
+        std::vector<std::string> listed;
+        for (const chants::Inventory::Stack &stack : inventory.Stacks())
+        {
+            listed.emplace_back(stack.asset.GetName());
+        }
+        return listed;
+    }
+
+    std::vector<std::string> names(const chants::Inventory &inventory, AssetCategory category)
+    {
+        std::vector<std::string> listed;
+        for (uint32_t position : inventory.InCategory(category))
+        {
+            listed.emplace_back(inventory.Stacks()[position].asset.GetName());
+        }
+        return listed;
+    }
+
+    chants::Symbol symbol(const char *name)
+    {
+        return chants::SymbolTable::Global().Intern(name);
+    }
+
+    class InventoryTest : public ::testing::Test
+    {
+    protected:
+        chants::Inventory _inventory;
+
+        void SetUp() override
+        {
+            _inventory.Add(chants::Asset("Yoru", "", 50, AssetCategory::Offensive));
+            _inventory.Add(chants::Asset("Meat", "", 10, AssetCategory::Healing));
+            _inventory.Add(chants::Asset("Pistol", "", 20, AssetCategory::Offensive));
+            _inventory.Add(chants::Asset("Log Pose", "", 5, AssetCategory::Navigation));
+            _inventory.Add(chants::Asset("Meat", "", 10, AssetCategory::Healing));
+            _inventory.Add(chants::Asset("Slingshot", "", 15, AssetCategory::Offensive));
+        }
+    };
+}
+
+TEST_F(InventoryTest, StacksInCollectionOrder)
+{
+    EXPECT_EQ(names(_inventory), std::vector<std::string>({"Yoru", "Meat", "Pistol", "Log Pose", "Slingshot"}));
+    EXPECT_EQ(names(_inventory, AssetCategory::Offensive), std::vector<std::string>({"Yoru", "Pistol", "Slingshot"}));
+    EXPECT_EQ(_inventory.Count(symbol("Meat")), 2u);
+    EXPECT_EQ(_inventory.ItemCount(), 6u);
+}
+
+TEST_F(InventoryTest, RemovalMovesLastStack)
+{
+    ASSERT_TRUE(_inventory.Remove(symbol("Yoru")));
+    EXPECT_EQ(names(_inventory), std::vector<std::string>({"Slingshot", "Meat", "Pistol", "Log Pose"}));
+    EXPECT_EQ(names(_inventory, AssetCategory::Offensive), std::vector<std::string>({"Slingshot", "Pistol"}));
+    ASSERT_NE(_inventory.Find(symbol("Slingshot")), nullptr);
+    EXPECT_EQ(_inventory.Find(symbol("Slingshot")), &_inventory.Stacks()[0].asset);
+    EXPECT_EQ(_inventory.Find(symbol("Yoru")), nullptr);
+
+    // one copy of two comes off the stack without moving anything
+    ASSERT_TRUE(_inventory.Remove(symbol("Meat")));
+    EXPECT_EQ(names(_inventory), std::vector<std::string>({"Slingshot", "Meat", "Pistol", "Log Pose"}));
+
+    ASSERT_TRUE(_inventory.Remove(symbol("Meat")));
+    EXPECT_EQ(names(_inventory), std::vector<std::string>({"Slingshot", "Log Pose", "Pistol"}));
+    EXPECT_EQ(names(_inventory, AssetCategory::Navigation), std::vector<std::string>({"Log Pose"}));
+    EXPECT_TRUE(names(_inventory, AssetCategory::Healing).empty());
+    EXPECT_EQ(_inventory.ItemCount(), 3u);
+}
+
+TEST_F(InventoryTest, RemovingLastStackMovesNothing)
+{
+    ASSERT_TRUE(_inventory.Remove(symbol("Slingshot")));
+    EXPECT_EQ(names(_inventory), std::vector<std::string>({"Yoru", "Meat", "Pistol", "Log Pose"}));
+    EXPECT_EQ(names(_inventory, AssetCategory::Offensive), std::vector<std::string>({"Yoru", "Pistol"}));
+    EXPECT_FALSE(_inventory.Remove(symbol("Slingshot")));
+}
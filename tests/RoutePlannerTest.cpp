@@ -0,0 +1,81 @@
+/**
+ * @file RoutePlannerTest.cpp
+ * @brief Tests that routes through a location with tens of thousands of paths take the right ones.
+ *
+ * A next step is the position of a path in its location's neighbor list. Hubs with more paths than fit in 16 bits
+ * are common in generated worlds, and a position past 65535 must neither wrap around to another path nor be
+ * mistaken for "no route".
+ *
+ * **Tests**:
+ * - `HubOnDemand`: Routes out of and through a hub of 70,000 paths in a world too large to precompute.
+ * - `HubTooWideForTable`: A small world whose hub does not fit the 16-bit table is searched on demand instead.
+ *
+ * @author agent
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+
+#include "RoutePlanner.hpp"
+#include "WorldGraph.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t kSpokes = 70000;
+
+    // location 0 leads to every spoke 1..kSpokes, and every spoke leads back to it
+    chants::WorldGraph starWorld()
+    {
+        chants::WorldGraph graph(kSpokes + 1);
+        for (uint32_t spoke = 1; spoke <= kSpokes; spoke++)
+        {
+            graph.AddEdge(0, spoke);
+            graph.AddEdge(spoke, 0);
+        }
+        graph.Finalize();
+        return graph;
+    }
+}
+
+TEST(RoutePlannerTest, HubOnDemand)
+{
+    chants::RoutePlanner planner(starWorld());
+    ASSERT_FALSE(planner.IsPrecomputed());
+
+    std::vector<uint32_t> route;
+    for (uint32_t spoke : {1u, 65535u, 65536u, 65537u, kSpokes})
+    {
+        ASSERT_TRUE(planner.Route(0, spoke, route)) << spoke;
+        EXPECT_EQ(route, std::vector<uint32_t>({spoke}));
+        EXPECT_EQ(planner.NextStep(0, spoke), spoke);
+    }
+
+    ASSERT_TRUE(planner.Route(kSpokes, 65536, route));
+    EXPECT_EQ(route, std::vector<uint32_t>({0, 65536}));
+    EXPECT_EQ(planner.Distance(3, kSpokes), 2u);
+}
+
+TEST(RoutePlannerTest, HubTooWideForTable)
+{
+    // location 1 is the 65536th path out of 0, a position that reads as "no route" in 16 bits
+    chants::WorldGraph graph(3);
+    for (uint32_t i = 0; i < 65535; i++)
+    {
+        graph.AddEdge(0, 2);
+    }
+    graph.AddEdge(0, 1);
+    graph.AddEdge(1, 2);
+    graph.Finalize();
+
+    chants::RoutePlanner planner(graph);
+    EXPECT_FALSE(planner.IsPrecomputed());
+
+    std::vector<uint32_t> route;
+    ASSERT_TRUE(planner.Route(0, 1, route));
+    EXPECT_EQ(route, std::vector<uint32_t>({1}));
+    EXPECT_EQ(planner.NextStep(0, 1), 1u);
+    EXPECT_EQ(planner.Distance(1, 0), chants::RoutePlanner::kNone);
+}